@@ -0,0 +1,111 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*! \file allocator.hpp
+ *
+ * \brief This file contains the default allocator used by the Array class
+ * template to obtain aligned memory.
+ */
+
+#ifndef ARRAY_ALLOCATOR_HPP
+#define ARRAY_ALLOCATOR_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "array-config.hpp"
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! Alignment in bytes of the memory allocated by default for arrays
+/*! A cache line, which is also the width of an AVX-512 register.
+ */
+constexpr size_t array_alignment = 64;
+
+
+//! Aligned allocator class template
+/*! Allocates blocks whose first element is aligned to a boundary of alignment
+ * bytes, which must be a power of two. The allocator is stateless, so memory
+ * can be released by any instance of the same type.
+ */
+template <typename T, size_t alignment = array_alignment>
+class aligned_allocator {
+
+  static_assert(alignment >= alignof(void*) && (alignment & (alignment - 1)) == 0,
+                "*** ERROR *** Alignment must be a power of two.");
+
+public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename U> struct rebind {
+    typedef aligned_allocator<U, alignment> other;
+  };
+
+  aligned_allocator() {}
+
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, alignment> &) {}
+
+  //! Allocate memory for n objects
+  /*! The block is over-allocated by alignment bytes, and the address returned
+   * by malloc is kept right before the aligned pointer so that it can be
+   * released by deallocate.
+   */
+  pointer allocate(size_type n) {
+
+    if (n > (size_type(-1) - alignment) / sizeof(T))
+      throw std::bad_alloc();
+
+    void *p = std::malloc(n * sizeof(T) + alignment);
+    if (!p)
+      throw std::bad_alloc();
+
+    std::uintptr_t a = (reinterpret_cast<std::uintptr_t>(p) + alignment) & ~(alignment - 1);
+    reinterpret_cast<void **>(a)[-1] = p;
+    return reinterpret_cast<pointer>(a);
+  }
+
+  //! Release memory obtained by allocate
+  void deallocate(pointer p, size_type) {
+    if (p)
+      std::free(reinterpret_cast<void **>(p)[-1]);
+  }
+
+  template <typename U>
+  bool operator==(const aligned_allocator<U, alignment> &) const { return true; }
+
+  template <typename U>
+  bool operator!=(const aligned_allocator<U, alignment> &) const { return false; }
+};
+
+
+__END_ARRAY_NAMESPACE__
+
+#endif /* ARRAY_ALLOCATOR_HPP */
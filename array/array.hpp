@@ -28,7 +28,11 @@
 #define ARRAY_HPP
 
 #include "array_impl.hpp"
+#include "view.hpp"
 #include "functions.hpp"
+#include "fixed.hpp"
+#include "batch.hpp"
+#include "async.hpp"
 
 
 #endif /* ARRAY_HPP */
@@ -26,7 +26,11 @@
 #ifndef ARRAY_FWD_HPP
 #define ARRAY_FWD_HPP
 
+#include <complex>
+#include <type_traits>
+
 #include "array-config.hpp"
+#include "allocator.hpp"
 
 __BEGIN_ARRAY_NAMESPACE__
 
@@ -60,7 +64,13 @@ template <class> class Expr;
 
 template <class A, class B, class Op> class BinExprOp;
 
-template <int, typename> class Array;
+template <class F, class A, class B> class FunExprOp;
+
+template <int k, typename T, class Alloc = aligned_allocator<T> > class Array;
+
+template <size_t... n> struct Extents;
+
+template <int k, typename T> class View;
 
 template <class A> inline std::ostream &print(std::ostream &, const Expr<A> &);
 
@@ -73,12 +83,17 @@ class ApSub;
 class ApMul;
 class ApDiv;
 class ApTr;
+class ApMap;
+class ApElementwise;
+class ApAssign;
 
 // function forward declarations
 
-template <int k, typename T = double> Array<k, T> identity(size_t);
+template <int k, typename T = double, class Alloc = aligned_allocator<T> >
+Array<k, T, Alloc> identity(size_t);
 
-template <int k, typename T> Array<1, T> vec(const Array<k, T> &);
+template <int k, typename T, class Alloc>
+Array<1, T> vec(const Array<k, T, Alloc> &);
 
 ////! Functioin template used to cast Array objects
 //template <typename casted_type, class k, typename T = double>
@@ -86,7 +101,8 @@ template <int k, typename T> Array<1, T> vec(const Array<k, T> &);
 
 #if defined(HAVE_LAPACK) || defined(HAVE_CLAPACK)
 
-template <int k, typename T = double> Array<k, T> inverse(const Array<k, T> &);
+template <int k, typename T, class Alloc>
+Array<k, T, Alloc> inverse(const Array<k, T, Alloc> &);
 
 #endif /* HAVE_LAPACK */
 
@@ -95,6 +111,56 @@ struct EmptyType {
   typedef void value_type;
 };
 
+//! Tag used to construct arrays whose elements are left uninitialized
+/*! Array<2> a(m, n, uninitialized) allocates memory without writing to it, for
+ * results that are about to be overwritten completely.
+ */
+struct UninitializedType {};
+
+constexpr UninitializedType uninitialized = UninitializedType();
+
+//! Trait used to identify complex element types
+template <typename T> struct Is_complex {
+  static constexpr bool value = false;
+};
+
+template <typename T> struct Is_complex<std::complex<T> > {
+  static constexpr bool value = true;
+};
+
+//! Trait that gives the real type underlying an element type
+/*! Norms, absolute values and singular values of arrays of complex elements
+ * are real, so they are returned as Real_type<T>::type.
+ */
+template <typename T> struct Real_type {
+  typedef T type;
+};
+
+template <typename T> struct Real_type<std::complex<T> > {
+  typedef T type;
+};
+
+//! Trait used to identify the scalar types that can multiply an array
+template <typename T> struct Is_scalar {
+  static constexpr bool value =
+      std::is_arithmetic<T>::value || Is_complex<T>::value;
+};
+
+//! Norms of an array computed together in a single sweep
+/*! For matrices, norm_2 holds the Frobenius norm, since the spectral norm
+ * would require a singular value decomposition. The 2-norm is obtained from
+ * the sum of squares without scaling, so unlike Norm_2 it can overflow for
+ * elements larger than the square root of the largest representable value.
+ */
+template <typename T> struct Norms {
+  typedef typename Real_type<T>::type real_type;
+
+  real_type norm_1;   //!< 1-norm
+  real_type norm_2;   //!< 2-norm, or Frobenius norm for matrices
+  real_type norm_inf; //!< Infinity norm
+  T sum;              //!< Sum of the elements
+};
+
 __END_ARRAY_NAMESPACE__
 
 #endif /* ARRAY_FWD_HPP */
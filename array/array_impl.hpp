@@ -34,9 +34,12 @@
 #include <initializer_list>
 #include <cmath>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "return_type.hpp"
 #include "blas_lapack.hpp"
+#include "parallel.hpp"
 
 __BEGIN_ARRAY_NAMESPACE__
 
@@ -238,11 +241,103 @@ private:
   pointer p_; //!< Pointer to memory
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// fill helpers
+
+//! Helper class used to call a functor with the indices of an element
+/*! The first index is passed separately, and the remaining d - 1 indices are
+ * taken from the array idx.
+ */
+template <int d> struct Index_call {
+  template <typename T, class functor, typename... I>
+  static T apply(functor &fn, size_t i, const size_t *idx, I... j) {
+    return Index_call<d - 1>::template apply<T>(fn, i, idx, idx[d - 1], j...);
+  }
+};
+
+template <> struct Index_call<1> {
+  template <typename T, class functor, typename... I>
+  static T apply(functor &fn, size_t i, const size_t *, I... j) {
+    return fn(i, j...);
+  }
+};
+
+//! Helper class used to fill arrays from functors
+/*! Elements are visited in storage order, so the innermost loop runs over the
+ * first index with unit stride and the compiler can vectorize it. Large arrays
+ * are split in contiguous chunks that are filled by different threads, so the
+ * functor must be safe to call concurrently.
+ */
+struct Fill {
+
+  //! Number of elements in the chunks filled by each thread
+  static constexpr size_t chunk_size = 1 << 16;
+
+  //! Fills the array of rank k and dimensions n stored in data
+  template <int k, typename T, class functor>
+  static void apply(T *data, const size_t *n, functor &fn) {
+
+    size_t size = 1;
+    for (int d = 0; d < k; ++d)
+      size *= n[d];
+
+    auto chunk = [=, &fn](size_t c) {
+      const size_t b = c * chunk_size;
+      fill<k>(data, n, fn, b, b + chunk_size < size ? b + chunk_size : size);
+    };
+
+    const size_t chunks = (size + chunk_size - 1) / chunk_size;
+    if (chunks <= 1)
+      for (size_t c = 0; c < chunks; ++c)
+        chunk(c);
+    else
+      parallel_for(0, chunks, chunk);
+  }
+
+private:
+  //! Fills the elements in positions [b, e) of the storage
+  template <int k, typename T, class functor>
+  static void fill(T *data, const size_t *n, functor &fn, size_t b, size_t e) {
+
+    // indices of the first element
+    size_t idx[k], r = b;
+    for (int d = 0; d < k; ++d) {
+      idx[d] = r % n[d];
+      r /= n[d];
+    }
+
+    while (b < e) {
+
+      // contiguous run over the first index
+      const size_t i0 = idx[0];
+      const size_t i1 = e - b < n[0] - i0 ? i0 + e - b : n[0];
+      T *p = data + b - i0;
+      for (size_t i = i0; i < i1; ++i)
+        p[i] = Index_call<k>::template apply<T>(fn, i, idx);
+      b += i1 - i0;
+
+      // move to the next run
+      idx[0] = 0;
+      for (int d = 1; d < k && ++idx[d] == n[d]; ++d)
+        idx[d] = 0;
+    }
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // array traits clases
 
 //! Array traits class
-template <int k, typename T, class array_type> class Array_traits {};
+template <int k, typename T, class array_type> class Array_traits {
+
+protected:
+  //! Helper function used to fill an array of any rank from a functor, lambda
+  // expression, etc. taking k indices
+  template <class functor> void fill(functor fn) {
+    array_type &a = static_cast<array_type &>(*this);
+    Fill::apply<k>(a.data_, a.n_, fn);
+  }
+};
 
 //! Array traits partial template specialization for vectors
 template <typename T, class array_type> class Array_traits<1, T, array_type> {
@@ -254,8 +349,7 @@ protected:
   //etc.
   template <class functor> void fill(functor fn) {
     array_type &a = static_cast<array_type &>(*this);
-    for (size_t i = 0; i < a.n_[0]; ++i)
-      a.data_[i] = fn(i);
+    Fill::apply<1>(a.data_, a.n_, fn);
   }
   
 public:
@@ -265,7 +359,33 @@ public:
    * This function calls a helper function depending on the type stored in the
    * vector.
    */
-  value_type norm(Norm_type n = Norm_2) const { return norm(n, Type2Type<value_type>()); }
+  typename Real_type<value_type>::type norm(Norm_type n = Norm_2) const {
+    return norm(n, Type2Type<value_type>());
+  }
+  
+  /*! \brief Obtain the 1-, 2- and infinity norms and the sum of the elements
+   * of a vector in a single sweep
+   *
+   * With the parallel policy, cache-sized chunks of the vector are swept by
+   * the threads of the pool and their reductions merged.
+   */
+  Norms<value_type> norms(Execution_policy p = execution_policy()) const {
+    typedef typename Real_type<value_type>::type real_type;
+    const array_type &a = static_cast<const array_type &>(*this);
+    const size_t n = a.n_[0], chunk = cache_chunk<value_type>();
+    const value_type *x = a.data_;
+
+    std::vector<Simd::Sums<value_type> > c((n + chunk - 1) / chunk);
+    parallel_for(p, 0, c.size(), [=, &c](size_t i) {
+      Simd::sweep(std::min(chunk, n - i * chunk), x + i * chunk, 1, c[i]);
+    });
+
+    Simd::Sums<value_type> s;
+    for (size_t i = 0; i < c.size(); ++i)
+      s.merge(c[i]);
+    return Norms<value_type>{ s.abs, static_cast<real_type>(std::sqrt(s.sq)),
+                              s.max, s.sum };
+  }
   
   
   /*! \brief Normalize vector to unit length
@@ -278,31 +398,31 @@ public:
 private:
   
   //! Helper function used by norm
+  /*! Integers have no blas routines, so the calls below resolve to the
+   * vectorized kernels in simd.hpp.
+   */
   template <typename U>
-  inline typename std::enable_if<std::is_integral<U>::value, U>::type
+  inline typename std::enable_if<!Is_complex<U>::value, U>::type
   norm(Norm_type n, Type2Type<U>) const {
+    
     U norm = U();
 
     const array_type &a = static_cast<const array_type &>(*this);
-
+    
     switch (n) {
-    case Norm_1:
-      for (size_t i = 0; i < a.n_[0]; ++i)
-        norm += abs(a.data_[i]);
-      break;
-
+      case Norm_1:
+        // call to blas routine
+        norm = cblas_asum(a.n_[0], a.data_, 1); break;
       case Norm_2:
-
-        for (size_t i = 0; i < a.n_[0]; ++i)
-          norm += std::pow(a.data_[i], 2);
-        norm = std::sqrt(norm);
-        
+        // call to blas routine
+        norm = cblas_nrm2(a.n_[0], a.data_, 1); break;
       case Norm_inf: {
-
-        for (size_t i=0; i<a.n_[0]; ++i) {
-          U tmp = abs(a.data_[i]);
-            if (tmp > norm)
-              norm = tmp;
+        
+        if (a.n_[0] > 0) {
+          // call to blas routine
+          norm = a.data_[cblas_iamax(a.n_[0], a.data_, 1)];
+          if (norm < U())
+            norm = -norm;
         }
         break;
       }
@@ -313,40 +433,32 @@ private:
     return norm;
   }
   
-  //! Helper function used by norm
+  //! Helper function used by norm when storing complex type
+  /*! The blas xASUM and IxAMAX routines use the absolute values of the real
+   * and imaginary parts, so the 1- and infinity norms are computed with the
+   * modulus instead.
+   */
   template <typename U>
-  inline typename std::enable_if<!std::is_integral<U>::value, U>::type
+  inline typename std::enable_if<Is_complex<U>::value,
+                                 typename Real_type<U>::type>::type
   norm(Norm_type n, Type2Type<U>) const {
     
-    U norm = U();
-
     const array_type &a = static_cast<const array_type &>(*this);
     
     switch (n) {
       case Norm_1:
-        // call to blas routine
-        norm = cblas_asum(a.n_[0], a.data_, 1); break;
+        return norms().norm_1;
       case Norm_2:
         // call to blas routine
-        norm = cblas_nrm2(a.n_[0], a.data_, 1); break;
-      case Norm_inf: {
-        
-        for (size_t i=0; i<a.n_[0]; ++i) {
-          U tmp = abs(a.data_[i]);
-          if (tmp > norm)
-            norm = tmp;
-        }
-        break;
-      }
+        return cblas_nrm2(a.n_[0], a.data_, 1);
+      case Norm_inf:
+        return norms().norm_inf;
       default:
         cout<<"Error: "<<n<<" not implemented for matrices"<<endl;
         exit(1);
     }
-    return norm;
   }
   
-  
-  
 };
 
 //! Array traits partial template specialization for matrices
@@ -361,9 +473,7 @@ protected:
   //etc.
   template <class functor> void fill(functor fn) {
     array_type &a = static_cast<array_type &>(*this);
-    for (size_t i = 0; i < rows(); ++i)
-      for (size_t j = 0; j < columns(); ++j)
-        a.data_[i + j * rows()] = fn(i, j);
+    Fill::apply<2>(a.data_, a.n_, fn);
   }
   
 public:
@@ -379,81 +489,72 @@ public:
   /*! This function calls a helper function depending on the type
    * stored in the matrix.
    */
-  value_type norm(Norm_type n = Norm_1) const { return norm(n, Type2Type<value_type>()); }
+  typename Real_type<value_type>::type norm(Norm_type n = Norm_1) const {
+    return norm(n, Type2Type<value_type>());
+  }
   
-private:
-  //! Helper function used by norm
-  template <typename U>
-  inline typename std::enable_if<std::is_integral<U>::value, U>::type
-  norm(Norm_type n, Type2Type<U>) const {
-    U norm = U();
-    
+  //! Obtain the 1- and infinity norms, the Frobenius norm and the sum of the
+  // elements of a matrix in a single sweep
+  /*! With the parallel policy, the rows are split in one band per thread, and
+   * the column sums of the bands are added at the end.
+   */
+  Norms<value_type> norms(Execution_policy p = execution_policy()) const {
+
+    typedef typename Real_type<value_type>::type real_type;
     const array_type &a = static_cast<const array_type &>(*this);
+    const size_t m = a.n_[0], n = a.n_[1];
+    const value_type *x = a.data_;
 
-    switch (n) {
-      case Norm_1: {
-        
-        // loop over columns
-        for (size_t i=0; i<a.n_[1]; ++i) {
-          U tmp = U();
-          for (size_t j=0; j<a.n_[0]; ++j)
-            tmp += a.data_[i*a.n_[0] + j];
-          if (tmp > norm)
-            norm = tmp;
-        }
-        break;
-      }
-      case Norm_inf: {
-        // loop over rows
-        for (size_t i=0; i<a.n_[0]; ++i) {
-          U tmp = U();
-          for (size_t j=0; j<a.n_[1]; ++j)
-            tmp += a.data_[i + a.n_[0]*j];
-          if (tmp > norm)
-            norm = tmp;
-        }
-        break;
-      }
-      default:
-        cout<<"Error: "<<n<<" not implemented for matrices"<<endl;
-        exit(1);
+    // bands of at least a cache-sized chunk of elements
+    size_t bands = std::min(hardware_threads(), m * n / cache_chunk<value_type>());
+    if (bands == 0 || !p.parallel())
+      bands = 1;
+    const size_t rows = (m + bands - 1) / bands;
+    bands = (m + rows - 1) / rows;
+
+    // absolute sums of the columns of each band and of the rows
+    std::vector<real_type> c(n * bands), r(m);
+    std::vector<Simd::Sums<value_type> > s(bands);
+    real_type *cp = c.data(), *rp = r.data();
+    parallel_for(p, 0, bands, [=, &s](size_t b) {
+      const size_t i = b * rows;
+      Simd::sweep(std::min(rows, m - i), n, x + i, m, s[b], cp + b * n, rp + i);
+    });
+
+    for (size_t b = 1; b < bands; ++b) {
+      s[0].merge(s[b]);
+      for (size_t j = 0; j < n; ++j)
+        c[j] += c[j + b * n];
     }
-    return norm;
+
+    Norms<value_type> nr = { real_type(), static_cast<real_type>(std::sqrt(s[0].sq)),
+                             real_type(), s[0].sum };
+    for (size_t j = 0; j < n; ++j)
+      if (c[j] > nr.norm_1)
+        nr.norm_1 = c[j];
+    for (size_t i = 0; i < m; ++i)
+      if (r[i] > nr.norm_inf)
+        nr.norm_inf = r[i];
+    return nr;
   }
-  
-  //! Helper function used by norm when storing double type
+
+private:
+  //! Helper function used by norm
+  /*! The column and row sums are both obtained from a single sweep over the
+   * matrix, instead of one strided pass per row.
+   */
   template <typename U>
-  inline typename std::enable_if<!std::is_integral<U>::value, U>::type
-  norm(Norm_type n, Type2Type<U>) const {
-    
-    const array_type &a = static_cast<const array_type &>(*this);
-    
-    U norm = U();
-    
+  inline typename Real_type<U>::type norm(Norm_type n, Type2Type<U>) const {
+
     switch (n) {
-    case Norm_1: {
-        // loop over columns
-        for (size_t i=0; i<a.n_[1]; ++i) {
-          U tmp = cblas_asum(a.n_[0], &a.data_[i*a.n_[0]], 1);
-          if (tmp > norm)
-            norm = tmp;
-        }
-        break;
-      }
-      case Norm_inf: {
-        // loop over rows
-        for (size_t i=0; i<a.n_[0]; ++i) {
-          U tmp = cblas_asum(a.n_[1], &a.data_[i], a.n_[0]);
-          if (tmp > norm)
-            norm = tmp;
-        }
-        break;
-      }
+      case Norm_1:
+        return norms().norm_1;
+      case Norm_inf:
+        return norms().norm_inf;
       default:
         cout<<"Error: "<<n<<" not implemented for matrices"<<endl;
         exit(1);
     }
-    return norm;
   }
 };
 
@@ -466,17 +567,8 @@ protected:
   //! Helper function used to fill a vector from a functor, lambda expression,
   //etc.
   template <class functor> void fill(functor fn) {
-    
     array_type &a = static_cast<array_type &>(*this);
-    size_t m = a.n_[0];
-    size_t n = a.n_[1];
-    size_t o = a.n_[2];
-    
-    for (size_t i = 0; i < m; ++i)
-      for (size_t j = 0; j < n; ++j)
-        for (size_t k = 0; k < o; ++k)
-          for (size_t l = 0; l < a.n_[3]; ++l)
-            a.data_[i + m * j + m * n * k + m * n * o * l] = fn(i, j, k, l);
+    Fill::apply<4>(a.data_, a.n_, fn);
   }
 };
 
@@ -487,18 +579,27 @@ protected:
 /*! This class template is used to define tensors of any rank.
  * \tparam k - Tensor rank
  * \tparam T - Type stored in the tensor
+ * \tparam Alloc - Allocator used to obtain the memory of the tensor
  *
  * The class template inherits from Array_traits passing itself as
  * a template parameter to use the Curiously Recurring Template
  * Pattern (CRTP).
+ *
+ * Memory is obtained from a default constructed Alloc object, so the
+ * allocator must be stateless, e.g., a huge page or pool allocator that
+ * refers to a global resource. By default the memory is aligned to
+ * array_alignment bytes. Expressions are evaluated into arrays that use the
+ * default allocator, and arrays with any other allocator take part in them
+ * through a view of their elements.
  */
-template <int k, typename T>
-class Array : public Array_traits<k, T, Array<k, T> > {
+template <int k, typename T, class Alloc>
+class Array : public Array_traits<k, T, Array<k, T, Alloc> > {
   
   typedef Array_traits<k, T, Array> traits_type;
   
 public:
   typedef T value_type;
+  typedef Alloc allocator_type;
   typedef T *pointer;
   typedef const T *const_pointer;
   typedef T &reference;
@@ -510,9 +611,10 @@ public:
   typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
   
 private:
-  size_t n_[k] = { 0 }; //!< Tensor dimensions
-  pointer data_;        //!< Pointer to memory
-  bool wrapped_;        //!< Owned memory flag
+  size_t n_[k] = { 0 };     //!< Tensor dimensions
+  size_t s_[k + 1] = { 0 }; //!< Strides, s_[k] is the number of elements
+  pointer data_;            //!< Pointer to memory
+  bool wrapped_;            //!< Owned memory flag
   
 public:
   //! Rank of the tensor
@@ -533,28 +635,67 @@ public:
   //! Move constructor
   Array(Array &&src);
   
+  //! Constructor taking an array that uses a different allocator
+  template <class S> Array(const Array<k, T, S> &a);
+  
   //! Destructor
   ~Array() {
     if (!wrapped_)
-      delete[] data_;
+      deallocate(data_, size());
   }
   
   //! Assignment operator
   Array &operator=(const Array &src);
   
+  //! Assignment operator taking an array that uses a different allocator
+  template <class S> Array &operator=(const Array<k, T, S> &src);
+  
   //! Move assignment operator
   Array &operator=(Array &&src);
   
+  //! Assignment operator taking an arbitrary expression
+  template <class A> Array &operator=(const Expr<A> &expr);
+  
+  //! Assignment operator taking a view, copies the elements of the view
+  Array &operator=(const View<k, T> &v) { return *this = value_type(1) * v; }
+  
 private:
+  typedef std::allocator_traits<Alloc> alloc_traits;
+  
+  //! Allocate uninitialized memory for n elements
+  static pointer allocate(size_t n) {
+    Alloc a;
+    return n > 0 ? alloc_traits::allocate(a, n) : nullptr;
+  }
+  
+  //! Release memory obtained by allocate
+  static void deallocate(pointer p, size_t n) {
+    Alloc a;
+    if (p)
+      alloc_traits::deallocate(a, p, n);
+  }
+  
+  //! Helper function used by the copy constructors and assignment operators
+  template <class S> void copy(const Array<k, T, S> &src);
+
+  //! Helper function used to copy arrays with compile-time extents
+  template <size_t... m> void copy(const Array<k, T, Extents<m...> > &src);
+  
   //! Helper function used by constructors
   size_t init_dim() {
-    size_t s = n_[0];
-    for (size_t i = 1; i < k; ++i) {
+    for (size_t i = 1; i < k; ++i)
       if (n_[i] == 0)
         n_[i] = n_[i - 1];
-      s *= n_[i];
-    }
-    return s;
+    return init_strides();
+  }
+  
+  //! Helper function that computes the stride table from the dimensions,
+  // called whenever the dimensions change. Returns the number of elements.
+  size_t init_strides() {
+    s_[0] = 1;
+    for (int i = 0; i < k; ++i)
+      s_[i + 1] = s_[i] * n_[i];
+    return s_[k];
   }
   
   //! init helper function that takes an integer parameter
@@ -572,8 +713,14 @@ private:
   template <int d> void init(value_type v = value_type()) {
     
     size_t s = init_dim();
-    data_ = new value_type[s];
-    std::fill_n(data_, s, v);
+    data_ = allocate(s);
+    parallel_fill(data_, s, v);
+  }
+  
+  //! init helper function that leaves the elements uninitialized
+  template <int d> void init(UninitializedType) {
+    
+    data_ = allocate(init_dim());
   }
   
   //! init helper function that takes a pointer to already existing data
@@ -589,12 +736,13 @@ private:
   //! init helper function that takes a functor, lambda expression, etc.
   template <int d, class functor>
   typename std::enable_if<
-  !std::is_integral<functor>::value and !std::is_pointer<functor>::value,
+  !std::is_integral<functor>::value and !std::is_pointer<functor>::value and
+  !std::is_same<functor, UninitializedType>::value,
   void>::type
   init(functor fn) {
     
     size_t s = init_dim();
-    data_ = new value_type[s];
+    data_ = allocate(s);
     this->fill(fn);
   }
   
@@ -634,7 +782,7 @@ public:
       
       a.n_[k - 1] = l.size(); // set dimension
       if (!a.data_)
-        a.data_ = new value_type[s * l.size()];
+        a.data_ = allocate(s * l.size());
       
       size_t j = 0;
       for (const auto &r : l)
@@ -648,24 +796,27 @@ public:
   Array(initializer_type l) : data_(nullptr), wrapped_() {
     
     Initializer_list<k, T>::process(l, *this, 1, 0);
+    init_strides();
+  }
+  
+  //! constructor taking a view, copies the elements of the view
+  Array(const View<k, T> &v) : data_(nullptr), wrapped_() {
+    *this = v;
   }
   
   //! constructor taking an arbitrary expression
   template <class A> Array(const Expr<A> &expr) : data_(nullptr), wrapped_() {
     
-    static_assert(SameClass<Array, typename A::result_type>::result,
+    typedef typename A::result_type result_type;
+    static_assert(result_type::rank() == k &&
+                  std::is_same<typename result_type::value_type, T>::value,
                   "*** ERROR *** Resulting expression is not of type array.");
     Array &a = *this;
     a = expr();
   }
   
   //! Size of the tensor
-  size_t size() const {
-    size_t n = 1;
-    for (size_t i = 0; i < k; ++i)
-      n *= n_[i];
-    return n;
-  }
+  size_t size() const { return s_[k]; }
   
   //! Size along the ith direction
   size_t size(size_t i) const { return n_[i]; }
@@ -676,18 +827,20 @@ private:
   
   //! Helper function used to compute the index on the one-dimensional array
   //that stores the tensor elements
-  template <typename pack_type> pack_type index(pack_type indices[]) const {
-    
-    pack_type i = indices[0], s = 1;
-    for (int j = 1; j < k; ++j) {
-      assert(indices[j] >= 0);
-      assert(static_cast<size_t>(indices[j]) < n_[j]);
-      // static cast to avoid compiler warning about comparison between signed
-      // and unsigned integers
-      s *= n_[j - 1];
-      i += s * indices[j];
-    }
-    return i;
+  /*! The index is the dot product of the indices with the stride table,
+   * unrolled at compile time. The first stride is always one.
+   */
+  template <int d, typename I> size_t index(I i) const {
+    // static cast to avoid compiler warning about comparison between signed
+    // and unsigned integers, negative indices wrap around and fail too
+    assert(static_cast<size_t>(i) < n_[d]);
+    return d == 0 ? i : i * s_[d];
+  }
+  
+  //! Helper function used to compute the index, recursion over the indices
+  template <int d, typename I, typename... Rest>
+  size_t index(I i, Rest... rest) const {
+    return index<d>(i) + index<d + 1>(rest...);
   }
   
   //! Helper structure used by operator()
@@ -720,13 +873,12 @@ public:
                   sizeof...(Args) == k,
                   "*** ERROR *** Number of parameters does not match array rank.");
     
-    typedef typename Check_integral<Args...>::pack_type pack_type;
-    
-    // unpack parameters
-    pack_type indices[] = { params... };
+    // check that all parameters are integral
+    static_assert(Check_integral<Args...>::value,
+                  "*** ERROR *** Non-integral type parameter found.");
     
     // return reference
-    return data_[index(indices)];
+    return data_[index<0>(params...)];
   }
   
   //! Indexed access through operator() for constant tensors
@@ -737,13 +889,12 @@ public:
                   sizeof...(Args) == k,
                   "*** ERROR *** Number of parameters does not match array rank.");
     
-    typedef typename Check_integral<Args...>::pack_type pack_type;
-    
-    // unpack parameters
-    pack_type indices[] = { params... };
+    // check that all parameters are integral
+    static_assert(Check_integral<Args...>::value,
+                  "*** ERROR *** Non-integral type parameter found.");
     
     // return reference
-    return data_[index(indices)];
+    return data_[index<0>(params...)];
   }
   
   typedef typename Array_proxy_traits<k, Array>::reference proxy_reference;
@@ -770,7 +921,12 @@ public:
   
   //! Division compound assignment operator
   Array &operator/=(value_type s) {
-    cblas_scal(size(), value_type(1) / s, data_, 1);
+    // the reciprocal of an integer is truncated to zero
+    if (std::is_integral<value_type>::value)
+      for (size_t i = 0; i < size(); ++i)
+        data_[i] /= s;
+    else
+      cblas_scal(size(), value_type(1) / s, data_, 1);
     return *this;
   }
   
@@ -782,8 +938,8 @@ public:
       assert(n_[i] == b.n_[i]);
     
     // call blas routine to add the arrays
-    cblas_axpy(size(), 1.0, b.data_, 1, data_, 1);
-    // NOTE: the 1.0 is the factor by which v is scaled
+    cblas_axpy(size(), value_type(1), b.data_, 1, data_, 1);
+    // NOTE: the 1 is the factor by which v is scaled
     return *this;
   }
   
@@ -795,7 +951,7 @@ public:
       assert(n_[i] == b.n_[i]);
     
     // call blas routine to add the arrays
-    cblas_axpy(size(), -1.0, b.data_, 1, data_, 1);
+    cblas_axpy(size(), value_type(-1), b.data_, 1, data_, 1);
     return *this;
   }
   
@@ -803,13 +959,43 @@ public:
     return Array<1,T>(size(), data_);
   }
 
-  //! Helper function used to compute the stride of iterators
-  size_t stride(size_t dim) const {
-    
-    size_t s = 1;
-    for (int j = 0; j < dim; ++j)
-      s *= n_[j];
-    return s;
+  //! Distance between consecutive elements along dimension dim, stride(k)
+  // is the number of elements
+  size_t stride(size_t dim) const { return s_[dim]; }
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  // views
+  
+  //! View of the whole array
+  View<k, T> view() {
+    size_t s[k];
+    for (int i = 0; i < k; ++i)
+      s[i] = stride(i);
+    return View<k, T>(data_, n_, s);
+  }
+  
+  //! View of the ith slice along dimension d, which has one dimension less
+  template <int d> View<k - 1, T> slice(size_t i) {
+    return view().template slice<d>(i);
+  }
+  
+  //! View of the elements [i, i + m) along dimension d
+  template <int d> View<k, T> range(size_t i, size_t m) {
+    return view().template range<d>(i, m);
+  }
+  
+  //! View of row i of a matrix
+  View<1, T> row(size_t i) { return view().row(i); }
+  
+  //! View of column j of a matrix
+  View<1, T> column(size_t j) { return view().column(j); }
+  
+  //! View of the elements [i, i + m) of a vector
+  View<k, T> block(size_t i, size_t m) { return view().block(i, m); }
+  
+  //! View of the block of a matrix with m rows and n columns starting at (i,j)
+  View<k, T> block(size_t i, size_t j, size_t m, size_t n) {
+    return view().block(i, j, m, n);
   }
   
   ////////////////////////////////////////////////////////////////////////////////
@@ -903,20 +1089,18 @@ public:
   friend class ApAdd;
   friend class ApSub;
   friend class ApMul;
+  friend class ApElementwise;
+  friend class ApAssign;
 
-  // make arrays of other ranks a friend class
-  template <int s, typename S> friend struct Array;
-  
-  
-  friend Array identity<k, T>(size_t);
-
+  // make arrays of other ranks and allocators a friend class
+  template <int, typename, class> friend class Array;
   
-  friend Array identity<k, T>(size_t);
+  friend Array identity<k, T, Alloc>(size_t);
 
   
   //! Cast Array into a scalar
   template <class S>
-  typename std::enable_if<std::is_arithmetic<S>::value, S>::type
+  typename std::enable_if<Is_scalar<S>::value, S>::type
   algebraic_cast() const {
     
     if (size() != 1) {
@@ -932,18 +1116,17 @@ public:
   template <class casted_type>
   typename std::enable_if<(casted_type::rank() > rank()), casted_type > ::type algebraic_cast() const {
 
-    typedef typename casted_type::value_type casted_value_type;
-    
     size_t s = size();
     casted_type c;
-    c.data_ = new casted_value_type[s];
-    std::copy_n(data_, s, c.data_);
+    c.data_ = casted_type::allocate(s);
+    parallel_copy(data_, s, c.data_);
     
     int i=0;
     for (; i<k; ++i)
       c.n_[i] = n_[i];
     for (; i<casted_type::rank(); ++i)
       c.n_[i] = 1;
+    c.init_strides();
     return c;
   }
   
@@ -951,11 +1134,9 @@ public:
   template <class casted_type>
   typename std::enable_if<(casted_type::rank() < rank()), casted_type > ::type algebraic_cast() const {
     
-    typedef typename casted_type::value_type casted_value_type;
-
     casted_type c;
     size_t s = size();
-    c.data_ = new casted_value_type[s];
+    c.data_ = casted_type::allocate(s);
     
     // compute larger rank tensor size
     size_t t = 1;
@@ -963,6 +1144,7 @@ public:
       c.n_[i] = n_[i];
       t *= n_[i];
     }
+    c.init_strides();
     // make sure that all sizes are equal to one
     if (t != s) {
       cerr << "Error: In algebraic_cast function" << endl;
@@ -970,7 +1152,7 @@ public:
            << casted_type::rank() << " due to incompatible dimensions" << endl;
       exit(1);
     }
-    std::copy_n(data_, s, c.data_);
+    parallel_copy(data_, s, c.data_);
     return c;
   }
 
@@ -988,7 +1170,7 @@ public:
 
 #if defined(HAVE_LAPACK) || defined(HAVE_CLAPACK)
 
-  friend Array inverse<k, T>(const Array&);
+  friend Array inverse<k, T, Alloc>(const Array&);
   
 #endif /* HAVE_LAPACK */
 
@@ -1008,88 +1190,102 @@ public:
   ////////////////////////////////////////////////////////////////////////////////
   // implementation of array functions
   
-  // copy constructor
-  template <int k, typename T>
-  Array<k, T>::Array(const Array<k, T> &a)
-  : data_(nullptr), wrapped_() {
+  // copy helper, leaves the array with the dimensions of src and either a copy
+  // of its elements or, if src is wrapped, a reference to its memory
+  template <int k, typename T, class Alloc>
+  template <class S>
+  void Array<k, T, Alloc>::copy(const Array<k, T, S> &src) {
     
-    std::copy_n(a.n_, k, n_);
-    wrapped_ = a.wrapped_;
+    std::copy_n(src.n_, k, n_);
+    std::copy_n(src.s_, k + 1, s_);
+    wrapped_ = src.wrapped_;
     
     if (!wrapped_) {
       size_t s = size();
-      assert((a.data_ && s > 0) || (!a.data_ && s == 0));
+      assert((src.data_ && s > 0) || (!src.data_ && s == 0));
       
-      if (a.data_) {
-        data_ = new value_type[s];
-        std::copy_n(a.data_, s, data_);
+      if (src.data_) {
+        data_ = allocate(s);
+        parallel_copy(src.data_, s, data_);
       } else
         data_ = nullptr;
     } else
-      data_ = a.data_;
+      data_ = src.data_;
+  }
+  
+  // copy constructor
+  template <int k, typename T, class Alloc>
+  Array<k, T, Alloc>::Array(const Array &a)
+  : data_(nullptr), wrapped_() {
+    copy(a);
+  }
+  
+  // constructor taking an array that uses a different allocator
+  template <int k, typename T, class Alloc>
+  template <class S>
+  Array<k, T, Alloc>::Array(const Array<k, T, S> &a)
+  : data_(nullptr), wrapped_() {
+    copy(a);
   }
   
   // move constructor
-  template <int k, typename T>
-  Array<k, T>::Array(Array<k, T> &&src)
+  template <int k, typename T, class Alloc>
+  Array<k, T, Alloc>::Array(Array &&src)
   : data_(nullptr), wrapped_() {
     std::copy_n(src.n_, k, n_);
+    std::copy_n(src.s_, k + 1, s_);
     data_ = src.data_;
     wrapped_ = src.wrapped_;
     
     std::fill_n(src.n_, k, 0);
+    std::fill_n(src.s_, k + 1, 0);
     src.data_ = nullptr;
     src.wrapped_ = false;
   }
   
   // assignment operator
-  template <int k, typename T>
-  Array<k, T> &Array<k, T>::operator=(const Array<k, T> &src) {
+  template <int k, typename T, class Alloc>
+  Array<k, T, Alloc> &Array<k, T, Alloc>::operator=(const Array &src) {
     
     if (this != &src) {
       
       if (!wrapped_)
-        delete[] data_;
-      
-      std::copy_n(src.n_, k, n_);
-      wrapped_ = src.wrapped_;
-      
-      if (!wrapped_) {
-        
-        size_t s = size();
-        assert((src.data_ && s > 0) || (!src.data_ && s == 0));
-        
-        if (src.data_) {
-          data_ = new value_type[s];
-          std::copy_n(src.data_, s, data_);
-        } else
-          data_ = nullptr;
-      } else
-        data_ = src.data_;
+        deallocate(data_, size());
+      copy(src);
     }
     return *this;
   }
   
+  // assignment operator taking an array that uses a different allocator
+  template <int k, typename T, class Alloc>
+  template <class S>
+  Array<k, T, Alloc> &Array<k, T, Alloc>::operator=(const Array<k, T, S> &src) {
+    
+    if (!wrapped_)
+      deallocate(data_, size());
+    copy(src);
+    return *this;
+  }
+  
   // move assignment operator
-  template <int k, typename T>
-  Array<k, T> &Array<k, T>::operator=(Array<k, T> &&src) {
+  template <int k, typename T, class Alloc>
+  Array<k, T, Alloc> &Array<k, T, Alloc>::operator=(Array &&src) {
     
     if (this != &src) {
       
-      if (this != &src) {
-        
-        if (!wrapped_)
-          delete[] data_;
-        
-        std::copy_n(src.n_, k, n_);
-        wrapped_ = src.wrapped_;
-        data_ = src.data_;
-        
-        // set src to default
-        src.data_ = nullptr;
-        src.wrapped_ = false;
-        std::fill_n(src.n_, k, 0);
-      }
+      if (!wrapped_)
+        deallocate(data_, size());
+      
+      std::copy_n(src.n_, k, n_);
+      std::copy_n(src.s_, k + 1, s_);
+      wrapped_ = src.wrapped_;
+      data_ = src.data_;
+      
+      // set src to default
+      src.data_ = nullptr;
+      src.wrapped_ = false;
+      std::fill_n(src.n_, k, 0);
+      std::fill_n(src.s_, k + 1, 0);
     }
     return *this;
   }
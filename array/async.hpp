@@ -0,0 +1,161 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file async.hpp
+ *
+ * \brief This file contains the asynchronous evaluation of expressions, which
+ * evaluates the independent branches of an expression tree concurrently.
+ */
+
+#ifndef ARRAY_ASYNC_HPP
+#define ARRAY_ASYNC_HPP
+
+#include "functions.hpp"
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! Trait used to identify expressions that contain a product of arrays
+/*! Only such branches are worth a task of their own, scalings and element-wise
+ * operations are cheaper than the task itself.
+ */
+template <class E> struct Has_product {
+  enum { value = false };
+};
+
+template <class A> struct Has_product<Expr<A> > {
+  enum { value = Has_product<A>::value };
+};
+
+template <class A, class B, class Op> struct Has_product<BinExprOp<A, B, Op> > {
+  enum { value = Has_product<A>::value || Has_product<B>::value };
+};
+
+template <class A, class B> struct Has_product<BinExprOp<A, B, ApMul> > {
+  enum { value = true };
+};
+
+template <typename T, class B>
+struct Has_product<BinExprOp<ExprLiteral<T>, B, ApMul> > {
+  enum { value = Has_product<B>::value };
+};
+
+
+//! Asynchronous evaluator class template
+/*! The expression tree is the task graph: every node depends on its two
+ * branches only. Nodes whose branches both contain products evaluate them as
+ * two concurrent tasks, each given half of the BLAS threads available to the
+ * node, and then combine the results. Other nodes are evaluated as usual.
+ *
+ * Splitting the BLAS threads requires a library whose number of threads can
+ * be set per thread (MKL). If it can only be set for the whole process
+ * (OpenBLAS), concurrent branches would each run on a single BLAS thread,
+ * see Blas_threads, so the branches are evaluated one after the other with
+ * all the threads instead.
+ */
+template <class E> struct Async {
+
+  typedef typename E::result_type result_type;
+
+  static result_type evaluate(const E &e) { return e(); }
+};
+
+template <class A, class B, class Op>
+struct Async<Expr<BinExprOp<Expr<A>, Expr<B>, Op> > > {
+
+  typedef Expr<BinExprOp<Expr<A>, Expr<B>, Op> > expression_type;
+  typedef typename expression_type::result_type result_type;
+  typedef typename Expr<A>::result_type left_type;
+  typedef typename Expr<B>::result_type right_type;
+
+  static result_type evaluate(const expression_type &e) {
+    if (Blas_threads::controllable() && !Blas_threads::local())
+      return e();
+    return evaluate(
+        e, Int2Type<Has_product<A>::value && Has_product<B>::value>());
+  }
+
+private:
+  static result_type evaluate(const expression_type &e, Int2Type<false>) {
+    return e();
+  }
+
+  static result_type evaluate(const expression_type &e, Int2Type<true>) {
+
+    const Expr<A> &a = e.left();
+    const Expr<B> &b = e.right();
+
+    // split the blas threads between the branches
+    const int n = Blas_threads::available(), h = std::max(n / 2, 1);
+
+    left_type x = left_type();
+    right_type y = right_type();
+    parallel_invoke(par, [&]() {
+      Blas_threads::Limit limit(h);
+      x = Async<Expr<A> >::evaluate(a);
+    }, [&]() {
+      Blas_threads::Limit limit(std::max(n - h, 1));
+      y = Async<Expr<B> >::evaluate(b);
+    });
+    return combine(x, y, Op());
+  }
+
+  static result_type combine(left_type &x, const right_type &y, ApAdd) {
+    x += y;
+    return std::move(x);
+  }
+
+  static result_type combine(left_type &x, const right_type &y, ApSub) {
+    x -= y;
+    return std::move(x);
+  }
+
+  static result_type combine(const left_type &x, const right_type &y, ApMul) {
+    return result_type(x * y);
+  }
+
+  template <class O>
+  static result_type combine(const left_type &x, const right_type &y, O) {
+    return O::apply(x, y);
+  }
+};
+
+
+//! Evaluates an expression
+/*! With the sequential policy this is the same as converting the expression
+ * to its result. With the parallel policy, independent branches containing
+ * products, such as the two products in A*B + C*D, are evaluated concurrently
+ * on the thread pool, each with part of the BLAS threads. This pays off for
+ * mid-sized matrices, for which BLAS does not scale to all the cores, at the
+ * expense of a temporary per branch. With a BLAS library whose number of
+ * threads is only set for the whole process, such as OpenBLAS, the branches
+ * are evaluated sequentially, see Async.
+ */
+template <class A>
+typename Expr<A>::result_type evaluate(Execution_policy policy,
+                                       const Expr<A> &e) {
+  return policy.parallel() ? Async<Expr<A> >::evaluate(e) : e();
+}
+
+
+__END_ARRAY_NAMESPACE__
+
+#endif /* ARRAY_ASYNC_HPP */
@@ -0,0 +1,240 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file batch.hpp
+ *
+ * \brief This file contains the batched matrix-matrix and matrix-vector
+ * products, which multiply many independent small matrices in a single call.
+ */
+
+#ifndef ARRAY_BATCH_HPP
+#define ARRAY_BATCH_HPP
+
+#include "functions.hpp"
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! Helper class for the batched products
+/*! A batch of matrices is stored in a rank 3 array, where the last index
+ * selects the matrix, so the matrices are packed one after the other. Batches
+ * of small matrices are multiplied with a register-friendly kernel and split
+ * across threads, because going through BLAS once per matrix costs more than
+ * the product itself. Large matrices are handed to BLAS one at a time, which
+ * then uses its own threads.
+ */
+struct Batch {
+
+  //! Matrices are small if none of their dimensions exceeds this size
+  static constexpr size_t small_size = 32;
+
+  //! Minimum number of multiply-adds processed by a thread
+  static constexpr size_t parallel_size = 1 << 16;
+
+  //! Batched matrix-matrix product
+  template <typename T>
+  static void gemm(bool ta, bool tb, size_t m, size_t n, size_t k, size_t count,
+                   T alpha, const T *a, size_t sa, const T *b, size_t sb,
+                   T beta, T *c) {
+
+    if (std::max(m, std::max(n, k)) > small_size) {
+      for (size_t i = 0; i < count; ++i)
+        cblas_gemm(ta ? CblasTrans : CblasNoTrans, tb ? CblasTrans : CblasNoTrans,
+                   m, n, k, alpha, const_cast<T *>(a + i * sa), ta ? k : m,
+                   const_cast<T *>(b + i * sb), tb ? n : k, beta, c + i * m * n, m);
+      return;
+    }
+
+    // choose the kernel once for the whole batch
+    void (*kernel)(size_t, size_t, size_t, T, const T *, const T *, T, T *) =
+        ta ? (tb ? small_gemm<true, true, T> : small_gemm<true, false, T>)
+           : (tb ? small_gemm<false, true, T> : small_gemm<false, false, T>);
+
+    parallel_for(0, count, [=](size_t i) {
+      kernel(m, n, k, alpha, a + i * sa, b + i * sb, beta, c + i * m * n);
+    }, parallel_size / (m * n * k + 1) + 1);
+  }
+
+  //! Batched matrix-vector product
+  template <typename T>
+  static void gemv(bool ta, size_t m, size_t n, size_t count, T alpha,
+                   const T *a, size_t sa, const T *x, size_t sx, T beta, T *y) {
+
+    const size_t r = ta ? n : m, l = ta ? m : n;
+
+    if (std::max(m, n) > small_size) {
+      for (size_t i = 0; i < count; ++i)
+        cblas_gemv(ta ? CblasTrans : CblasNoTrans, m, n, alpha,
+                   const_cast<T *>(a + i * sa), m, const_cast<T *>(x + i * sx), 1,
+                   beta, y + i * r, 1);
+      return;
+    }
+
+    void (*kernel)(size_t, size_t, T, const T *, const T *, T, T *) =
+        ta ? small_gemv<true, T> : small_gemv<false, T>;
+
+    parallel_for(0, count, [=](size_t i) {
+      kernel(m, n, alpha, a + i * sa, x + i * sx, beta, y + i * r);
+    }, parallel_size / (r * l + 1) + 1);
+  }
+
+private:
+  //! Small matrix-matrix product c <- alpha*op(a)*op(b) + beta*c, where op(a)
+  // is m x k and op(b) is k x n. Columns of c are updated with axpy loops
+  // over contiguous memory when a is not transposed, and with dot products
+  // otherwise.
+  template <bool ta, bool tb, typename T>
+  static void small_gemm(size_t m, size_t n, size_t k, T alpha, const T *a,
+                         const T *b, T beta, T *c) {
+
+    for (size_t j = 0; j < n; ++j) {
+
+      T *cj = c + j * m;
+
+      if (!ta) {
+        if (beta == T())
+          std::fill_n(cj, m, T());
+        else if (beta != T(1))
+          for (size_t i = 0; i < m; ++i)
+            cj[i] *= beta;
+
+        for (size_t l = 0; l < k; ++l) {
+          const T blj = alpha * (tb ? b[j + l * n] : b[l + j * k]);
+          const T *al = a + l * m;
+          for (size_t i = 0; i < m; ++i)
+            cj[i] += al[i] * blj;
+        }
+      } else
+        for (size_t i = 0; i < m; ++i) {
+          const T *ai = a + i * k;
+          T s = T();
+          for (size_t l = 0; l < k; ++l)
+            s += ai[l] * (tb ? b[j + l * n] : b[l + j * k]);
+          cj[i] = beta == T() ? alpha * s : alpha * s + beta * cj[i];
+        }
+    }
+  }
+
+  //! Small matrix-vector product y <- alpha*op(a)*x + beta*y, where a is
+  // m x n
+  template <bool ta, typename T>
+  static void small_gemv(size_t m, size_t n, T alpha, const T *a, const T *x,
+                         T beta, T *y) {
+
+    if (!ta) {
+      if (beta == T())
+        std::fill_n(y, m, T());
+      else if (beta != T(1))
+        for (size_t i = 0; i < m; ++i)
+          y[i] *= beta;
+
+      for (size_t j = 0; j < n; ++j) {
+        const T xj = alpha * x[j];
+        const T *aj = a + j * m;
+        for (size_t i = 0; i < m; ++i)
+          y[i] += aj[i] * xj;
+      }
+    } else
+      for (size_t j = 0; j < n; ++j) {
+        const T *aj = a + j * m;
+        T s = T();
+        for (size_t i = 0; i < m; ++i)
+          s += aj[i] * x[i];
+        y[j] = beta == T() ? alpha * s : alpha * s + beta * y[j];
+      }
+  }
+};
+
+
+//! Batched matrix-matrix product
+/*! Computes C(:,:,i) <- alpha*op(A(:,:,i))*op(B(:,:,i)) + beta*C(:,:,i) for
+ * every matrix i in the batch, where op(X) is X or its transpose. Either A or
+ * B may hold a single matrix, which is then used with every matrix of the
+ * other operand. If beta is zero, C need not be initialized.
+ */
+template <typename T, class SA, class SB, class SC>
+void batch_gemm(const Array<3, T, SA> &A, const Array<3, T, SB> &B,
+                Array<3, T, SC> &C, typename Array<3, T, SC>::value_type alpha = 1,
+                typename Array<3, T, SC>::value_type beta = 0, bool transA = false,
+                bool transB = false) {
+
+  const size_t m = transA ? A.size(1) : A.size(0);
+  const size_t k = transA ? A.size(0) : A.size(1);
+  const size_t n = transB ? B.size(0) : B.size(1);
+  const size_t count = std::max(A.size(2), B.size(2));
+
+  // check size
+  assert(k == (transB ? B.size(1) : B.size(0)));
+  assert(A.size(2) == count || A.size(2) == 1);
+  assert(B.size(2) == count || B.size(2) == 1);
+  assert(C.size(0) == m && C.size(1) == n && C.size(2) == count);
+
+  Batch::gemm(transA, transB, m, n, k, count, alpha, A.data(),
+              A.size(2) == 1 ? 0 : m * k, B.data(), B.size(2) == 1 ? 0 : k * n,
+              beta, C.data());
+}
+
+//! Batched matrix-matrix product, returns the array of products A(:,:,i)*B(:,:,i)
+template <typename T, class SA, class SB>
+Array<3, T> batch_multiply(const Array<3, T, SA> &A, const Array<3, T, SB> &B) {
+
+  Array<3, T> C(A.size(0), B.size(1), std::max(A.size(2), B.size(2)),
+                uninitialized);
+  batch_gemm(A, B, C);
+  return C;
+}
+
+//! Batched matrix-vector product
+/*! Computes y(:,i) <- alpha*op(A(:,:,i))*x(:,i) + beta*y(:,i) for every
+ * matrix i in the batch, so the vectors are stored as the columns of x and y.
+ * A may hold a single matrix, which then multiplies every vector of x. If
+ * beta is zero, y need not be initialized.
+ */
+template <typename T, class SA, class SX, class SY>
+void batch_gemv(const Array<3, T, SA> &A, const Array<2, T, SX> &x,
+                Array<2, T, SY> &y, typename Array<2, T, SY>::value_type alpha = 1,
+                typename Array<2, T, SY>::value_type beta = 0, bool transA = false) {
+
+  const size_t m = A.size(0), n = A.size(1), count = x.size(1);
+
+  // check size
+  assert(x.size(0) == (transA ? m : n));
+  assert(y.size(0) == (transA ? n : m) && y.size(1) == count);
+  assert(A.size(2) == count || A.size(2) == 1);
+
+  Batch::gemv(transA, m, n, count, alpha, A.data(), A.size(2) == 1 ? 0 : m * n,
+              x.data(), x.size(0), beta, y.data());
+}
+
+//! Batched matrix-vector product, returns the vectors A(:,:,i)*x(:,i) as the
+// columns of a matrix
+template <typename T, class SA, class SX>
+Array<2, T> batch_multiply(const Array<3, T, SA> &A, const Array<2, T, SX> &x) {
+
+  Array<2, T> y(A.size(0), x.size(1), uninitialized);
+  batch_gemv(A, x, y);
+  return y;
+}
+
+
+__END_ARRAY_NAMESPACE__
+
+#endif /* ARRAY_BATCH_HPP */
@@ -35,8 +35,22 @@ __BEGIN_ARRAY_NAMESPACE__
 
 //! Macro used to set the 'transpose' flag
 #define CblasTrans 'T'
+//! Macro used to set the 'conjugate transpose' flag
+#define CblasConjTrans 'C'
 //! Macro used to set the 'no transpose' flag
 #define CblasNoTrans 'N'
+//! Macro used to select the upper triangle of a symmetric or triangular matrix
+#define CblasUpper 'U'
+//! Macro used to select the lower triangle of a symmetric or triangular matrix
+#define CblasLower 'L'
+//! Macro used to multiply by a symmetric or triangular matrix from the left
+#define CblasLeft 'L'
+//! Macro used to multiply by a symmetric or triangular matrix from the right
+#define CblasRight 'R'
+//! Macro used to set the 'unit diagonal' flag of a triangular matrix
+#define CblasUnit 'U'
+//! Macro used to set the 'non-unit diagonal' flag of a triangular matrix
+#define CblasNonUnit 'N'
 
 extern "C" {
 
@@ -57,13 +71,25 @@ double CPPARRAY_FC_GLOBAL(dnrm2, DNRM2)(int *, double *, int *);
 /*! \brief Level 1 blas used to sum the absolute values of the elements of a
  * vector of single precision type taking into account the Fortran mangling
  */
-double CPPARRAY_FC_GLOBAL(sasum, SASUM)(int *, float *, int *);
+float CPPARRAY_FC_GLOBAL(sasum, SASUM)(int *, float *, int *);
 
 /*! \brief Level 1 blas used to sum the absolute values of the elements of a
  * vector of double precision type taking into account the Fortran mangling
  */
 double CPPARRAY_FC_GLOBAL(dasum, DASUM)(int *, double *, int *);
 
+// level 1 blas IxAMAX
+
+/*! \brief Level 1 blas used to find the element of largest absolute value of
+ * a vector of single precision type taking into account the Fortran mangling
+ */
+int CPPARRAY_FC_GLOBAL(isamax, ISAMAX)(int *, float *, int *);
+
+/*! \brief Level 1 blas used to find the element of largest absolute value of
+ * a vector of double precision type taking into account the Fortran mangling
+ */
+int CPPARRAY_FC_GLOBAL(idamax, IDAMAX)(int *, double *, int *);
+
 // level 1 blas xSCAL function: x <- alpha*x
 
 /*! \brief Level 1 blas used to scale a vector of single precision type taking
@@ -147,6 +173,306 @@ void CPPARRAY_FC_GLOBAL(sgemm, SGEMM)(char *, char *, int *, int *, int *,
 void CPPARRAY_FC_GLOBAL(dgemm, DGEMM)(char *, char *, int *, int *, int *,
                                       double *, double *, int *, double *,
                                       int *, double *, double *, int *);
+
+/*! \brief Level 2 blas function used to multiply a symmetric matrix and a
+ * vector of single precision type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ssymv, SSYMV)(char *, int *, float *, float *, int *,
+                                      float *, int *, float *, float *, int *);
+
+/*! \brief Level 2 blas function used to multiply a symmetric matrix and a
+ * vector of double precision type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(dsymv, DSYMV)(char *, int *, double *, double *, int *,
+                                      double *, int *, double *, double *,
+                                      int *);
+
+/*! \brief Level 3 blas function used to multiply a symmetric matrix and a
+ * general matrix of single precision type taking into account the Fortran
+ * mangling
+ */
+void CPPARRAY_FC_GLOBAL(ssymm, SSYMM)(char *, char *, int *, int *, float *,
+                                      float *, int *, float *, int *, float *,
+                                      float *, int *);
+
+/*! \brief Level 3 blas function used to multiply a symmetric matrix and a
+ * general matrix of double precision type taking into account the Fortran
+ * mangling
+ */
+void CPPARRAY_FC_GLOBAL(dsymm, DSYMM)(char *, char *, int *, int *, double *,
+                                      double *, int *, double *, int *,
+                                      double *, double *, int *);
+
+/*! \brief Level 3 blas function used for the symmetric rank k update of a
+ * matrix of single precision type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ssyrk, SSYRK)(char *, char *, int *, int *, float *,
+                                      float *, int *, float *, float *, int *);
+
+/*! \brief Level 3 blas function used for the symmetric rank k update of a
+ * matrix of double precision type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(dsyrk, DSYRK)(char *, char *, int *, int *, double *,
+                                      double *, int *, double *, double *,
+                                      int *);
+
+/*! \brief Level 2 blas function used to solve a triangular system of single
+ * precision type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(strsv, STRSV)(char *, char *, char *, int *, float *,
+                                      int *, float *, int *);
+
+/*! \brief Level 2 blas function used to solve a triangular system of double
+ * precision type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(dtrsv, DTRSV)(char *, char *, char *, int *, double *,
+                                      int *, double *, int *);
+
+/*! \brief Level 3 blas function used to solve triangular systems of single
+ * precision type with multiple right-hand sides taking into account the
+ * Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(strsm, STRSM)(char *, char *, char *, char *, int *,
+                                      int *, float *, float *, int *, float *,
+                                      int *);
+
+/*! \brief Level 3 blas function used to solve triangular systems of double
+ * precision type with multiple right-hand sides taking into account the
+ * Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(dtrsm, DTRSM)(char *, char *, char *, char *, int *,
+                                      int *, double *, double *, int *,
+                                      double *, int *);
+
+/*! \brief Level 3 blas function used to multiply a triangular matrix and a
+ * general matrix of single precision type taking into account the Fortran
+ * mangling
+ */
+void CPPARRAY_FC_GLOBAL(strmm, STRMM)(char *, char *, char *, char *, int *,
+                                      int *, float *, float *, int *, float *,
+                                      int *);
+
+/*! \brief Level 3 blas function used to multiply a triangular matrix and a
+ * general matrix of double precision type taking into account the Fortran
+ * mangling
+ */
+void CPPARRAY_FC_GLOBAL(dtrmm, DTRMM)(char *, char *, char *, char *, int *,
+                                      int *, double *, double *, int *,
+                                      double *, int *);
+
+// complex variants, the elements of std::complex are laid out as Fortran
+// COMPLEX values. Functions returning a complex value are not used because
+// Fortran compilers do not agree on how to return them.
+
+/*! \brief Level 1 blas used to compute the 2-norm of a vector of single
+ * precision complex type taking into account the Fortran mangling
+ */
+float CPPARRAY_FC_GLOBAL(scnrm2, SCNRM2)(int *, std::complex<float> *, int *);
+
+/*! \brief Level 1 blas used to compute the 2-norm of a vector of double
+ * precision complex type taking into account the Fortran mangling
+ */
+double CPPARRAY_FC_GLOBAL(dznrm2, DZNRM2)(int *, std::complex<double> *, int *);
+
+/*! \brief Level 1 blas used to sum the absolute values of the real and
+ * imaginary parts of a vector of single precision complex type taking into
+ * account the Fortran mangling
+ */
+float CPPARRAY_FC_GLOBAL(scasum, SCASUM)(int *, std::complex<float> *, int *);
+
+/*! \brief Level 1 blas used to sum the absolute values of the real and
+ * imaginary parts of a vector of double precision complex type taking into
+ * account the Fortran mangling
+ */
+double CPPARRAY_FC_GLOBAL(dzasum, DZASUM)(int *, std::complex<double> *, int *);
+
+/*! \brief Level 1 blas used to find the element of largest sum of the absolute
+ * values of its real and imaginary parts of a vector of single precision
+ * complex type taking into account the Fortran mangling
+ */
+int CPPARRAY_FC_GLOBAL(icamax, ICAMAX)(int *, std::complex<float> *, int *);
+
+/*! \brief Level 1 blas used to find the element of largest sum of the absolute
+ * values of its real and imaginary parts of a vector of double precision
+ * complex type taking into account the Fortran mangling
+ */
+int CPPARRAY_FC_GLOBAL(izamax, IZAMAX)(int *, std::complex<double> *, int *);
+
+/*! \brief Level 1 blas used to scale a vector of single precision complex type
+ * taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(cscal, CSCAL)(int *, std::complex<float> *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 1 blas used to scale and add a vector of single precision
+ * complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(caxpy, CAXPY)(int *, std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 2 blas function used to compute the unconjugated outer
+ * product of two vectors of single precision complex type taking into account
+ * the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(cgeru, CGERU)(int *, int *, std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 2 blas function used to multiply a matrix by a vector of
+ * single precision complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(cgemv, CGEMV)(char *, int *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 3 blas function used to multiply two matrices of single
+ * precision complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(cgemm, CGEMM)(char *, char *, int *, int *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 3 blas function used to multiply a symmetric matrix and a
+ * general matrix of single precision complex type taking into account the
+ * Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(csymm, CSYMM)(char *, char *, int *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 3 blas function used for the symmetric rank k update of a
+ * matrix of single precision complex type taking into account the Fortran
+ * mangling
+ */
+void CPPARRAY_FC_GLOBAL(csyrk, CSYRK)(char *, char *, int *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 2 blas function used to solve a triangular system of single
+ * precision complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ctrsv, CTRSV)(char *, char *, char *, int *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 3 blas function used to solve triangular systems of single
+ * precision complex type with multiple right-hand sides taking into account
+ * the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ctrsm, CTRSM)(char *, char *, char *, char *, int *,
+                                      int *, std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 3 blas function used to multiply a triangular matrix and a
+ * general matrix of single precision complex type taking into account the
+ * Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ctrmm, CTRMM)(char *, char *, char *, char *, int *,
+                                      int *, std::complex<float> *,
+                                      std::complex<float> *, int *,
+                                      std::complex<float> *, int *);
+
+/*! \brief Level 1 blas used to scale a vector of double precision complex type
+ * taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(zscal, ZSCAL)(int *, std::complex<double> *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 1 blas used to scale and add a vector of double precision
+ * complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(zaxpy, ZAXPY)(int *, std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 2 blas function used to compute the unconjugated outer
+ * product of two vectors of double precision complex type taking into account
+ * the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(zgeru, ZGERU)(int *, int *, std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 2 blas function used to multiply a matrix by a vector of
+ * double precision complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(zgemv, ZGEMV)(char *, int *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 3 blas function used to multiply two matrices of double
+ * precision complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(zgemm, ZGEMM)(char *, char *, int *, int *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 3 blas function used to multiply a symmetric matrix and a
+ * general matrix of double precision complex type taking into account the
+ * Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(zsymm, ZSYMM)(char *, char *, int *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 3 blas function used for the symmetric rank k update of a
+ * matrix of double precision complex type taking into account the Fortran
+ * mangling
+ */
+void CPPARRAY_FC_GLOBAL(zsyrk, ZSYRK)(char *, char *, int *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 2 blas function used to solve a triangular system of double
+ * precision complex type taking into account the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ztrsv, ZTRSV)(char *, char *, char *, int *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 3 blas function used to solve triangular systems of double
+ * precision complex type with multiple right-hand sides taking into account
+ * the Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ztrsm, ZTRSM)(char *, char *, char *, char *, int *,
+                                      int *, std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *);
+
+/*! \brief Level 3 blas function used to multiply a triangular matrix and a
+ * general matrix of double precision complex type taking into account the
+ * Fortran mangling
+ */
+void CPPARRAY_FC_GLOBAL(ztrmm, ZTRMM)(char *, char *, char *, char *, int *,
+                                      int *, std::complex<double> *,
+                                      std::complex<double> *, int *,
+                                      std::complex<double> *, int *);
 }
 
 // level 1 blas xNRM2
@@ -165,6 +491,30 @@ static double MAY_NOT_BE_USED cblas_Xnrm2(int *N, double *X, int *incX) {
   return CPPARRAY_FC_GLOBAL(dnrm2, DNRM2)(N, X, incX);
 }
 
+/*! \brief Level 1 blas concrete function used to compute the 2-norm of a vector
+ * of single precision complex type
+ */
+static float MAY_NOT_BE_USED
+cblas_Xnrm2(int *N, std::complex<float> *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(scnrm2, SCNRM2)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the 2-norm of a vector
+ * of double precision complex type
+ */
+static double MAY_NOT_BE_USED
+cblas_Xnrm2(int *N, std::complex<double> *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(dznrm2, DZNRM2)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the 2-norm of a vector
+ * of a type without a blas routine, such as integers
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_Xnrm2(int *N, T *X, int *incX) {
+  return Simd::nrm2<T>(*N, X, *incX);
+}
+
 // level 1 blas xNRM2 function: nrm2 <- |x|_2
 /*! \brief Level 1 blas template function used to compute the 2-norm of a vector
  *
@@ -178,7 +528,8 @@ static double MAY_NOT_BE_USED cblas_Xnrm2(int *N, double *X, int *incX) {
  * \param x - A one-dimensional array used to store \f$ x \f$
  * \param incX - Increment step used in vector \f$ x \f$
  */
-template <typename T> static T cblas_nrm2(int N, T *x, int incX) {
+template <typename T>
+static typename Real_type<T>::type cblas_nrm2(int N, T *x, int incX) {
   return cblas_Xnrm2(&N, x, &incX);
 }
 
@@ -198,6 +549,33 @@ static double MAY_NOT_BE_USED cblas_Xasum(int *N, double *X, int *incX) {
   return CPPARRAY_FC_GLOBAL(dasum, DASUM)(N, X, incX);
 }
 
+/*! \brief Level 1 blas concrete function used to compute the sum the absolute
+ * values of the real and imaginary parts of a vector of single precision
+ * complex type
+ */
+static float MAY_NOT_BE_USED
+cblas_Xasum(int *N, std::complex<float> *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(scasum, SCASUM)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the sum the absolute
+ * values of the real and imaginary parts of a vector of double precision
+ * complex type
+ */
+static double MAY_NOT_BE_USED
+cblas_Xasum(int *N, std::complex<double> *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(dzasum, DZASUM)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the sum the absolute
+ * values of the elements of a vector of a type without a blas routine, such as
+ * integers
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_Xasum(int *N, T *X, int *incX) {
+  return Simd::asum<T>(*N, X, *incX);
+}
+
 // level 1 blas xASUM function: asum <- |x|_1
 /*! \brief Level 1 blas template function used to compute the sum the absolute
  * values of the elements of a vector
@@ -212,10 +590,73 @@ static double MAY_NOT_BE_USED cblas_Xasum(int *N, double *X, int *incX) {
  * \param x - A one-dimensional array used to store \f$ x \f$
  * \param incX - Increment step used in vector \f$ x \f$
  */
-template <typename T> static T cblas_asum(int N, T *x, int incX) {
+template <typename T>
+static typename Real_type<T>::type cblas_asum(int N, T *x, int incX) {
   return cblas_Xasum(&N, x, &incX);
 }
 
+// level 1 blas IxAMAX
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * absolute value of a vector of single precision type
+ */
+static int MAY_NOT_BE_USED cblas_iXamax(int *N, float *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(isamax, ISAMAX)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * absolute value of a vector of double precision type
+ */
+static int MAY_NOT_BE_USED cblas_iXamax(int *N, double *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(idamax, IDAMAX)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * sum of the absolute values of its real and imaginary parts of a vector of
+ * single precision complex type
+ */
+static int MAY_NOT_BE_USED
+cblas_iXamax(int *N, std::complex<float> *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(icamax, ICAMAX)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * sum of the absolute values of its real and imaginary parts of a vector of
+ * double precision complex type
+ */
+static int MAY_NOT_BE_USED
+cblas_iXamax(int *N, std::complex<double> *X, int *incX) {
+  return CPPARRAY_FC_GLOBAL(izamax, IZAMAX)(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * absolute value of a vector of a type without a blas routine, such as
+ * integers
+ */
+template <typename T>
+static int MAY_NOT_BE_USED cblas_iXamax(int *N, T *X, int *incX) {
+  return *N > 0 ? Simd::iamax<T>(*N, X, *incX) + 1 : 0;
+}
+
+// level 1 blas IxAMAX function: i <- argmax |x_i|
+/*! \brief Level 1 blas template function used to find the element of largest
+ * absolute value of a vector
+ *
+ * The funciton is a function template, and the implementation calls the
+ * function \c cblas_iXamax for the correct type. Unlike the Fortran routine,
+ * the index returned starts at zero, and it is zero for an empty vector.
+ *
+ * \tparam T - Template parameter that defines the type of elements in the
+ * vector
+ * \param N - The size of vector \f$ x \f$
+ * \param x - A one-dimensional array used to store \f$ x \f$
+ * \param incX - Increment step used in vector \f$ x \f$
+ */
+template <typename T> static size_t cblas_iamax(int N, T *x, int incX) {
+  const int i = cblas_iXamax(&N, x, &incX);
+  return i > 0 ? i - 1 : 0;
+}
+
 // level 1 blas xSCAL function: x <- alpha*x
 
 /*! \brief Level 1 blas concrete function used to scale a vector of single
@@ -234,6 +675,32 @@ cblas_Xscal(int *N, double *alpha, double *X, int *incX) {
   CPPARRAY_FC_GLOBAL(dscal, DSCAL)(N, alpha, X, incX);
 }
 
+/*! \brief Level 1 blas concrete function used to scale a vector of single
+ * precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_Xscal(int *N, std::complex<float> *alpha, std::complex<float> *X,
+            int *incX) {
+  CPPARRAY_FC_GLOBAL(cscal, CSCAL)(N, alpha, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to scale a vector of double
+ * precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_Xscal(int *N, std::complex<double> *alpha, std::complex<double> *X,
+            int *incX) {
+  CPPARRAY_FC_GLOBAL(zscal, ZSCAL)(N, alpha, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to scale a vector of a type
+ * without a blas routine, such as integers
+ */
+template <typename T>
+static void MAY_NOT_BE_USED cblas_Xscal(int *N, T *alpha, T *X, int *incX) {
+  Simd::scal<T>(*N, *alpha, X, *incX);
+}
+
 // level 1 blas xSCAL function: x <- alpha*x
 /*! \brief Level 1 blas template function used to scale a vector
  *
@@ -270,6 +737,33 @@ cblas_xaxpy(int *N, double *alpha, double *X, int *incX, double *Y, int *incY) {
   CPPARRAY_FC_GLOBAL(daxpy, DAXPY)(N, alpha, X, incX, Y, incY);
 }
 
+/*! \brief Level 1 blas concrete function used to scale and add a vector of
+ * single precision complex type
+ */
+static void MAY_NOT_BE_USED cblas_xaxpy(int *N, std::complex<float> *alpha,
+                                        std::complex<float> *X, int *incX,
+                                        std::complex<float> *Y, int *incY) {
+  CPPARRAY_FC_GLOBAL(caxpy, CAXPY)(N, alpha, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to scale and add a vector of
+ * double precision complex type
+ */
+static void MAY_NOT_BE_USED cblas_xaxpy(int *N, std::complex<double> *alpha,
+                                        std::complex<double> *X, int *incX,
+                                        std::complex<double> *Y, int *incY) {
+  CPPARRAY_FC_GLOBAL(zaxpy, ZAXPY)(N, alpha, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to scale and add a vector of a
+ * type without a blas routine, such as integers
+ */
+template <typename T>
+static void MAY_NOT_BE_USED cblas_xaxpy(int *N, T *alpha, T *X, int *incX, T *Y,
+                                        int *incY) {
+  Simd::axpy<T>(*N, *alpha, X, *incX, Y, *incY);
+}
+
 // level 1 blas xAXPY function: Y <- alpha*x + y
 
 /*! \brief Level 1 blas template function used to scale and add a vector
@@ -311,6 +805,120 @@ cblas_xdot(int *N, double *X, int *incX, double *Y, int *incY) {
   return CPPARRAY_FC_GLOBAL(ddot, DDOT)(N, X, incX, Y, incY);
 }
 
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of single precision type, for which no conjugation is
+ * needed
+ */
+static float MAY_NOT_BE_USED
+cblas_xdotc(int *N, float *X, int *incX, float *Y, int *incY) {
+  return CPPARRAY_FC_GLOBAL(sdot, SDOT)(N, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of double precision type, for which no conjugation is
+ * needed
+ */
+static double MAY_NOT_BE_USED
+cblas_xdotc(int *N, double *X, int *incX, double *Y, int *incY) {
+  return CPPARRAY_FC_GLOBAL(ddot, DDOT)(N, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the unconjugated
+ * dot product between two vectors of single precision complex type
+ *
+ * The product is evaluated by xGEMV, with \f$ x \f$ taken as a matrix with a
+ * single row and leading dimension incX.
+ */
+static std::complex<float> MAY_NOT_BE_USED
+cblas_xdot(int *N, std::complex<float> *X, int *incX, std::complex<float> *Y,
+           int *incY) {
+  char t = CblasNoTrans;
+  int one = 1;
+  std::complex<float> alpha(1), beta(0), r(0);
+  CPPARRAY_FC_GLOBAL(cgemv, CGEMV)(&t, &one, N, &alpha, X, incX, Y, incY,
+                                   &beta, &r, &one);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the conjugated dot
+ * product between two vectors of single precision complex type
+ *
+ * The product is evaluated by xGEMV, with \f$ x \f$ taken as a matrix with a
+ * single column, which requires a unit increment in \f$ x \f$.
+ */
+static std::complex<float> MAY_NOT_BE_USED
+cblas_xdotc(int *N, std::complex<float> *X, int *incX, std::complex<float> *Y,
+            int *incY) {
+  std::complex<float> r(0);
+  if (*incX != 1) {
+    for (int i = 0; i < *N; ++i)
+      r += std::conj(X[i * *incX]) * Y[i * *incY];
+    return r;
+  }
+  char t = CblasConjTrans;
+  int one = 1;
+  std::complex<float> alpha(1), beta(0);
+  CPPARRAY_FC_GLOBAL(cgemv, CGEMV)(&t, N, &one, &alpha, X, N, Y, incY, &beta,
+                                   &r, &one);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the unconjugated
+ * dot product between two vectors of double precision complex type
+ *
+ * The product is evaluated by xGEMV, with \f$ x \f$ taken as a matrix with a
+ * single row and leading dimension incX.
+ */
+static std::complex<double> MAY_NOT_BE_USED
+cblas_xdot(int *N, std::complex<double> *X, int *incX, std::complex<double> *Y,
+           int *incY) {
+  char t = CblasNoTrans;
+  int one = 1;
+  std::complex<double> alpha(1), beta(0), r(0);
+  CPPARRAY_FC_GLOBAL(zgemv, ZGEMV)(&t, &one, N, &alpha, X, incX, Y, incY,
+                                   &beta, &r, &one);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the conjugated dot
+ * product between two vectors of double precision complex type
+ *
+ * The product is evaluated by xGEMV, with \f$ x \f$ taken as a matrix with a
+ * single column, which requires a unit increment in \f$ x \f$.
+ */
+static std::complex<double> MAY_NOT_BE_USED
+cblas_xdotc(int *N, std::complex<double> *X, int *incX, std::complex<double> *Y,
+            int *incY) {
+  std::complex<double> r(0);
+  if (*incX != 1) {
+    for (int i = 0; i < *N; ++i)
+      r += std::conj(X[i * *incX]) * Y[i * *incY];
+    return r;
+  }
+  char t = CblasConjTrans;
+  int one = 1;
+  std::complex<double> alpha(1), beta(0);
+  CPPARRAY_FC_GLOBAL(zgemv, ZGEMV)(&t, N, &one, &alpha, X, N, Y, incY, &beta,
+                                   &r, &one);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of a type without a blas routine, such as integers
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_xdot(int *N, T *X, int *incX, T *Y, int *incY) {
+  return Simd::dot<T>(*N, X, *incX, Y, *incY);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of a type without a blas routine, such as integers
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_xdotc(int *N, T *X, int *incX, T *Y, int *incY) {
+  return Simd::dot<T>(*N, X, *incX, Y, *incY);
+}
+
 /*! \brief Level 1 blas template function used to compute the dot product
  *between two vectors
  *
@@ -327,10 +935,21 @@ cblas_xdot(int *N, double *X, int *incX, double *Y, int *incY) {
  * \param incY - Increment step used in array \f$ y \f$
  */
 template <typename T>
-static double MAY_NOT_BE_USED cblas_dot(int N, T *x, int incX, T *y, int incY) {
+static T MAY_NOT_BE_USED cblas_dot(int N, T *x, int incX, T *y, int incY) {
   return cblas_xdot(&N, x, &incX, y, &incY);
 }
 
+/*! \brief Level 1 blas template function used to compute the conjugated dot
+ * product between two vectors
+ *
+ * This funciton is used to evaluate \f$ r \leftarrow x^H  y  \f$, which is
+ * the dot product for real vectors.
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_dotc(int N, T *x, int incX, T *y, int incY) {
+  return cblas_xdotc(&N, x, &incX, y, &incY);
+}
+
 // level 2 blas xGER function: A <- alpha*x*y' + A
 
 /*! \brief Level 2 blas concrete function used to compute the outer product of
@@ -351,6 +970,28 @@ static void MAY_NOT_BE_USED cblas_xger(int *M, int *N, double *alpha, double *X,
   CPPARRAY_FC_GLOBAL(dger, DGER)(M, N, alpha, X, incX, Y, incY, A, lda);
 }
 
+/*! \brief Level 2 blas concrete function used to compute the unconjugated
+ * outer product of two vectors of single precision complex type
+ */
+static void MAY_NOT_BE_USED cblas_xger(int *M, int *N,
+                                       std::complex<float> *alpha,
+                                       std::complex<float> *X, int *incX,
+                                       std::complex<float> *Y, int *incY,
+                                       std::complex<float> *A, int *lda) {
+  CPPARRAY_FC_GLOBAL(cgeru, CGERU)(M, N, alpha, X, incX, Y, incY, A, lda);
+}
+
+/*! \brief Level 2 blas concrete function used to compute the unconjugated
+ * outer product of two vectors of double precision complex type
+ */
+static void MAY_NOT_BE_USED cblas_xger(int *M, int *N,
+                                       std::complex<double> *alpha,
+                                       std::complex<double> *X, int *incX,
+                                       std::complex<double> *Y, int *incY,
+                                       std::complex<double> *A, int *lda) {
+  CPPARRAY_FC_GLOBAL(zgeru, ZGERU)(M, N, alpha, X, incX, Y, incY, A, lda);
+}
+
 // level 2 blas xGER function: Y <- alpha*A*x + beta*y
 /*! \brief Level 2 blas template function used to compute the outer product of
  * two vectors
@@ -401,6 +1042,29 @@ cblas_xgemv(char *TransA, int *M, int *N, double *alpha, double *A, int *lda,
                                    Y, incY);
 }
 
+/*! \brief Level 2 blas concrete function used to multiply a matrix by a
+ * vector of single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemv(char *TransA, int *M, int *N, std::complex<float> *alpha,
+            std::complex<float> *A, int *lda, std::complex<float> *X, int *incX,
+            std::complex<float> *beta, std::complex<float> *Y, int *incY) {
+  CPPARRAY_FC_GLOBAL(cgemv, CGEMV)(TransA, M, N, alpha, A, lda, X, incX, beta,
+                                   Y, incY);
+}
+
+/*! \brief Level 2 blas concrete function used to multiply a matrix by a
+ * vector of double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemv(char *TransA, int *M, int *N, std::complex<double> *alpha,
+            std::complex<double> *A, int *lda, std::complex<double> *X,
+            int *incX, std::complex<double> *beta, std::complex<double> *Y,
+            int *incY) {
+  CPPARRAY_FC_GLOBAL(zgemv, ZGEMV)(TransA, M, N, alpha, A, lda, X, incX, beta,
+                                   Y, incY);
+}
+
 // level 2 blas xGEMV function: Y <- alpha*A*x + beta*y
 /*! \brief Level 2 blas template function used to multiply a matrix by a vector
  *
@@ -429,6 +1093,7 @@ template <typename T>
 static void MAY_NOT_BE_USED
 cblas_gemv(char TransA, int M, int N, T alpha, T *A, int lda, T *x, int incX,
            T beta, T *y, int incY) {
+  Blas_threads::Product threads(size_t(M) * N);
   cblas_xgemv(&TransA, &M, &N, &alpha, A, &lda, x, &incX, &beta, y, &incY);
 }
 
@@ -454,6 +1119,30 @@ cblas_xgemm(char *TransA, char *TransB, int *M, int *N, int *K, double *alpha,
                                    ldb, beta, C, ldc);
 }
 
+/*! \brief Level 3 blas concrete function used to multiply two matrices of
+ * single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemm(char *TransA, char *TransB, int *M, int *N, int *K,
+            std::complex<float> *alpha, std::complex<float> *A, int *lda,
+            std::complex<float> *B, int *ldb, std::complex<float> *beta,
+            std::complex<float> *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(cgemm, CGEMM)(TransA, TransB, M, N, K, alpha, A, lda, B,
+                                   ldb, beta, C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply two matrices of
+ * double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemm(char *TransA, char *TransB, int *M, int *N, int *K,
+            std::complex<double> *alpha, std::complex<double> *A, int *lda,
+            std::complex<double> *B, int *ldb, std::complex<double> *beta,
+            std::complex<double> *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(zgemm, ZGEMM)(TransA, TransB, M, N, K, alpha, A, lda, B,
+                                   ldb, beta, C, ldc);
+}
+
 // level 3 blas xGEMM function: C <- alpha*op(A)*op(B) = beta*C, op(X) = X, X'
 /*! \brief Level 3 blas template function used to multiply two matrices
  *
@@ -489,10 +1178,303 @@ template <class T>
 static void MAY_NOT_BE_USED
 cblas_gemm(char TransA, char TransB, int M, int N, int K, T alpha, T *A,
            int lda, T *B, int ldb, T beta, T *C, int ldc) {
+  Blas_threads::Product threads(size_t(M) * N * K);
   cblas_xgemm(&TransA, &TransB, &M, &N, &K, &alpha, A, &lda, B, &ldb, &beta, C,
               &ldc);
 }
 
+// level 2 blas xSYMV function: y <- alpha*A*x + beta*y, A symmetric
+
+static void MAY_NOT_BE_USED cblas_xsymv(char *Uplo, int *N, float *alpha,
+                                        float *A, int *lda, float *X, int *incX,
+                                        float *beta, float *Y, int *incY) {
+  CPPARRAY_FC_GLOBAL(ssymv, SSYMV)(Uplo, N, alpha, A, lda, X, incX, beta, Y,
+                                   incY);
+}
+
+static void MAY_NOT_BE_USED cblas_xsymv(char *Uplo, int *N, double *alpha,
+                                        double *A, int *lda, double *X,
+                                        int *incX, double *beta, double *Y,
+                                        int *incY) {
+  CPPARRAY_FC_GLOBAL(dsymv, DSYMV)(Uplo, N, alpha, A, lda, X, incX, beta, Y,
+                                   incY);
+}
+
+// blas has no complex symmetric matrix-vector product, so the vector is
+// passed to xSYMM as a matrix with a single column
+static void MAY_NOT_BE_USED cblas_xsymv(char *Uplo, int *N,
+                                        std::complex<float> *alpha,
+                                        std::complex<float> *A, int *lda,
+                                        std::complex<float> *X, int *incX,
+                                        std::complex<float> *beta,
+                                        std::complex<float> *Y, int *incY) {
+  assert(*incX == 1 && *incY == 1);
+  char side = CblasLeft;
+  int one = 1;
+  CPPARRAY_FC_GLOBAL(csymm, CSYMM)(&side, Uplo, N, &one, alpha, A, lda, X, N,
+                                   beta, Y, N);
+}
+
+// blas has no complex symmetric matrix-vector product, so the vector is
+// passed to xSYMM as a matrix with a single column
+static void MAY_NOT_BE_USED cblas_xsymv(char *Uplo, int *N,
+                                        std::complex<double> *alpha,
+                                        std::complex<double> *A, int *lda,
+                                        std::complex<double> *X, int *incX,
+                                        std::complex<double> *beta,
+                                        std::complex<double> *Y, int *incY) {
+  assert(*incX == 1 && *incY == 1);
+  char side = CblasLeft;
+  int one = 1;
+  CPPARRAY_FC_GLOBAL(zsymm, ZSYMM)(&side, Uplo, N, &one, alpha, A, lda, X, N,
+                                   beta, Y, N);
+}
+
+/*! \brief Level 2 blas template function used to multiply a symmetric matrix
+ * and a vector, \f$ y \leftarrow \alpha A x + \beta y \f$, where only the
+ * triangle of \f$ A \f$ given by Uplo is referenced
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_symv(char Uplo, int N, T alpha, T *A, int lda, T *X, int incX, T beta,
+           T *Y, int incY) {
+  cblas_xsymv(&Uplo, &N, &alpha, A, &lda, X, &incX, &beta, Y, &incY);
+}
+
+// level 3 blas xSYMM function: C <- alpha*A*B + beta*C or alpha*B*A + beta*C,
+// A symmetric
+
+static void MAY_NOT_BE_USED cblas_xsymm(char *Side, char *Uplo, int *M, int *N,
+                                        float *alpha, float *A, int *lda,
+                                        float *B, int *ldb, float *beta,
+                                        float *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(ssymm, SSYMM)(Side, Uplo, M, N, alpha, A, lda, B, ldb, beta,
+                                   C, ldc);
+}
+
+static void MAY_NOT_BE_USED cblas_xsymm(char *Side, char *Uplo, int *M, int *N,
+                                        double *alpha, double *A, int *lda,
+                                        double *B, int *ldb, double *beta,
+                                        double *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(dsymm, DSYMM)(Side, Uplo, M, N, alpha, A, lda, B, ldb, beta,
+                                   C, ldc);
+}
+
+static void MAY_NOT_BE_USED cblas_xsymm(char *Side, char *Uplo, int *M, int *N,
+                                        std::complex<float> *alpha,
+                                        std::complex<float> *A, int *lda,
+                                        std::complex<float> *B, int *ldb,
+                                        std::complex<float> *beta,
+                                        std::complex<float> *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(csymm, CSYMM)(Side, Uplo, M, N, alpha, A, lda, B, ldb,
+                                   beta, C, ldc);
+}
+
+static void MAY_NOT_BE_USED cblas_xsymm(char *Side, char *Uplo, int *M, int *N,
+                                        std::complex<double> *alpha,
+                                        std::complex<double> *A, int *lda,
+                                        std::complex<double> *B, int *ldb,
+                                        std::complex<double> *beta,
+                                        std::complex<double> *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(zsymm, ZSYMM)(Side, Uplo, M, N, alpha, A, lda, B, ldb,
+                                   beta, C, ldc);
+}
+
+/*! \brief Level 3 blas template function used to multiply a symmetric matrix
+ * and a general matrix, \f$ C \leftarrow \alpha A B + \beta C \f$ if Side is
+ * CblasLeft or \f$ C \leftarrow \alpha B A + \beta C \f$ if Side is CblasRight
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_symm(char Side, char Uplo, int M, int N, T alpha, T *A, int lda, T *B,
+           int ldb, T beta, T *C, int ldc) {
+  Blas_threads::Product threads(size_t(M) * N * (Side == CblasLeft ? M : N));
+  cblas_xsymm(&Side, &Uplo, &M, &N, &alpha, A, &lda, B, &ldb, &beta, C, &ldc);
+}
+
+// level 3 blas xSYRK function: C <- alpha*A*A' + beta*C or alpha*A'*A + beta*C
+
+static void MAY_NOT_BE_USED cblas_xsyrk(char *Uplo, char *Trans, int *N, int *K,
+                                        float *alpha, float *A, int *lda,
+                                        float *beta, float *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(ssyrk, SSYRK)(Uplo, Trans, N, K, alpha, A, lda, beta, C,
+                                   ldc);
+}
+
+static void MAY_NOT_BE_USED cblas_xsyrk(char *Uplo, char *Trans, int *N, int *K,
+                                        double *alpha, double *A, int *lda,
+                                        double *beta, double *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(dsyrk, DSYRK)(Uplo, Trans, N, K, alpha, A, lda, beta, C,
+                                   ldc);
+}
+
+static void MAY_NOT_BE_USED cblas_xsyrk(char *Uplo, char *Trans, int *N, int *K,
+                                        std::complex<float> *alpha,
+                                        std::complex<float> *A, int *lda,
+                                        std::complex<float> *beta,
+                                        std::complex<float> *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(csyrk, CSYRK)(Uplo, Trans, N, K, alpha, A, lda, beta, C,
+                                   ldc);
+}
+
+static void MAY_NOT_BE_USED cblas_xsyrk(char *Uplo, char *Trans, int *N, int *K,
+                                        std::complex<double> *alpha,
+                                        std::complex<double> *A, int *lda,
+                                        std::complex<double> *beta,
+                                        std::complex<double> *C, int *ldc) {
+  CPPARRAY_FC_GLOBAL(zsyrk, ZSYRK)(Uplo, Trans, N, K, alpha, A, lda, beta, C,
+                                   ldc);
+}
+
+/*! \brief Level 3 blas template function used for the symmetric rank k update
+ * \f$ C \leftarrow \alpha A A^\top + \beta C \f$ (Trans is CblasNoTrans) or
+ * \f$ C \leftarrow \alpha A^\top A + \beta C \f$ (Trans is CblasTrans), where
+ * only the triangle of \f$ C \f$ given by Uplo is computed
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_syrk(char Uplo, char Trans, int N, int K, T alpha, T *A, int lda, T beta,
+           T *C, int ldc) {
+  Blas_threads::Product threads(size_t(N) * N * K);
+  cblas_xsyrk(&Uplo, &Trans, &N, &K, &alpha, A, &lda, &beta, C, &ldc);
+}
+
+// level 2 blas xTRSV function: x <- op(A)^-1*x, A triangular
+
+static void MAY_NOT_BE_USED cblas_xtrsv(char *Uplo, char *TransA, char *Diag,
+                                        int *N, float *A, int *lda, float *X,
+                                        int *incX) {
+  CPPARRAY_FC_GLOBAL(strsv, STRSV)(Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrsv(char *Uplo, char *TransA, char *Diag,
+                                        int *N, double *A, int *lda, double *X,
+                                        int *incX) {
+  CPPARRAY_FC_GLOBAL(dtrsv, DTRSV)(Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrsv(char *Uplo, char *TransA, char *Diag,
+                                        int *N, std::complex<float> *A,
+                                        int *lda, std::complex<float> *X,
+                                        int *incX) {
+  CPPARRAY_FC_GLOBAL(ctrsv, CTRSV)(Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrsv(char *Uplo, char *TransA, char *Diag,
+                                        int *N, std::complex<double> *A,
+                                        int *lda, std::complex<double> *X,
+                                        int *incX) {
+  CPPARRAY_FC_GLOBAL(ztrsv, ZTRSV)(Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+/*! \brief Level 2 blas template function used to solve a triangular system,
+ * \f$ x \leftarrow \text{op}(A)^{-1} x \f$
+ */
+template <class T>
+static void MAY_NOT_BE_USED cblas_trsv(char Uplo, char TransA, char Diag, int N,
+                                       T *A, int lda, T *X, int incX) {
+  cblas_xtrsv(&Uplo, &TransA, &Diag, &N, A, &lda, X, &incX);
+}
+
+// level 3 blas xTRSM function: B <- alpha*op(A)^-1*B or alpha*B*op(A)^-1,
+// A triangular
+
+static void MAY_NOT_BE_USED cblas_xtrsm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        float *alpha, float *A, int *lda,
+                                        float *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(strsm, STRSM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrsm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        double *alpha, double *A, int *lda,
+                                        double *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(dtrsm, DTRSM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrsm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        std::complex<float> *alpha,
+                                        std::complex<float> *A, int *lda,
+                                        std::complex<float> *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(ctrsm, CTRSM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrsm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        std::complex<double> *alpha,
+                                        std::complex<double> *A, int *lda,
+                                        std::complex<double> *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(ztrsm, ZTRSM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+/*! \brief Level 3 blas template function used to solve triangular systems
+ * with multiple right-hand sides, \f$ B \leftarrow \alpha \text{op}(A)^{-1} B
+ * \f$ (Side is CblasLeft) or \f$ B \leftarrow \alpha B \text{op}(A)^{-1} \f$
+ * (Side is CblasRight)
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_trsm(char Side, char Uplo, char TransA, char Diag, int M, int N, T alpha,
+           T *A, int lda, T *B, int ldb) {
+  Blas_threads::Product threads(size_t(M) * N * (Side == CblasLeft ? M : N));
+  cblas_xtrsm(&Side, &Uplo, &TransA, &Diag, &M, &N, &alpha, A, &lda, B, &ldb);
+}
+
+// level 3 blas xTRMM function: B <- alpha*op(A)*B or alpha*B*op(A),
+// A triangular
+
+static void MAY_NOT_BE_USED cblas_xtrmm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        float *alpha, float *A, int *lda,
+                                        float *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(strmm, STRMM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrmm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        double *alpha, double *A, int *lda,
+                                        double *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(dtrmm, DTRMM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrmm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        std::complex<float> *alpha,
+                                        std::complex<float> *A, int *lda,
+                                        std::complex<float> *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(ctrmm, CTRMM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+static void MAY_NOT_BE_USED cblas_xtrmm(char *Side, char *Uplo, char *TransA,
+                                        char *Diag, int *M, int *N,
+                                        std::complex<double> *alpha,
+                                        std::complex<double> *A, int *lda,
+                                        std::complex<double> *B, int *ldb) {
+  CPPARRAY_FC_GLOBAL(ztrmm, ZTRMM)(Side, Uplo, TransA, Diag, M, N, alpha, A,
+                                   lda, B, ldb);
+}
+
+/*! \brief Level 3 blas template function used to multiply a triangular matrix
+ * and a general matrix, \f$ B \leftarrow \alpha \text{op}(A) B \f$ (Side is
+ * CblasLeft) or \f$ B \leftarrow \alpha B \text{op}(A) \f$ (Side is CblasRight)
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_trmm(char Side, char Uplo, char TransA, char Diag, int M, int N, T alpha,
+           T *A, int lda, T *B, int ldb) {
+  Blas_threads::Product threads(size_t(M) * N * (Side == CblasLeft ? M : N));
+  cblas_xtrmm(&Side, &Uplo, &TransA, &Diag, &M, &N, &alpha, A, &lda, B, &ldb);
+}
+
 __END_ARRAY_NAMESPACE__
 
 #endif /* BLAS_IMPL_HPP */
@@ -33,6 +33,12 @@
 #define MAY_NOT_BE_USED
 #endif
 
+// kernels used for types without a blas implementation
+#include "simd.hpp"
+
+// control of the threads of the blas library
+#include "blas_threads.hpp"
+
 // include appropriate blas implementation file
 #ifdef HAVE_CUBLAS_H
 #include "cublas_impl.hpp"
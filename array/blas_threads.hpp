@@ -0,0 +1,278 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file blas_threads.hpp
+ *
+ * \brief This file contains the control of the number of threads used by the
+ * BLAS library, so that they do not compete with the threads of the library.
+ */
+
+#ifndef ARRAY_BLAS_THREADS_HPP
+#define ARRAY_BLAS_THREADS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "array-config.hpp"
+#include "parallel.hpp"
+
+#if defined(HAVE_MKL_SET_NUM_THREADS_LOCAL)
+extern "C" {
+int mkl_set_num_threads_local(int);
+int mkl_get_max_threads(void);
+}
+#elif defined(HAVE_OPENBLAS_SET_NUM_THREADS)
+extern "C" {
+void openblas_set_num_threads(int);
+int openblas_get_num_threads(void);
+}
+#endif
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! Number of threads used by the BLAS library
+/*! Every level 3 product, and every level 2 product on a matrix, is given a
+ * number of BLAS threads from its size:
+ * - products called from a parallel loop of the library run on one thread,
+ *   since the loop already keeps all the cores busy;
+ * - other products get one thread per work_per_thread multiply-adds, up to
+ *   max(). Small products therefore run on one thread, and large ones use
+ *   all of them.
+ *
+ * A Scope object fixes the number of threads used by the products called on
+ * the current thread instead, and a Limit object caps it, which is used to
+ * share the threads among products that run concurrently. The number of
+ * threads is set through mkl_set_num_threads_local for MKL, which only
+ * affects the calling thread, for the duration of each product.
+ *
+ * OpenBLAS only has openblas_set_num_threads, which affects the whole process,
+ * so setting it per product would race with the products of other threads.
+ * It is only changed when the parallel regions of the library start and end
+ * instead: the first region to start sets one thread and the last one to end
+ * restores max(). Other products use max() threads, and Scope and Limit have
+ * no effect.
+ *
+ * The BLAS libraries found at configure time are checked for these functions.
+ * Nothing is changed with other libraries.
+ */
+class Blas_threads {
+
+public:
+  //! Number of multiply-adds of a product per BLAS thread
+  static constexpr size_t work_per_thread = 1 << 20;
+
+  //! Whether the number of threads of the BLAS library can be set
+  static constexpr bool controllable() {
+#if defined(HAVE_MKL_SET_NUM_THREADS_LOCAL) ||                                 \
+    defined(HAVE_OPENBLAS_SET_NUM_THREADS)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  //! Whether the number of threads of the BLAS library can be set for the
+  // calling thread only, rather than for the whole process
+  static constexpr bool local() {
+#if defined(HAVE_MKL_SET_NUM_THREADS_LOCAL)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  //! Largest number of threads given to a product, by default the number of
+  // threads of the BLAS library when first used
+  static int max() { return max_threads(); }
+
+  //! Sets the largest number of threads given to a product, and the number of
+  // threads of the BLAS library if it is set for the whole process and no
+  // parallel region is running
+  static void set_max(int n) {
+    max();
+    std::lock_guard<std::mutex> lock(region_mutex());
+    max_threads() = std::max(n, 1);
+#if !defined(HAVE_MKL_SET_NUM_THREADS_LOCAL) &&                                \
+    defined(HAVE_OPENBLAS_SET_NUM_THREADS)
+    if (regions() == 0)
+      openblas_set_num_threads(max());
+#endif
+  }
+
+  //! Counts the parallel regions of the library running in the process, see
+  // Parallel_region. With a process-wide setting, the first region to start
+  // sets one BLAS thread and the last one to end restores max().
+  static void parallel_region(bool start) {
+#if !defined(HAVE_MKL_SET_NUM_THREADS_LOCAL) &&                                \
+    defined(HAVE_OPENBLAS_SET_NUM_THREADS)
+    max();
+    std::lock_guard<std::mutex> lock(region_mutex());
+    if (start ? regions()++ == 0 : --regions() == 0)
+      openblas_set_num_threads(start ? 1 : max());
+#else
+    (void)start;
+#endif
+  }
+
+  //! Number of threads given to a product of work multiply-adds called on
+  // the current thread
+  static int threads(size_t work) {
+    if (requested() > 0)
+      return requested();
+    if (in_parallel())
+      return 1;
+    const size_t n = work / work_per_thread;
+    return n < size_t(available()) ? std::max<int>(n, 1) : available();
+  }
+
+  //! Largest number of threads given to a product called on the current
+  // thread
+  static int available() {
+    if (requested() > 0)
+      return requested();
+    return limited() > 0 ? std::min(limited(), max()) : max();
+  }
+
+  //! Fixes the number of threads of the products called on the current
+  // thread during the lifetime of the object
+  class Scope {
+
+  public:
+    explicit Scope(int n) : previous_(requested()) {
+      requested() = std::max(n, 1);
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    ~Scope() { requested() = previous_; }
+
+  private:
+    int previous_;
+  };
+
+  //! Caps the number of threads of the products called on the current thread
+  // during the lifetime of the object, only honoured if local()
+  class Limit {
+
+  public:
+    explicit Limit(int n) : previous_(limited()) {
+      limited() = std::max(n, 1);
+    }
+
+    Limit(const Limit &) = delete;
+    Limit &operator=(const Limit &) = delete;
+
+    ~Limit() { limited() = previous_; }
+
+  private:
+    int previous_;
+  };
+
+  //! Sets the number of threads of the BLAS library for a product of work
+  // multiply-adds during the lifetime of the object, used by the wrappers of
+  // the BLAS routines. Only done if the setting is local to the thread.
+  class Product {
+
+  public:
+    explicit Product(size_t work) : previous_(), changed_() {
+      if (local()) {
+        previous_ = set(threads(work));
+        changed_ = true;
+      }
+    }
+
+    Product(const Product &) = delete;
+    Product &operator=(const Product &) = delete;
+
+    ~Product() {
+      if (changed_)
+        set(previous_);
+    }
+
+  private:
+    int previous_;
+    bool changed_;
+  };
+
+private:
+  //! Number of threads fixed by a Scope on the current thread, 0 if none
+  static int &requested() {
+    static thread_local int n = 0;
+    return n;
+  }
+
+  //! Cap set by a Limit on the current thread, 0 if none
+  static int &limited() {
+    static thread_local int n = 0;
+    return n;
+  }
+
+  //! Number of parallel regions running in the process
+  static int &regions() {
+    static int n = 0;
+    return n;
+  }
+
+  //! Serializes the changes of the process-wide number of BLAS threads
+  static std::mutex &region_mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  static std::atomic<int> &max_threads() {
+    static std::atomic<int> n(initial());
+    return n;
+  }
+
+  //! Number of threads of the BLAS library before any change
+  static int initial() {
+#if defined(HAVE_MKL_SET_NUM_THREADS_LOCAL)
+    return mkl_get_max_threads();
+#elif defined(HAVE_OPENBLAS_SET_NUM_THREADS)
+    return openblas_get_num_threads();
+#else
+    return int(hardware_threads());
+#endif
+  }
+
+  //! Sets the number of threads of the BLAS library for the calling thread,
+  // returns the previous setting to be passed back to restore it
+  static int set(int n) {
+#if defined(HAVE_MKL_SET_NUM_THREADS_LOCAL)
+    // 0 restores the global setting
+    return mkl_set_num_threads_local(n);
+#else
+    return n;
+#endif
+  }
+};
+
+inline void blas_parallel_region(bool start) {
+  Blas_threads::parallel_region(start);
+}
+
+
+__END_ARRAY_NAMESPACE__
+
+#endif /* ARRAY_BLAS_THREADS_HPP */
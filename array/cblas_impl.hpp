@@ -47,8 +47,25 @@ cblas_Xnrm2(const int N, const double *X, const int incX) {
   return cblas_dnrm2(N, X, incX);
 }
 
+static float MAY_NOT_BE_USED
+cblas_Xnrm2(const int N, const std::complex<float> *X, const int incX) {
+  return cblas_scnrm2(N, X, incX);
+}
+
+static double MAY_NOT_BE_USED
+cblas_Xnrm2(const int N, const std::complex<double> *X, const int incX) {
+  return cblas_dznrm2(N, X, incX);
+}
+
+// types without a blas routine, such as integers
 template <typename T>
-static T cblas_nrm2(const int N, const T *X, const int incX) {
+static T MAY_NOT_BE_USED cblas_Xnrm2(const int N, const T *X, const int incX) {
+  return Simd::nrm2<T>(N, X, incX);
+}
+
+template <typename T>
+static typename Real_type<T>::type cblas_nrm2(const int N, const T *X,
+                                              const int incX) {
   return cblas_Xnrm2(N, X, incX);
 }
 
@@ -70,6 +87,33 @@ cblas_Xasum(const int N, const double *X, const int incX) {
   return cblas_dasum(N, X, incX);
 }
 
+/*! \brief Level 1 blas concrete function used to compute the sum the absolute
+ * values of the real and imaginary parts of a vector of single precision
+ * complex type
+ */
+static float MAY_NOT_BE_USED
+cblas_Xasum(const int N, const std::complex<float> *X, const int incX) {
+  return cblas_scasum(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the sum the absolute
+ * values of the real and imaginary parts of a vector of double precision
+ * complex type
+ */
+static double MAY_NOT_BE_USED
+cblas_Xasum(const int N, const std::complex<double> *X, const int incX) {
+  return cblas_dzasum(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the sum the absolute
+ * values of the elements of a vector of a type without a blas routine, such as
+ * integers
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_Xasum(const int N, const T *X, const int incX) {
+  return Simd::asum<T>(N, X, incX);
+}
+
 // level 1 blas xASUM function: asum <- |x|_1
 /*! \brief Level 1 blas template function used to compute the sum the absolute
  * values of the elements of a vector
@@ -84,10 +128,75 @@ cblas_Xasum(const int N, const double *X, const int incX) {
  * \param x - A one-dimensional array used to store \f$ x \f$
  * \param incX - Increment step used in vector \f$ x \f$
  */
-template <typename T> static T cblas_asum(int N, T *x, int incX) {
+template <typename T>
+static typename Real_type<T>::type cblas_asum(int N, T *x, int incX) {
   return cblas_Xasum(N, x, incX);
 }
 
+// level 1 blas IxAMAX
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * absolute value of a vector of single precision type
+ */
+static size_t MAY_NOT_BE_USED
+cblas_iXamax(const int N, const float *X, const int incX) {
+  return cblas_isamax(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * absolute value of a vector of double precision type
+ */
+static size_t MAY_NOT_BE_USED
+cblas_iXamax(const int N, const double *X, const int incX) {
+  return cblas_idamax(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * sum of the absolute values of its real and imaginary parts of a vector of
+ * single precision complex type
+ */
+static size_t MAY_NOT_BE_USED
+cblas_iXamax(const int N, const std::complex<float> *X, const int incX) {
+  return cblas_icamax(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * sum of the absolute values of its real and imaginary parts of a vector of
+ * double precision complex type
+ */
+static size_t MAY_NOT_BE_USED
+cblas_iXamax(const int N, const std::complex<double> *X, const int incX) {
+  return cblas_izamax(N, X, incX);
+}
+
+/*! \brief Level 1 blas concrete function used to find the element of largest
+ * absolute value of a vector of a type without a blas routine, such as
+ * integers
+ */
+template <typename T>
+static size_t MAY_NOT_BE_USED cblas_iXamax(const int N, const T *X,
+                                           const int incX) {
+  return Simd::iamax<T>(N, X, incX);
+}
+
+// level 1 blas IxAMAX function: i <- argmax |x_i|
+/*! \brief Level 1 blas template function used to find the element of largest
+ * absolute value of a vector
+ *
+ * The funciton is a function template, and the implementation calls the
+ * function \c cblas_iXamax for the correct type. The index returned starts at
+ * zero, and it is zero for an empty vector.
+ *
+ * \tparam T - Template parameter that defines the type of elements in the
+ * vector
+ * \param N - The size of vector \f$ x \f$
+ * \param x - A one-dimensional array used to store \f$ x \f$
+ * \param incX - Increment step used in vector \f$ x \f$
+ */
+template <typename T> static size_t cblas_iamax(int N, T *x, int incX) {
+  return N > 0 ? cblas_iXamax(N, x, incX) : 0;
+}
+
 // level 1 blas xSCAL function: x <- alpha*x
 static void MAY_NOT_BE_USED
 cblas_Xscal(const int N, const float alpha, float *X, const int incX) {
@@ -99,6 +208,25 @@ cblas_Xscal(const int N, const double alpha, double *X, const int incX) {
   cblas_dscal(N, alpha, X, incX);
 }
 
+static void MAY_NOT_BE_USED
+cblas_Xscal(const int N, const std::complex<float> alpha,
+            std::complex<float> *X, const int incX) {
+  cblas_cscal(N, &alpha, X, incX);
+}
+
+static void MAY_NOT_BE_USED
+cblas_Xscal(const int N, const std::complex<double> alpha,
+            std::complex<double> *X, const int incX) {
+  cblas_zscal(N, &alpha, X, incX);
+}
+
+// types without a blas routine, such as integers
+template <typename T>
+static void MAY_NOT_BE_USED cblas_Xscal(const int N, const T alpha, T *X,
+                                        const int incX) {
+  Simd::scal<T>(N, alpha, X, incX);
+}
+
 template <typename T>
 static void cblas_scal(const int N, const T alpha, T *X, const int incX) {
   cblas_Xscal(N, alpha, X, incX);
@@ -124,6 +252,35 @@ static void MAY_NOT_BE_USED cblas_xaxpy(const int N, const double alpha,
   cblas_daxpy(N, alpha, X, incX, Y, incY);
 }
 
+/*! \brief Level 1 blas concrete function used to scale and add a vector of
+ * single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xaxpy(const int N, const std::complex<float> alpha,
+            const std::complex<float> *X, const int incX,
+            std::complex<float> *Y, const int incY) {
+  cblas_caxpy(N, &alpha, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to scale and add a vector of
+ * double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xaxpy(const int N, const std::complex<double> alpha,
+            const std::complex<double> *X, const int incX,
+            std::complex<double> *Y, const int incY) {
+  cblas_zaxpy(N, &alpha, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to scale and add a vector of a
+ * type without a blas routine, such as integers
+ */
+template <typename T>
+static void MAY_NOT_BE_USED cblas_xaxpy(const int N, const T alpha, const T *X,
+                                        const int incX, T *Y, const int incY) {
+  Simd::axpy<T>(N, alpha, X, incX, Y, incY);
+}
+
 // level 1 blas xAXPY function: Y <- alpha*x + y
 
 /*! \brief Level 1 blas template function used to scale and add a vector
@@ -168,6 +325,37 @@ static double MAY_NOT_BE_USED cblas_xdot(const int N, const double *X,
   return cblas_ddot(N, X, incX, Y, incY);
 }
 
+/*! \brief Level 1 blas concrete function used to compute the unconjugated
+ * dot product between two vectors of single precision complex type
+ */
+static std::complex<float> MAY_NOT_BE_USED
+cblas_xdot(const int N, const std::complex<float> *X, const int incX,
+           const std::complex<float> *Y, const int incY) {
+  std::complex<float> r;
+  cblas_cdotu_sub(N, X, incX, Y, incY, &r);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the unconjugated
+ * dot product between two vectors of double precision complex type
+ */
+static std::complex<double> MAY_NOT_BE_USED
+cblas_xdot(const int N, const std::complex<double> *X, const int incX,
+           const std::complex<double> *Y, const int incY) {
+  std::complex<double> r;
+  cblas_zdotu_sub(N, X, incX, Y, incY, &r);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of a type without a blas routine, such as integers
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_xdot(const int N, const T *X, const int incX,
+                                    const T *Y, const int incY) {
+  return Simd::dot<T>(N, X, incX, Y, incY);
+}
+
 /*! \brief Level 1 blas template function used to compute the dot product
  *between two vectors
  *
@@ -184,11 +372,76 @@ static double MAY_NOT_BE_USED cblas_xdot(const int N, const double *X,
  * \param incY - Increment step used in array \f$ y \f$
  */
 template <typename T>
-static double MAY_NOT_BE_USED
+static T MAY_NOT_BE_USED
 cblas_dot(const int N, const T *x, const int incX, const T *y, const int incY) {
   return cblas_xdot(N, x, incX, y, incY);
 }
 
+// level 1 blas xDOTC function: dotc <- x^H*y
+
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of single precision type, for which no conjugation is
+ * needed
+ */
+static float MAY_NOT_BE_USED cblas_xdotc(const int N, const float *X,
+                                         const int incX, const float *Y,
+                                         const int incY) {
+  return cblas_sdot(N, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of double precision type, for which no conjugation is
+ * needed
+ */
+static double MAY_NOT_BE_USED cblas_xdotc(const int N, const double *X,
+                                          const int incX, const double *Y,
+                                          const int incY) {
+  return cblas_ddot(N, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas concrete function used to compute the conjugated dot
+ * product between two vectors of single precision complex type
+ */
+static std::complex<float> MAY_NOT_BE_USED
+cblas_xdotc(const int N, const std::complex<float> *X, const int incX,
+            const std::complex<float> *Y, const int incY) {
+  std::complex<float> r;
+  cblas_cdotc_sub(N, X, incX, Y, incY, &r);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the conjugated dot
+ * product between two vectors of double precision complex type
+ */
+static std::complex<double> MAY_NOT_BE_USED
+cblas_xdotc(const int N, const std::complex<double> *X, const int incX,
+            const std::complex<double> *Y, const int incY) {
+  std::complex<double> r;
+  cblas_zdotc_sub(N, X, incX, Y, incY, &r);
+  return r;
+}
+
+/*! \brief Level 1 blas concrete function used to compute the dot product
+ * between two vectors of a type without a blas routine, such as integers
+ */
+template <typename T>
+static T MAY_NOT_BE_USED cblas_xdotc(const int N, const T *X, const int incX,
+                                     const T *Y, const int incY) {
+  return Simd::dot<T>(N, X, incX, Y, incY);
+}
+
+/*! \brief Level 1 blas template function used to compute the conjugated dot
+ * product between two vectors
+ *
+ * This funciton is used to evaluate \f$ r \leftarrow x^H  y  \f$, which is
+ * the dot product for real vectors.
+ */
+template <typename T>
+static T MAY_NOT_BE_USED
+cblas_dotc(const int N, const T *x, const int incX, const T *y, const int incY) {
+  return cblas_xdotc(N, x, incX, y, incY);
+}
+
 // level 2 blas xGER function: A <- alpha*x*y' + A
 
 /*! \brief Level 2 blas concrete function used to compute the outer product of
@@ -211,6 +464,28 @@ cblas_xger(const int M, const int N, const float alpha, const float *X,
   cblas_sger(CblasColMajor, M, N, alpha, X, incX, Y, incY, A, lda);
 }
 
+/*! \brief Level 2 blas concrete function used to compute the unconjugated
+ * outer product of two vectors of single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xger(const int M, const int N, const std::complex<float> alpha,
+           const std::complex<float> *X, const int incX,
+           const std::complex<float> *Y, const int incY,
+           std::complex<float> *A, const int lda) {
+  cblas_cgeru(CblasColMajor, M, N, &alpha, X, incX, Y, incY, A, lda);
+}
+
+/*! \brief Level 2 blas concrete function used to compute the unconjugated
+ * outer product of two vectors of double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xger(const int M, const int N, const std::complex<double> alpha,
+           const std::complex<double> *X, const int incX,
+           const std::complex<double> *Y, const int incY,
+           std::complex<double> *A, const int lda) {
+  cblas_zgeru(CblasColMajor, M, N, &alpha, X, incX, Y, incY, A, lda);
+}
+
 // level 2 blas xGER function: Y <- alpha*A*x + beta*y
 /*! \brief Level 2 blas template function used to compute the outer product of
  * two vectors
@@ -253,6 +528,32 @@ cblas_xgemv(const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
               incY);
 }
 
+/*! \brief Level 2 blas concrete function used to multiply a matrix by a
+ * vector of single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemv(const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
+            const std::complex<float> alpha, const std::complex<float> *A,
+            const int lda, const std::complex<float> *X, const int incX,
+            const std::complex<float> beta, std::complex<float> *Y,
+            const int incY) {
+  cblas_cgemv(CblasColMajor, TransA, M, N, &alpha, A, lda, X, incX, &beta, Y,
+              incY);
+}
+
+/*! \brief Level 2 blas concrete function used to multiply a matrix by a
+ * vector of double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemv(const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
+            const std::complex<double> alpha, const std::complex<double> *A,
+            const int lda, const std::complex<double> *X, const int incX,
+            const std::complex<double> beta, std::complex<double> *Y,
+            const int incY) {
+  cblas_zgemv(CblasColMajor, TransA, M, N, &alpha, A, lda, X, incX, &beta, Y,
+              incY);
+}
+
 /*! \brief Level 2 blas concrete function used to multiply a matrix by a vector
  * of double precision type
  */
@@ -294,6 +595,7 @@ static void MAY_NOT_BE_USED
 cblas_gemv(const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
            const T alpha, const T *A, const int lda, const T *x, const int incX,
            const T beta, T *y, const int incY) {
+  Blas_threads::Product threads(size_t(M) * N);
   cblas_xgemv(TransA, M, N, alpha, A, lda, x, incX, beta, y, incY);
 }
 
@@ -327,6 +629,36 @@ cblas_xgemm(const enum CBLAS_TRANSPOSE TransA,
               beta, C, ldc);
 }
 
+/*! \brief Level 3 blas concrete function used to multiply two matrices of
+ * single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemm(const enum CBLAS_TRANSPOSE TransA,
+            const enum CBLAS_TRANSPOSE TransB, const int M, const int N,
+            const int K, const std::complex<float> alpha,
+            const std::complex<float> *A, const int lda,
+            const std::complex<float> *B, const int ldb,
+            const std::complex<float> beta, std::complex<float> *C,
+            const int ldc) {
+  cblas_cgemm(CblasColMajor, TransA, TransB, M, N, K, &alpha, A, lda, B, ldb,
+              &beta, C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply two matrices of
+ * double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xgemm(const enum CBLAS_TRANSPOSE TransA,
+            const enum CBLAS_TRANSPOSE TransB, const int M, const int N,
+            const int K, const std::complex<double> alpha,
+            const std::complex<double> *A, const int lda,
+            const std::complex<double> *B, const int ldb,
+            const std::complex<double> beta, std::complex<double> *C,
+            const int ldc) {
+  cblas_zgemm(CblasColMajor, TransA, TransB, M, N, K, &alpha, A, lda, B, ldb,
+              &beta, C, ldc);
+}
+
 // level 3 blas xGEMM function: C <- alpha*op(A)*op(B) = beta*C, op(X) = X, X'
 /*! \brief Level 3 blas template function used to multiply two matrices
  *
@@ -365,9 +697,431 @@ cblas_gemm(const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_TRANSPOSE TransB,
            const int lda, const T *B, const int ldb, const T beta, T *C,
            const int ldc) {
 
+  Blas_threads::Product threads(size_t(M) * N * K);
   cblas_xgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
 }
 
+// level 2 blas xSYMV function: y <- alpha*A*x + beta*y, A symmetric
+
+/*! \brief Level 2 blas concrete function used to multiply a symmetric matrix
+ * and a vector of single precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymv(const enum CBLAS_UPLO Uplo, const int N, const float alpha,
+            const float *A, const int lda, const float *X, const int incX,
+            const float beta, float *Y, const int incY) {
+
+  cblas_ssymv(CblasColMajor, Uplo, N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+/*! \brief Level 2 blas concrete function used to multiply a symmetric matrix
+ * and a vector of double precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymv(const enum CBLAS_UPLO Uplo, const int N, const double alpha,
+            const double *A, const int lda, const double *X, const int incX,
+            const double beta, double *Y, const int incY) {
+
+  cblas_dsymv(CblasColMajor, Uplo, N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+/*! \brief Level 2 blas concrete function used to multiply a symmetric matrix
+ * and a vector of single precision complex type
+ *
+ * Blas has no complex symmetric matrix-vector product, so the vector is
+ * passed to xSYMM as a matrix with a single column.
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymv(const enum CBLAS_UPLO Uplo, const int N,
+            const std::complex<float> alpha, const std::complex<float> *A,
+            const int lda, const std::complex<float> *X, const int incX,
+            const std::complex<float> beta, std::complex<float> *Y,
+            const int incY) {
+  assert(incX == 1 && incY == 1);
+  cblas_csymm(CblasColMajor, CblasLeft, Uplo, N, 1, &alpha, A, lda, X, N,
+              &beta, Y, N);
+}
+
+/*! \brief Level 2 blas concrete function used to multiply a symmetric matrix
+ * and a vector of double precision complex type
+ *
+ * Blas has no complex symmetric matrix-vector product, so the vector is
+ * passed to xSYMM as a matrix with a single column.
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymv(const enum CBLAS_UPLO Uplo, const int N,
+            const std::complex<double> alpha, const std::complex<double> *A,
+            const int lda, const std::complex<double> *X, const int incX,
+            const std::complex<double> beta, std::complex<double> *Y,
+            const int incY) {
+  assert(incX == 1 && incY == 1);
+  cblas_zsymm(CblasColMajor, CblasLeft, Uplo, N, 1, &alpha, A, lda, X, N,
+              &beta, Y, N);
+}
+
+/*! \brief Level 2 blas template function used to multiply a symmetric matrix
+ * and a vector
+ *
+ * This function is used to evaluate \f$ y \leftarrow \alpha A x + \beta y \f$,
+ * where only the triangle of \f$ A \f$ given by Uplo is referenced.
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_symv(const enum CBLAS_UPLO Uplo, const int N, const T alpha, const T *A,
+           const int lda, const T *X, const int incX, const T beta, T *Y,
+           const int incY) {
+
+  cblas_xsymv(Uplo, N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+// level 3 blas xSYMM function: C <- alpha*A*B + beta*C or alpha*B*A + beta*C,
+// A symmetric
+
+/*! \brief Level 3 blas concrete function used to multiply a symmetric matrix
+ * and a general matrix of single precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo, const int M,
+            const int N, const float alpha, const float *A, const int lda,
+            const float *B, const int ldb, const float beta, float *C,
+            const int ldc) {
+
+  cblas_ssymm(CblasColMajor, Side, Uplo, M, N, alpha, A, lda, B, ldb, beta, C,
+              ldc);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a symmetric matrix
+ * and a general matrix of double precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo, const int M,
+            const int N, const double alpha, const double *A, const int lda,
+            const double *B, const int ldb, const double beta, double *C,
+            const int ldc) {
+
+  cblas_dsymm(CblasColMajor, Side, Uplo, M, N, alpha, A, lda, B, ldb, beta, C,
+              ldc);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a symmetric matrix
+ * and a general matrix of single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo, const int M,
+            const int N, const std::complex<float> alpha,
+            const std::complex<float> *A, const int lda,
+            const std::complex<float> *B, const int ldb,
+            const std::complex<float> beta, std::complex<float> *C,
+            const int ldc) {
+  cblas_csymm(CblasColMajor, Side, Uplo, M, N, &alpha, A, lda, B, ldb, &beta,
+              C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a symmetric matrix
+ * and a general matrix of double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsymm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo, const int M,
+            const int N, const std::complex<double> alpha,
+            const std::complex<double> *A, const int lda,
+            const std::complex<double> *B, const int ldb,
+            const std::complex<double> beta, std::complex<double> *C,
+            const int ldc) {
+  cblas_zsymm(CblasColMajor, Side, Uplo, M, N, &alpha, A, lda, B, ldb, &beta,
+              C, ldc);
+}
+
+/*! \brief Level 3 blas template function used to multiply a symmetric matrix
+ * and a general matrix
+ *
+ * This function is used to evaluate \f$ C \leftarrow \alpha A B + \beta C \f$
+ * if Side is CblasLeft, or \f$ C \leftarrow \alpha B A + \beta C \f$ if Side is
+ * CblasRight, where \f$ C \f$ is M x N and only the triangle of the symmetric
+ * matrix \f$ A \f$ given by Uplo is referenced.
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_symm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo, const int M,
+           const int N, const T alpha, const T *A, const int lda, const T *B,
+           const int ldb, const T beta, T *C, const int ldc) {
+
+  Blas_threads::Product threads(size_t(M) * N * (Side == CblasLeft ? M : N));
+  cblas_xsymm(Side, Uplo, M, N, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+// level 3 blas xSYRK function: C <- alpha*A*A' + beta*C or alpha*A'*A + beta*C
+
+/*! \brief Level 3 blas concrete function used for the symmetric rank k update
+ * of a matrix of single precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsyrk(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+            const int N, const int K, const float alpha, const float *A,
+            const int lda, const float beta, float *C, const int ldc) {
+
+  cblas_ssyrk(CblasColMajor, Uplo, Trans, N, K, alpha, A, lda, beta, C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used for the symmetric rank k update
+ * of a matrix of double precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsyrk(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+            const int N, const int K, const double alpha, const double *A,
+            const int lda, const double beta, double *C, const int ldc) {
+
+  cblas_dsyrk(CblasColMajor, Uplo, Trans, N, K, alpha, A, lda, beta, C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used for the symmetric rank k update
+ * of a matrix of single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsyrk(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+            const int N, const int K, const std::complex<float> alpha,
+            const std::complex<float> *A, const int lda,
+            const std::complex<float> beta, std::complex<float> *C,
+            const int ldc) {
+  cblas_csyrk(CblasColMajor, Uplo, Trans, N, K, &alpha, A, lda, &beta, C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used for the symmetric rank k update
+ * of a matrix of double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xsyrk(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+            const int N, const int K, const std::complex<double> alpha,
+            const std::complex<double> *A, const int lda,
+            const std::complex<double> beta, std::complex<double> *C,
+            const int ldc) {
+  cblas_zsyrk(CblasColMajor, Uplo, Trans, N, K, &alpha, A, lda, &beta, C, ldc);
+}
+
+/*! \brief Level 3 blas template function used for the symmetric rank k update
+ * of a matrix
+ *
+ * This function is used to evaluate \f$ C \leftarrow \alpha A A^\top + \beta
+ * C \f$ if Trans is CblasNoTrans, or \f$ C \leftarrow \alpha A^\top A + \beta C
+ * \f$ if Trans is CblasTrans, where the N x N matrix \f$ C \f$ is symmetric and
+ * only the triangle given by Uplo is computed.
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_syrk(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+           const int N, const int K, const T alpha, const T *A, const int lda,
+           const T beta, T *C, const int ldc) {
+
+  Blas_threads::Product threads(size_t(N) * N * K);
+  cblas_xsyrk(Uplo, Trans, N, K, alpha, A, lda, beta, C, ldc);
+}
+
+// level 2 blas xTRSV function: x <- op(A)^-1*x, A triangular
+
+/*! \brief Level 2 blas concrete function used to solve a triangular system of
+ * single precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsv(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+            const enum CBLAS_DIAG Diag, const int N, const float *A,
+            const int lda, float *X, const int incX) {
+
+  cblas_strsv(CblasColMajor, Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+/*! \brief Level 2 blas concrete function used to solve a triangular system of
+ * double precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsv(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+            const enum CBLAS_DIAG Diag, const int N, const double *A,
+            const int lda, double *X, const int incX) {
+
+  cblas_dtrsv(CblasColMajor, Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+/*! \brief Level 2 blas concrete function used to solve a triangular system of
+ * single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsv(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+            const enum CBLAS_DIAG Diag, const int N,
+            const std::complex<float> *A, const int lda, std::complex<float> *X,
+            const int incX) {
+  cblas_ctrsv(CblasColMajor, Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+/*! \brief Level 2 blas concrete function used to solve a triangular system of
+ * double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsv(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+            const enum CBLAS_DIAG Diag, const int N,
+            const std::complex<double> *A, const int lda,
+            std::complex<double> *X, const int incX) {
+  cblas_ztrsv(CblasColMajor, Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+/*! \brief Level 2 blas template function used to solve a triangular system
+ *
+ * This function is used to evaluate \f$ x \leftarrow \text{op}(A)^{-1} x \f$,
+ * where \f$ A \f$ is upper or lower triangular as given by Uplo, and has a
+ * unit diagonal that is not referenced if Diag is CblasUnit.
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_trsv(const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+           const enum CBLAS_DIAG Diag, const int N, const T *A, const int lda,
+           T *X, const int incX) {
+
+  cblas_xtrsv(Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+// level 3 blas xTRSM function: B <- alpha*op(A)^-1*B or alpha*B*op(A)^-1,
+// A triangular
+
+/*! \brief Level 3 blas concrete function used to solve triangular systems of
+ * single precision type with multiple right-hand sides
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const float alpha, const float *A,
+            const int lda, float *B, const int ldb) {
+
+  cblas_strsm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B,
+              ldb);
+}
+
+/*! \brief Level 3 blas concrete function used to solve triangular systems of
+ * double precision type with multiple right-hand sides
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const double alpha, const double *A,
+            const int lda, double *B, const int ldb) {
+
+  cblas_dtrsm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B,
+              ldb);
+}
+
+/*! \brief Level 3 blas concrete function used to solve triangular systems of
+ * single precision complex type with multiple right-hand sides
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const std::complex<float> alpha,
+            const std::complex<float> *A, const int lda, std::complex<float> *B,
+            const int ldb) {
+  cblas_ctrsm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, &alpha, A, lda,
+              B, ldb);
+}
+
+/*! \brief Level 3 blas concrete function used to solve triangular systems of
+ * double precision complex type with multiple right-hand sides
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrsm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const std::complex<double> alpha,
+            const std::complex<double> *A, const int lda,
+            std::complex<double> *B, const int ldb) {
+  cblas_ztrsm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, &alpha, A, lda,
+              B, ldb);
+}
+
+/*! \brief Level 3 blas template function used to solve triangular systems
+ * with multiple right-hand sides
+ *
+ * This function is used to evaluate \f$ B \leftarrow \alpha \text{op}(A)^{-1}
+ * B \f$ if Side is CblasLeft, or \f$ B \leftarrow \alpha B \text{op}(A)^{-1} \f$
+ * if Side is CblasRight, where \f$ B \f$ is M x N.
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_trsm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+           const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+           const int M, const int N, const T alpha, const T *A, const int lda,
+           T *B, const int ldb) {
+
+  Blas_threads::Product threads(size_t(M) * N * (Side == CblasLeft ? M : N));
+  cblas_xtrsm(Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb);
+}
+
+// level 3 blas xTRMM function: B <- alpha*op(A)*B or alpha*B*op(A),
+// A triangular
+
+/*! \brief Level 3 blas concrete function used to multiply a triangular matrix
+ * and a general matrix of single precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrmm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const float alpha, const float *A,
+            const int lda, float *B, const int ldb) {
+
+  cblas_strmm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B,
+              ldb);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a triangular matrix
+ * and a general matrix of double precision type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrmm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const double alpha, const double *A,
+            const int lda, double *B, const int ldb) {
+
+  cblas_dtrmm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B,
+              ldb);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a triangular matrix
+ * and a general matrix of single precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrmm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const std::complex<float> alpha,
+            const std::complex<float> *A, const int lda, std::complex<float> *B,
+            const int ldb) {
+  cblas_ctrmm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, &alpha, A, lda,
+              B, ldb);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a triangular matrix
+ * and a general matrix of double precision complex type
+ */
+static void MAY_NOT_BE_USED
+cblas_xtrmm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+            const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+            const int M, const int N, const std::complex<double> alpha,
+            const std::complex<double> *A, const int lda,
+            std::complex<double> *B, const int ldb) {
+  cblas_ztrmm(CblasColMajor, Side, Uplo, TransA, Diag, M, N, &alpha, A, lda,
+              B, ldb);
+}
+
+/*! \brief Level 3 blas template function used to multiply a triangular matrix
+ * and a general matrix
+ *
+ * This function is used to evaluate \f$ B \leftarrow \alpha \text{op}(A) B
+ * \f$ if Side is CblasLeft, or \f$ B \leftarrow \alpha B \text{op}(A) \f$ if
+ * Side is CblasRight, where \f$ B \f$ is M x N.
+ */
+template <class T>
+static void MAY_NOT_BE_USED
+cblas_trmm(const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+           const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag,
+           const int M, const int N, const T alpha, const T *A, const int lda,
+           T *B, const int ldb) {
+
+  Blas_threads::Product threads(size_t(M) * N * (Side == CblasLeft ? M : N));
+  cblas_xtrmm(Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb);
+}
+
 __END_ARRAY_NAMESPACE__
 
 #endif /* CBLAS_IMPL_HPP */
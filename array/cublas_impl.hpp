@@ -35,6 +35,13 @@
 
 static constexpr cublasOperation_t CblasNoTrans = CUBLAS_OP_N;
 static constexpr cublasOperation_t CblasTrans = CUBLAS_OP_T;
+static constexpr cublasOperation_t CblasConjTrans = CUBLAS_OP_C;
+static constexpr cublasFillMode_t CblasUpper = CUBLAS_FILL_MODE_UPPER;
+static constexpr cublasFillMode_t CblasLower = CUBLAS_FILL_MODE_LOWER;
+static constexpr cublasSideMode_t CblasLeft = CUBLAS_SIDE_LEFT;
+static constexpr cublasSideMode_t CblasRight = CUBLAS_SIDE_RIGHT;
+static constexpr cublasDiagType_t CblasUnit = CUBLAS_DIAG_UNIT;
+static constexpr cublasDiagType_t CblasNonUnit = CUBLAS_DIAG_NON_UNIT;
 
 __BEGIN_ARRAY_NAMESPACE__
 
@@ -414,6 +421,20 @@ static T cblas_dot(const int N, const T *X, const int incX, const T *Y,
   return r;
 }
 
+// level 1 blas xDOTC function: dot <- conj(x)'*y
+
+/*! rief Level 1 blas template function used to compute the dot product
+ * between the conjugate of a vector and another vector
+ *
+ * Only real types are bound by this interface, for which the conjugated dot
+ * product is the dot product, so the implementation calls \c cblas_dot.
+ */
+template <typename T>
+static T cblas_dotc(const int N, const T *X, const int incX, const T *Y,
+                    const int incY) {
+  return cblas_dot(N, X, incX, Y, incY);
+}
+
 // level 2 blas xGER function: A <- alpha*x*y' + A
 
 /*! \brief Level 2 blas concrete function used to compute the outer product of
@@ -844,6 +865,703 @@ static void cblas_gemm(cublasOperation_t transa, cublasOperation_t transb,
   cudaFree(d_C);
 }
 
+// level 2 blas xSYMV function: y <- alpha*A*x + beta*y, A symmetric
+
+/*! \brief Level 2 blas concrete function used to multiply a symmetric matrix
+ * and a vector of single precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXsymv(cublasHandle_t handle,
+                                  cublasFillMode_t uplo, int n,
+                                  const float *alpha, const float *A, int lda,
+                                  const float *x, int incx, const float *beta,
+                                  float *y, int incy) {
+  return cublasSsymv(handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+/*! \brief Level 2 blas concrete function used to multiply a symmetric matrix
+ * and a vector of double precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXsymv(cublasHandle_t handle,
+                                  cublasFillMode_t uplo, int n,
+                                  const double *alpha, const double *A, int lda,
+                                  const double *x, int incx, const double *beta,
+                                  double *y, int incy) {
+  return cublasDsymv(handle, uplo, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+/*! \brief Level 2 blas template function used to multiply a symmetric matrix
+ * and a vector
+ *
+ * This function is used to evaluate \f$ y \leftarrow \alpha A x + \beta y \f$,
+ * where only the triangle of \f$ A \f$ given by uplo is referenced.
+ */
+template <typename T>
+static void cblas_symv(cublasFillMode_t uplo, int n, T alpha, const T *A,
+                       int lda, const T *x, int incx, T beta, T *y, int incy) {
+
+  cudaError_t cudaStat;
+  cublasStatus_t stat;
+  cublasHandle_t handle;
+
+  // make sure CUDA is initialized
+  if (!CUDA::getInstance().initialized()) {
+    cout << "*** ERROR *** cuda not initialized" << endl;
+    cout << "              Call array::CUDA::getInstance().initialize(argc, "
+            "argv);" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasCreate(&handle);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** CUBLAS initialization failed" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // allocate device memory
+  T *d_A, *d_X, *d_Y;
+
+  cudaStat = cudaMalloc((void **)&d_A, n * n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_A returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(n, n, sizeof(T), A, lda, d_A, n);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_X, n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_X returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetVector(n, sizeof(T), x, incx, d_X, 1);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetVector returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_Y, n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_Y returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // y need not be initialized if beta is zero
+  if (beta != T()) {
+    stat = cublasSetVector(n, sizeof(T), y, incy, d_Y, 1);
+    if (stat != CUBLAS_STATUS_SUCCESS) {
+      cout << "*** ERROR *** cublasSetVector returned error code " << stat
+           << ", line " << __LINE__ << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  stat = cublasXsymv(handle, uplo, n, &alpha, d_A, n, d_X, 1, &beta, d_Y, 1);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasXsymv returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // copy result from device to host
+  stat = cublasGetVector(n, sizeof(T), d_Y, 1, y, incy);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasGetVector returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaFree(d_A);
+  cudaFree(d_X);
+  cudaFree(d_Y);
+  cublasDestroy(handle);
+}
+
+// level 3 blas xSYMM function: C <- alpha*A*B + beta*C or alpha*B*A + beta*C,
+// A symmetric
+
+/*! \brief Level 3 blas concrete function used to multiply a symmetric matrix
+ * and a general matrix of single precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXsymm(cublasHandle_t handle,
+                                  cublasSideMode_t side, cublasFillMode_t uplo,
+                                  int m, int n, const float *alpha,
+                                  const float *A, int lda, const float *B,
+                                  int ldb, const float *beta, float *C,
+                                  int ldc) {
+  return cublasSsymm(handle, side, uplo, m, n, alpha, A, lda, B, ldb, beta, C,
+                     ldc);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a symmetric matrix
+ * and a general matrix of double precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXsymm(cublasHandle_t handle,
+                                  cublasSideMode_t side, cublasFillMode_t uplo,
+                                  int m, int n, const double *alpha,
+                                  const double *A, int lda, const double *B,
+                                  int ldb, const double *beta, double *C,
+                                  int ldc) {
+  return cublasDsymm(handle, side, uplo, m, n, alpha, A, lda, B, ldb, beta, C,
+                     ldc);
+}
+
+/*! \brief Level 3 blas template function used to multiply a symmetric matrix
+ * and a general matrix
+ *
+ * This function is used to evaluate \f$ C \leftarrow \alpha A B + \beta C \f$
+ * if side is CblasLeft, or \f$ C \leftarrow \alpha B A + \beta C \f$ if side is
+ * CblasRight, where \f$ C \f$ is m x n and only the triangle of the symmetric
+ * matrix \f$ A \f$ given by uplo is referenced.
+ */
+template <typename T>
+static void cblas_symm(cublasSideMode_t side, cublasFillMode_t uplo, int m,
+                       int n, T alpha, const T *A, int lda, const T *B, int ldb,
+                       T beta, T *C, int ldc) {
+
+  cudaError_t cudaStat;
+  cublasStatus_t stat;
+  cublasHandle_t handle;
+
+  // make sure CUDA is initialized
+  if (!CUDA::getInstance().initialized()) {
+    cout << "*** ERROR *** cuda not initialized" << endl;
+    cout << "              Call array::CUDA::getInstance().initialize(argc, "
+            "argv);" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasCreate(&handle);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** CUBLAS initialization failed" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // allocate device memory, the symmetric matrix is k x k
+  const int k = side == CblasLeft ? m : n;
+  T *d_A, *d_B, *d_C;
+
+  cudaStat = cudaMalloc((void **)&d_A, k * k * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_A returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(k, k, sizeof(T), A, lda, d_A, k);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_B, m * n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_B returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(m, n, sizeof(T), B, ldb, d_B, m);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_C, m * n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_C returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // C need not be initialized if beta is zero
+  if (beta != T()) {
+    stat = cublasSetMatrix(m, n, sizeof(T), C, ldc, d_C, m);
+    if (stat != CUBLAS_STATUS_SUCCESS) {
+      cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+           << ", line " << __LINE__ << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  stat = cublasXsymm(handle, side, uplo, m, n, &alpha, d_A, k, d_B, m, &beta,
+                     d_C, m);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasXsymm returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // copy result from device to host
+  stat = cublasGetMatrix(m, n, sizeof(T), d_C, m, C, ldc);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasGetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaFree(d_A);
+  cudaFree(d_B);
+  cudaFree(d_C);
+  cublasDestroy(handle);
+}
+
+// level 3 blas xSYRK function: C <- alpha*A*A' + beta*C or alpha*A'*A + beta*C
+
+/*! \brief Level 3 blas concrete function used for the symmetric rank k update
+ * of a matrix of single precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXsyrk(cublasHandle_t handle,
+                                  cublasFillMode_t uplo,
+                                  cublasOperation_t trans, int n, int k,
+                                  const float *alpha, const float *A, int lda,
+                                  const float *beta, float *C, int ldc) {
+  return cublasSsyrk(handle, uplo, trans, n, k, alpha, A, lda, beta, C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used for the symmetric rank k update
+ * of a matrix of double precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXsyrk(cublasHandle_t handle,
+                                  cublasFillMode_t uplo,
+                                  cublasOperation_t trans, int n, int k,
+                                  const double *alpha, const double *A, int lda,
+                                  const double *beta, double *C, int ldc) {
+  return cublasDsyrk(handle, uplo, trans, n, k, alpha, A, lda, beta, C, ldc);
+}
+
+/*! \brief Level 3 blas template function used for the symmetric rank k update
+ * of a matrix
+ *
+ * This function is used to evaluate \f$ C \leftarrow \alpha A A^\top + \beta
+ * C \f$ if trans is CblasNoTrans, or \f$ C \leftarrow \alpha A^\top A + \beta C
+ * \f$ if trans is CblasTrans, where the n x n matrix \f$ C \f$ is symmetric and
+ * only the triangle given by uplo is computed. The other triangle of \f$ C \f$
+ * is copied back unchanged.
+ */
+template <typename T>
+static void cblas_syrk(cublasFillMode_t uplo, cublasOperation_t trans, int n,
+                       int k, T alpha, const T *A, int lda, T beta, T *C,
+                       int ldc) {
+
+  cudaError_t cudaStat;
+  cublasStatus_t stat;
+  cublasHandle_t handle;
+
+  // make sure CUDA is initialized
+  if (!CUDA::getInstance().initialized()) {
+    cout << "*** ERROR *** cuda not initialized" << endl;
+    cout << "              Call array::CUDA::getInstance().initialize(argc, "
+            "argv);" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasCreate(&handle);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** CUBLAS initialization failed" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // allocate device memory, op(A) is n x k
+  const int ra = trans == CblasNoTrans ? n : k;
+  const int ca = trans == CblasNoTrans ? k : n;
+  T *d_A, *d_C;
+
+  cudaStat = cudaMalloc((void **)&d_A, ra * ca * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_A returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(ra, ca, sizeof(T), A, lda, d_A, ra);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_C, n * n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_C returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // the whole matrix is copied, so that the triangle that is not referenced
+  // comes back unchanged
+  stat = cublasSetMatrix(n, n, sizeof(T), C, ldc, d_C, n);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasXsyrk(handle, uplo, trans, n, k, &alpha, d_A, ra, &beta, d_C, n);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasXsyrk returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // copy result from device to host
+  stat = cublasGetMatrix(n, n, sizeof(T), d_C, n, C, ldc);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasGetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaFree(d_A);
+  cudaFree(d_C);
+  cublasDestroy(handle);
+}
+
+// level 2 blas xTRSV function: x <- op(A)^-1*x, A triangular
+
+/*! \brief Level 2 blas concrete function used to solve a triangular system of
+ * single precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXtrsv(cublasHandle_t handle,
+                                  cublasFillMode_t uplo,
+                                  cublasOperation_t trans,
+                                  cublasDiagType_t diag, int n, const float *A,
+                                  int lda, float *x, int incx) {
+  return cublasStrsv(handle, uplo, trans, diag, n, A, lda, x, incx);
+}
+
+/*! \brief Level 2 blas concrete function used to solve a triangular system of
+ * double precision type
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXtrsv(cublasHandle_t handle,
+                                  cublasFillMode_t uplo,
+                                  cublasOperation_t trans,
+                                  cublasDiagType_t diag, int n, const double *A,
+                                  int lda, double *x, int incx) {
+  return cublasDtrsv(handle, uplo, trans, diag, n, A, lda, x, incx);
+}
+
+/*! \brief Level 2 blas template function used to solve a triangular system
+ *
+ * This function is used to evaluate \f$ x \leftarrow \text{op}(A)^{-1} x \f$,
+ * where \f$ A \f$ is upper or lower triangular as given by uplo, and has a
+ * unit diagonal that is not referenced if diag is CblasUnit.
+ */
+template <typename T>
+static void cblas_trsv(cublasFillMode_t uplo, cublasOperation_t trans,
+                       cublasDiagType_t diag, int n, const T *A, int lda, T *x,
+                       int incx) {
+
+  cudaError_t cudaStat;
+  cublasStatus_t stat;
+  cublasHandle_t handle;
+
+  // make sure CUDA is initialized
+  if (!CUDA::getInstance().initialized()) {
+    cout << "*** ERROR *** cuda not initialized" << endl;
+    cout << "              Call array::CUDA::getInstance().initialize(argc, "
+            "argv);" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasCreate(&handle);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** CUBLAS initialization failed" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // allocate device memory
+  T *d_A, *d_X;
+
+  cudaStat = cudaMalloc((void **)&d_A, n * n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_A returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(n, n, sizeof(T), A, lda, d_A, n);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_X, n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_X returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetVector(n, sizeof(T), x, incx, d_X, 1);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetVector returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasXtrsv(handle, uplo, trans, diag, n, d_A, n, d_X, 1);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasXtrsv returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // copy result from device to host
+  stat = cublasGetVector(n, sizeof(T), d_X, 1, x, incx);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasGetVector returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaFree(d_A);
+  cudaFree(d_X);
+  cublasDestroy(handle);
+}
+
+// level 3 blas xTRSM function: B <- alpha*op(A)^-1*B or alpha*B*op(A)^-1,
+// A triangular
+
+/*! \brief Level 3 blas concrete function used to solve triangular systems of
+ * single precision type with multiple right-hand sides
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXtrsm(cublasHandle_t handle,
+                                  cublasSideMode_t side, cublasFillMode_t uplo,
+                                  cublasOperation_t trans,
+                                  cublasDiagType_t diag, int m, int n,
+                                  const float *alpha, const float *A, int lda,
+                                  float *B, int ldb) {
+  return cublasStrsm(handle, side, uplo, trans, diag, m, n, alpha, A, lda, B,
+                     ldb);
+}
+
+/*! \brief Level 3 blas concrete function used to solve triangular systems of
+ * double precision type with multiple right-hand sides
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXtrsm(cublasHandle_t handle,
+                                  cublasSideMode_t side, cublasFillMode_t uplo,
+                                  cublasOperation_t trans,
+                                  cublasDiagType_t diag, int m, int n,
+                                  const double *alpha, const double *A, int lda,
+                                  double *B, int ldb) {
+  return cublasDtrsm(handle, side, uplo, trans, diag, m, n, alpha, A, lda, B,
+                     ldb);
+}
+
+/*! \brief Level 3 blas template function used to solve triangular systems
+ * with multiple right-hand sides
+ *
+ * This function is used to evaluate \f$ B \leftarrow \alpha \text{op}(A)^{-1}
+ * B \f$ if side is CblasLeft, or \f$ B \leftarrow \alpha B \text{op}(A)^{-1} \f$
+ * if side is CblasRight, where \f$ B \f$ is m x n.
+ */
+template <typename T>
+static void cblas_trsm(cublasSideMode_t side, cublasFillMode_t uplo,
+                       cublasOperation_t trans, cublasDiagType_t diag, int m,
+                       int n, T alpha, const T *A, int lda, T *B, int ldb) {
+
+  cudaError_t cudaStat;
+  cublasStatus_t stat;
+  cublasHandle_t handle;
+
+  // make sure CUDA is initialized
+  if (!CUDA::getInstance().initialized()) {
+    cout << "*** ERROR *** cuda not initialized" << endl;
+    cout << "              Call array::CUDA::getInstance().initialize(argc, "
+            "argv);" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasCreate(&handle);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** CUBLAS initialization failed" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // allocate device memory, the triangular matrix is k x k
+  const int k = side == CblasLeft ? m : n;
+  T *d_A, *d_B;
+
+  cudaStat = cudaMalloc((void **)&d_A, k * k * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_A returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(k, k, sizeof(T), A, lda, d_A, k);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_B, m * n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_B returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(m, n, sizeof(T), B, ldb, d_B, m);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasXtrsm(handle, side, uplo, trans, diag, m, n, &alpha, d_A, k,
+                     d_B, m);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasXtrsm returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // copy result from device to host
+  stat = cublasGetMatrix(m, n, sizeof(T), d_B, m, B, ldb);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasGetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaFree(d_A);
+  cudaFree(d_B);
+  cublasDestroy(handle);
+}
+
+// level 3 blas xTRMM function: B <- alpha*op(A)*B or alpha*B*op(A),
+// A triangular
+
+/*! \brief Level 3 blas concrete function used to multiply a triangular matrix
+ * and a general matrix of single precision type
+ *
+ * The product is written to C, which may be the same as B.
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXtrmm(cublasHandle_t handle,
+                                  cublasSideMode_t side, cublasFillMode_t uplo,
+                                  cublasOperation_t trans,
+                                  cublasDiagType_t diag, int m, int n,
+                                  const float *alpha, const float *A, int lda,
+                                  const float *B, int ldb, float *C, int ldc) {
+  return cublasStrmm(handle, side, uplo, trans, diag, m, n, alpha, A, lda, B,
+                     ldb, C, ldc);
+}
+
+/*! \brief Level 3 blas concrete function used to multiply a triangular matrix
+ * and a general matrix of double precision type
+ *
+ * The product is written to C, which may be the same as B.
+ */
+static cublasStatus_t MAY_NOT_BE_USED cublasXtrmm(cublasHandle_t handle,
+                                  cublasSideMode_t side, cublasFillMode_t uplo,
+                                  cublasOperation_t trans,
+                                  cublasDiagType_t diag, int m, int n,
+                                  const double *alpha, const double *A, int lda,
+                                  const double *B, int ldb, double *C,
+                                  int ldc) {
+  return cublasDtrmm(handle, side, uplo, trans, diag, m, n, alpha, A, lda, B,
+                     ldb, C, ldc);
+}
+
+/*! \brief Level 3 blas template function used to multiply a triangular matrix
+ * and a general matrix
+ *
+ * This function is used to evaluate \f$ B \leftarrow \alpha \text{op}(A) B
+ * \f$ if side is CblasLeft, or \f$ B \leftarrow \alpha B \text{op}(A) \f$ if
+ * side is CblasRight, where \f$ B \f$ is m x n.
+ */
+template <typename T>
+static void cblas_trmm(cublasSideMode_t side, cublasFillMode_t uplo,
+                       cublasOperation_t trans, cublasDiagType_t diag, int m,
+                       int n, T alpha, const T *A, int lda, T *B, int ldb) {
+
+  cudaError_t cudaStat;
+  cublasStatus_t stat;
+  cublasHandle_t handle;
+
+  // make sure CUDA is initialized
+  if (!CUDA::getInstance().initialized()) {
+    cout << "*** ERROR *** cuda not initialized" << endl;
+    cout << "              Call array::CUDA::getInstance().initialize(argc, "
+            "argv);" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasCreate(&handle);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** CUBLAS initialization failed" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // allocate device memory, the triangular matrix is k x k
+  const int k = side == CblasLeft ? m : n;
+  T *d_A, *d_B;
+
+  cudaStat = cudaMalloc((void **)&d_A, k * k * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_A returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(k, k, sizeof(T), A, lda, d_A, k);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaStat = cudaMalloc((void **)&d_B, m * n * sizeof(T));
+  if (cudaStat != cudaSuccess) {
+    cout << "*** ERROR *** cudaMalloc d_B returned error code " << cudaStat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  stat = cublasSetMatrix(m, n, sizeof(T), B, ldb, d_B, m);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasSetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // the product is computed in place, as in the cblas interface
+  stat = cublasXtrmm(handle, side, uplo, trans, diag, m, n, &alpha, d_A, k,
+                     d_B, m, d_B, m);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasXtrmm returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // copy result from device to host
+  stat = cublasGetMatrix(m, n, sizeof(T), d_B, m, B, ldb);
+  if (stat != CUBLAS_STATUS_SUCCESS) {
+    cout << "*** ERROR *** cublasGetMatrix returned error code " << stat
+         << ", line " << __LINE__ << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  cudaFree(d_A);
+  cudaFree(d_B);
+  cublasDestroy(handle);
+}
+
 __END_ARRAY_NAMESPACE__
 
 #endif /* CUBLAS_IMPL_HPP */
@@ -27,13 +27,16 @@
 #ifndef ARRAY_EXPR_HPP
 #define ARRAY_EXPR_HPP
 
+#include <cmath>
 #include <iostream>
 #include <typeinfo>
 #include <utility>
 #include <type_traits>
+#include <vector>
 
 #include "array-config.hpp"
 #include "array.hpp"
+#include "parallel.hpp"
 //#include "blas.hpp"
 
 
@@ -42,7 +45,6 @@ __BEGIN_ARRAY_NAMESPACE__
 
 using std::cout;
 using std::endl;
-using std::is_arithmetic;
 
 
 //! Expression identity, placeholder for a variable
@@ -144,6 +146,13 @@ struct Expr_traits<Array<d,T> > {
   typedef const Array<d,T>& type;
 };
 
+//! Expression traits partial template specialization for a view, which is
+// stored by value since views are usually temporaries.
+template <int d, typename T>
+struct Expr_traits<View<d,T> > {
+  typedef View<d,T> type;
+};
+
 //! Expression traits partial template specialization for the empty type structure.
 template <>
 struct Expr_traits<EmptyType > {
@@ -168,7 +177,8 @@ public:
   typedef A left_type;
   typedef B right_type;
   typedef Op operator_type;
-  typedef typename Return_type<left_type, right_type, operator_type>::result_type result_type;
+  typedef typename Return_type<typename Leaf_type<left_type>::type,
+  typename Leaf_type<right_type>::type, operator_type>::result_type result_type;
   
   //! Parameter constructor
   BinExprOp(const A& a, const B& b) : a_(a), b_(b) {}
@@ -239,6 +249,48 @@ public:
 };
 
 
+//! Wrapper on an element-wise function of one or two expressions
+/*! \tparam F - Function object applied to each element, or to each pair of
+ * elements
+ * \tparam A - First argument of the function
+ * \tparam B - Second argument of the function, EmptyType for functions of one
+ * argument. Either argument may be a scalar literal.
+ */
+template<class F, class A, class B>
+class FunExprOp {
+  
+  F f_;
+  typename Expr_traits<A>::type a_;
+  typename Expr_traits<B>::type b_;
+  
+public:
+  
+  typedef A left_type;
+  typedef B right_type;
+  typedef ApMap operator_type;
+  typedef typename Return_type<typename Leaf_type<left_type>::type,
+  typename Leaf_type<right_type>::type, operator_type>::result_type result_type;
+  
+  //! Parameter constructor
+  FunExprOp(const F& f, const A& a, const B& b) : f_(f), a_(a), b_(b) {}
+  
+  //! Function object
+  const F& function() const
+  { return f_; }
+  
+  //! First argument
+  auto left() const -> decltype(a_)
+  { return a_; }
+  
+  //! Second argument
+  auto right() const -> decltype(b_)
+  { return b_; }
+  
+  //! Overloaded operator() for evaluating the function
+  result_type operator()() const;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // alias templates
 
@@ -291,6 +343,18 @@ using SEm = Expr< BinExprOp< ExprLiteral<T>, Expr<B>, ApMul> >;
 
 
 
+//! scalar -- view multiplication
+template <int d, typename T>
+using SWm = Expr<BinExprOp<ExprLiteral<T>, View<d,T>, ApMul> >;
+
+//! view transposition
+template <int d, typename T>
+using Wt = Expr<BinExprOp<View<d,T>, EmptyType, ApTr> >;
+
+//! scalar*transposed view multiplication
+template <int d, typename T>
+using SWtm = Expr<BinExprOp<ExprLiteral<T>, Wt<d,T>, ApMul> >;
+
 //! scalar*transposed vector -- scalar matrix multiplication
 template <typename T>
 using SVtmSMmm = Expr<BinExprOp< SVtm<T>, SMm<T>, ApMul> >;
@@ -298,175 +362,1401 @@ using SVtmSMmm = Expr<BinExprOp< SVtm<T>, SMm<T>, ApMul> >;
 
 
 ////////////////////////////////////////////////////////////////////////////////
-// applicative classes
+// element-wise evaluation
 
+//! Number of elements between the first and the last element of an array,
+// plus one
+template <int d, typename T, class S>
+inline size_t extent(const Array<d,T,S>& a)
+{ return a.size(); }
 
+//! Number of elements between the first and the last element of a view, plus
+// one
+template <int d, typename T>
+inline size_t extent(const View<d,T>& v) {
 
-//! Applicative class for the addition operation
-class ApAdd {
-public:
-  
-  ////////////////////////////////////////////////////////////////////////////////
-  // return references
-  
-  //! array -- scalar*array addition
-  template <int d, typename T>
-  static Array<d,T>& apply(Array<d,T>& a, const SAm<d,T>& y) {
-    
-    const Array<d,T>& b = y.right();
-    
-    // size assertion
-    for (size_t i=0; i<d; ++i)
-      assert(a.n_[i] == b.n_[i]);
-    
-    cblas_axpy<T>(a.size(), y.left(), b.data_, 1, a.data_, 1);
-    return a;
-  }
-  
-  //! array -- array addition
-  template <int d, typename T>
-  static Array<d,T> apply(const Array<d,T>& a, const Array<d,T>& b) {
-    
-    // size assertion
-    for (size_t i=0; i<d; ++i)
-      assert(a.n_[i] == b.n_[i]);
-    
-    Array<d,T> r(b);
-    cblas_axpy<T>(a.size(), T(1), a.data_, 1, r.data_, 1);
-    return r;
-  }
-  
-  //! array -- (scalar*array -- scalar*array multiplication) addition
-  template <typename T>
-  static matrix_type<T>& apply(matrix_type<T>& c, const SMmSMmm<T>& y) {
-    
-    // get matrix refernces
-    const matrix_type<T>& a = y.left().right();
-    const matrix_type<T>& b = y.right().right();
-    
-    // check size
-    assert(a.columns() == b.rows());
-    assert(c.rows() == a.rows());
-    assert(c.columns() == b.columns());
-    
-    cblas_gemm<T>(CblasNoTrans, CblasNoTrans, a.rows(), b.columns(),
-               a.columns(), y.left().left()*y.right().left(),
-               a.data_, a.rows(), b.data_, b.rows(), 1.0, c.data_, c.rows());
-    return c;
-  }
-  
-  //! array -- expr addition
-  template<int d, typename T, class B>
-  static Array<d,T>& apply(Array<d,T>& a, const Expr<B>& b) {
-    return a += b();
-  }
-  
-  
-  ////////////////////////////////////////////////////////////////////////////////
-  // return new objects
-  
-  //! scalar*array -- scalar*array addition
-  template <int d, typename T>
-  static Array<d,T> apply(const SAm<d,T>& x, const SAm<d,T>& y) {
-    
-    // get matrix refernces
-    const Array<d,T>& a = x.right();
-    const Array<d,T>& b = y.right();
-    
-    // size assertion
-    for (size_t i=0; i<d; ++i)
-      assert(a.n_[i] == b.n_[i]);
-    
-    // initialize result to first product
-    T s = x.left();
-    Array<d,T> r = s*a;
-    
-    // add second product
-    cblas_axpy<T>(a.size(), y.left(), b.data_, 1, r.data_, 1);
-    return r;
-  }
-  
-  //! expr -- expr addition
-  template<class A, class B>
-  static typename Return_type<Expr<A>, Expr<B>, ApAdd>::result_type
-  apply(const Expr<A>& a, const Expr<B>& b) {
-    return a()+b();
-  }
+  size_t e = 1;
+  for (int i=0; i<d; ++i)
+    e += (v.size(i) - 1)*v.stride(i);
+  return e;
+}
+
+//! Helper function that determines whether two arrays or views share memory
+template <class A, class B>
+inline bool overlap(const A& a, const B& b) {
+
+  const typename A::value_type* pa = a.data();
+  const typename B::value_type* pb = b.data();
+  return pa && pb && pa < pb + extent(b) && pb < pa + extent(a);
+}
+
+//! Helper function that determines whether two arrays or views refer to the
+// same elements in the same order
+template <class A, class B>
+inline bool same_layout(const A& a, const B& b) {
+
+  if (A::rank() != B::rank() || a.data() != b.data())
+    return false;
+  for (int i=0; i<A::rank(); ++i)
+    if (a.size(i) != b.size(i) || a.stride(i) != b.stride(i))
+      return false;
+  return true;
+}
+
+
+//! Element-wise traits class template
+/*! Determines whether an expression is made only of additions, subtractions
+ * and scalings of arrays of the same shape, in which case it can be evaluated
+ * element by element in a single loop without creating temporaries. The
+ * expression is linear if all its operands are stored in the same order as
+ * the result, so that it can be traversed with a single index; transposed
+ * matrices are read in place with swapped strides instead.
+ */
+template <class E>
+struct Elementwise_traits {
+  enum { value = false, linear = false };
 };
 
-//! Applicative class for the subtraction operation
-class ApSub {
-public:
-  
-  //! array -- array subtraction
-  template <int d, typename T>
-  static Array<d,T> apply(const Array<d,T>& a, const Array<d,T>& b) {
-    
-    // size assertion
-    for (size_t i=0; i<d; ++i)
-      assert(a.n_[i] == b.n_[i]);
-    
-    Array<d,T> r(a);
-    cblas_axpy<T>(r.size(), T(-1), b.data_, 1, r.data_, 1);
-    return r;
-  }
-  
-  //! expr -- expr subtraction
-  template<class A, class B>
-  static typename Return_type<Expr<A>, Expr<B>, ApSub>::result_type
-  apply(const Expr<A>& a, const Expr<B>& b) {
-    return a()-b();
-  }
+//! Element-wise traits partial template specialization for arrays
+template <int d, typename T>
+struct Elementwise_traits<Array<d,T> > {
+  enum { value = true, linear = true };
 };
 
-//! Applicative class for the multiplication operation
-class ApMul {
-public:
-  
-  //! scalar types
-  template <typename T>
-  static ExprLiteral<T> apply(const ExprLiteral<T>& a, const ExprLiteral<T>& b)
-  { return ExprLiteral<T>(a*b); }
+//! Element-wise traits partial template specialization for transposed matrices
+template <typename T>
+struct Elementwise_traits<BinExprOp<Array<2,T>, EmptyType, ApTr> > {
+  enum { value = true, linear = false };
+};
 
-  //! scalar -- array multiplication
-  template <int d, typename T>
-  static Array<d,T> apply(const ExprLiteral<T>& a, const Array<d,T>& b) {
-    
-    // \todo this could be replaced by combining the constructor and
-    // initialization using the scalar
-    Array<d,T> r(b);
-    cblas_scal<T>(b.size(), a, r.data_, 1);
-    return r;
-  }
+//! Element-wise traits partial template specialization for views, matrix
+// views are traversed with two indices
+template <int d, typename T>
+struct Elementwise_traits<View<d,T> > {
+  enum { value = true, linear = d != 2 };
+};
 
-  //! expression -- scalar multiplication
-  template <typename T, class A>
-  static auto apply(const Expr<A> &a, const ExprLiteral<T> &b)
-  -> decltype(a()) {
-    return a()*b();
-  }
+//! Element-wise traits partial template specialization for transposed matrix
+// views
+template <typename T>
+struct Elementwise_traits<BinExprOp<View<2,T>, EmptyType, ApTr> > {
+  enum { value = true, linear = false };
+};
 
-  //! scalar -- expression multiplication
-  template <typename T, class B>
-  static auto apply(const ExprLiteral<T> &a, const Expr<B> &b)
-  -> decltype(b()) {
-    return a()*b();
-  }
+//! Element-wise traits partial template specialization for expressions
+template <class A>
+struct Elementwise_traits<Expr<A> > {
+  enum { value = Elementwise_traits<A>::value, linear = Elementwise_traits<A>::linear };
+};
 
-  //! scalar -- array addition multiplication
-  template <int d, typename T>
-  static Array<d,T> apply(const ExprLiteral<T> &a, const AAa<d, T> &b) {
-    
-    Array<d, T> r = b();
-    cblas_scal<T>(r.size(), a, r.data_, 1);
-    return r;
+//! Element-wise traits partial template specialization for additions
+template <class A, class B>
+struct Elementwise_traits<BinExprOp<A, B, ApAdd> > {
+  enum { value = Elementwise_traits<A>::value && Elementwise_traits<B>::value,
+    linear = Elementwise_traits<A>::linear && Elementwise_traits<B>::linear };
+};
+
+//! Element-wise traits partial template specialization for subtractions
+template <class A, class B>
+struct Elementwise_traits<BinExprOp<A, B, ApSub> > {
+  enum { value = Elementwise_traits<A>::value && Elementwise_traits<B>::value,
+    linear = Elementwise_traits<A>::linear && Elementwise_traits<B>::linear };
+};
+
+//! Element-wise traits partial template specialization for scalings
+template <typename S, class B>
+struct Elementwise_traits<BinExprOp<ExprLiteral<S>, B, ApMul> > {
+  enum { value = Elementwise_traits<B>::value, linear = Elementwise_traits<B>::linear };
+};
+
+
+//! Element-wise evaluator, declared but only defined for the expressions for
+// which Elementwise_traits is true.
+/*! The evaluator is built once from the expression tree and stores raw
+ * pointers and scalars only, so that operator[] (linear expressions) and
+ * operator()(i,j) (matrix expressions) inline into a single loop over the
+ * destination.
+ */
+template <class E>
+struct Elementwise;
+
+//! Element-wise evaluator partial template specialization for arrays
+template <int d, typename T>
+struct Elementwise<Array<d,T> > {
+
+  typedef T value_type;
+  typedef Array<d,T> result_type;
+
+  explicit Elementwise(const Array<d,T>& a) : a_(a), p_(a.data()), ld_(a.size(0)) {}
+
+  //! Size of the expression along the ith direction
+  size_t size(size_t i) const
+  { return a_.size(i); }
+
+  //! Arrays are read at the same position that is written, unless the
+  // destination is a view of a different part of the same memory
+  template <class R>
+  bool aliased(const R& dst) const
+  { return overlap(a_, dst) && !same_layout(a_, dst); }
+
+  value_type operator[](size_t i) const
+  { return p_[i]; }
+
+  value_type operator()(size_t i, size_t j) const
+  { return p_[i + j*ld_]; }
+
+private:
+  const Array<d,T>& a_;
+  const T* p_;
+  size_t ld_;
+};
+
+//! Element-wise evaluator partial template specialization for transposed
+// matrices, which are read in place with swapped strides
+template <typename T>
+struct Elementwise<BinExprOp<Array<2,T>, EmptyType, ApTr> > {
+
+  typedef T value_type;
+  typedef Array<2,T> result_type;
+
+  explicit Elementwise(const BinExprOp<Array<2,T>, EmptyType, ApTr>& e)
+  : a_(e.left()), p_(a_.data()), ld_(a_.rows()) {}
+
+  size_t size(size_t i) const
+  { return a_.size(1 - i); }
+
+  //! A transposed matrix that shares memory with the destination would be
+  // overwritten before it is read
+  template <class R>
+  bool aliased(const R& dst) const
+  { return overlap(a_, dst); }
+
+  value_type operator()(size_t i, size_t j) const
+  { return p_[j + i*ld_]; }
+
+private:
+  const Array<2,T>& a_;
+  const T* p_;
+  size_t ld_;
+};
+
+//! Element-wise evaluator partial template specialization for views
+/*! Vectors and tensors of rank greater than two are read with a single index,
+ * which is split into the indices along each dimension for the latter.
+ */
+template <int d, typename T>
+struct Elementwise<View<d,T> > {
+
+  typedef T value_type;
+  typedef Array<d,T> result_type;
+
+  explicit Elementwise(const View<d,T>& v) : v_(v), p_(v.data()) {}
+
+  size_t size(size_t i) const
+  { return v_.size(i); }
+
+  //! A view is read at the same position that is written only if the
+  // destination refers to the same elements
+  template <class R>
+  bool aliased(const R& dst) const
+  { return overlap(v_, dst) && !same_layout(v_, dst); }
+
+  value_type operator[](size_t i) const {
+
+    if (d == 1)
+      return p_[i*v_.stride(0)];
+
+    size_t o = 0;
+    for (int j=0; j<d; ++j) {
+      o += (i % v_.size(j))*v_.stride(j);
+      i /= v_.size(j);
+    }
+    return p_[o];
   }
-  
-  //! scalar -- transposed array multiplication
-  template <int d, typename T>
-  static Array<d,T> apply(const ExprLiteral<T>& a, const At<d,T>& b) {
-    T s = a;
-    return s * b();
+
+  value_type operator()(size_t i, size_t j) const
+  { return p_[i*v_.stride(0) + j*v_.stride(d - 1)]; }
+
+private:
+  View<d,T> v_;
+  const T* p_;
+};
+
+//! Element-wise evaluator partial template specialization for transposed
+// matrix views
+template <typename T>
+struct Elementwise<BinExprOp<View<2,T>, EmptyType, ApTr> > {
+
+  typedef T value_type;
+  typedef Array<2,T> result_type;
+
+  explicit Elementwise(const BinExprOp<View<2,T>, EmptyType, ApTr>& e)
+  : v_(e.left()), p_(v_.data()) {}
+
+  size_t size(size_t i) const
+  { return v_.size(1 - i); }
+
+  template <class R>
+  bool aliased(const R& dst) const
+  { return overlap(v_, dst); }
+
+  value_type operator()(size_t i, size_t j) const
+  { return p_[j*v_.stride(0) + i*v_.stride(1)]; }
+
+private:
+  View<2,T> v_;
+  const T* p_;
+};
+
+//! Element-wise evaluator partial template specialization for expressions
+template <class A>
+struct Elementwise<Expr<A> > : public Elementwise<A> {
+
+  explicit Elementwise(const Expr<A>& e) : Elementwise<A>(e.expr()) {}
+};
+
+//! Element-wise evaluator partial template specialization for scalings
+template <typename S, class B>
+struct Elementwise<BinExprOp<ExprLiteral<S>, B, ApMul> > {
+
+  typedef typename Elementwise<B>::value_type value_type;
+  typedef typename Elementwise<B>::result_type result_type;
+
+  Elementwise(const ExprLiteral<S>& s, const B& b) : s_(s), b_(b) {}
+
+  explicit Elementwise(const BinExprOp<ExprLiteral<S>, B, ApMul>& e)
+  : s_(e.left()), b_(e.right()) {}
+
+  size_t size(size_t i) const
+  { return b_.size(i); }
+
+  template <class R>
+  bool aliased(const R& dst) const
+  { return b_.aliased(dst); }
+
+  value_type operator[](size_t i) const
+  { return s_ * b_[i]; }
+
+  value_type operator()(size_t i, size_t j) const
+  { return s_ * b_(i,j); }
+
+private:
+  value_type s_;
+  Elementwise<B> b_;
+};
+
+//! Element-wise evaluator base class template for binary operations between
+// arrays of the same shape
+template <class A, class B>
+struct Elementwise_binary {
+
+  typedef typename Elementwise<A>::value_type value_type;
+  typedef typename Elementwise<A>::result_type result_type;
+
+  Elementwise_binary(const A& a, const B& b) : a_(a), b_(b) {
+
+    // size assertion
+    for (int i=0; i<result_type::rank(); ++i)
+      assert(a_.size(i) == b_.size(i));
+  }
+
+  size_t size(size_t i) const
+  { return a_.size(i); }
+
+  template <class R>
+  bool aliased(const R& dst) const
+  { return a_.aliased(dst) || b_.aliased(dst); }
+
+protected:
+  Elementwise<A> a_;
+  Elementwise<B> b_;
+};
+
+//! Element-wise evaluator partial template specialization for additions
+template <class A, class B>
+struct Elementwise<BinExprOp<A, B, ApAdd> > : public Elementwise_binary<A,B> {
+
+  typedef typename Elementwise_binary<A,B>::value_type value_type;
+
+  Elementwise(const A& a, const B& b) : Elementwise_binary<A,B>(a,b) {}
+
+  explicit Elementwise(const BinExprOp<A, B, ApAdd>& e)
+  : Elementwise_binary<A,B>(e.left(), e.right()) {}
+
+  value_type operator[](size_t i) const
+  { return this->a_[i] + this->b_[i]; }
+
+  value_type operator()(size_t i, size_t j) const
+  { return this->a_(i,j) + this->b_(i,j); }
+};
+
+//! Element-wise evaluator partial template specialization for subtractions
+template <class A, class B>
+struct Elementwise<BinExprOp<A, B, ApSub> > : public Elementwise_binary<A,B> {
+
+  typedef typename Elementwise_binary<A,B>::value_type value_type;
+
+  Elementwise(const A& a, const B& b) : Elementwise_binary<A,B>(a,b) {}
+
+  explicit Elementwise(const BinExprOp<A, B, ApSub>& e)
+  : Elementwise_binary<A,B>(e.left(), e.right()) {}
+
+  value_type operator[](size_t i) const
+  { return this->a_[i] - this->b_[i]; }
+
+  value_type operator()(size_t i, size_t j) const
+  { return this->a_(i,j) - this->b_(i,j); }
+};
+
+
+//! Argument traits class template for element-wise functions
+/*! Arrays, views and expressions are evaluated element by element, and
+ * scalars are repeated for every element.
+ */
+template <class X, class = void>
+struct Function_argument {
+  enum { value = false, scalar = false };
+};
+
+//! Argument traits partial template specialization for arrays
+template <int d, typename T>
+struct Function_argument<Array<d,T> > {
+  enum { value = true, scalar = false };
+  typedef Array<d,T> type;
+};
+
+//! Argument traits partial template specialization for views
+template <int d, typename T>
+struct Function_argument<View<d,T> > {
+  enum { value = true, scalar = false };
+  typedef View<d,T> type;
+};
+
+//! Argument traits partial template specialization for expressions
+template <class A>
+struct Function_argument<Expr<A> > {
+  enum { value = true, scalar = false };
+  typedef Expr<A> type;
+};
+
+//! Argument traits partial template specialization for scalars
+template <typename S>
+struct Function_argument<S, typename std::enable_if<Is_scalar<S>::value>::type> {
+  enum { value = true, scalar = true };
+  typedef ExprLiteral<S> type;
+};
+
+//! Argument traits partial template specialization for scalar literals
+template <typename S>
+struct Function_argument<ExprLiteral<S> > {
+  enum { value = true, scalar = true };
+  typedef ExprLiteral<S> type;
+};
+
+//! Vectorized function traits class template
+/*! Determines whether function object F evaluates many elements of type T at
+ * once through a static member apply(n, x, y), e.g., the exponential and the
+ * logarithm of floating point numbers (see Simd). Linear expressions then
+ * evaluate the argument of the function in short chunks, which stay in cache,
+ * and apply the function to each chunk.
+ */
+template <class F, typename T>
+struct Vectorized_function : public std::false_type {};
+
+//! Element-wise traits partial template specialization for functions, where
+// scalars and the missing second argument of unary functions are read at any
+// position. At least one of the arguments is an array.
+template <class F, class A, class B>
+struct Elementwise_traits<FunExprOp<F, A, B> > {
+
+  template <class X>
+  struct constant {
+    enum { value = Function_argument<X>::scalar || std::is_same<X, EmptyType>::value };
+  };
+
+  enum { value = (constant<A>::value || Elementwise_traits<A>::value) &&
+    (constant<B>::value || Elementwise_traits<B>::value) &&
+    !(constant<A>::value && constant<B>::value),
+    linear = (constant<A>::value || Elementwise_traits<A>::linear) &&
+    (constant<B>::value || Elementwise_traits<B>::linear) };
+};
+
+//! Element-wise evaluator for the arguments of functions
+template <class X, typename T>
+struct Elementwise_argument : public Elementwise<X> {
+
+  explicit Elementwise_argument(const X& x) : Elementwise<X>(x) {}
+};
+
+//! Element-wise evaluator for scalar arguments, converted to the element type
+// of the other argument
+template <typename S, typename T>
+struct Elementwise_argument<ExprLiteral<S>, T> {
+
+  explicit Elementwise_argument(const ExprLiteral<S>& s) : s_(s) {}
+
+  size_t size(size_t) const
+  { return 0; }
+
+  template <class R>
+  bool aliased(const R&) const
+  { return false; }
+
+  T operator[](size_t) const
+  { return s_; }
+
+  T operator()(size_t, size_t) const
+  { return s_; }
+
+private:
+  T s_;
+};
+
+//! Element-wise evaluator base class template for functions of one argument
+template <class F, class A,
+          bool = Vectorized_function<F, typename Elementwise<A>::value_type>::value>
+struct Elementwise_unary {
+
+  typedef typename Elementwise<A>::value_type value_type;
+  typedef typename Elementwise<A>::result_type result_type;
+
+  Elementwise_unary(const F& f, const A& a) : f_(f), a_(a) {}
+
+  size_t size(size_t i) const
+  { return a_.size(i); }
+
+  template <class R>
+  bool aliased(const R& dst) const
+  { return a_.aliased(dst); }
+
+  value_type operator[](size_t i) const
+  { return value_type(f_(a_[i])); }
+
+  value_type operator()(size_t i, size_t j) const
+  { return value_type(f_(a_(i,j))); }
+
+protected:
+  F f_;
+  Elementwise<A> a_;
+};
+
+//! Element-wise evaluator base class template for vectorized functions of one
+// argument
+/*! Linear traversals read the elements in increasing order, so the argument
+ * is evaluated one chunk ahead into a buffer, to which the function is applied
+ * at once. Matrix traversals evaluate the function element by element.
+ */
+template <class F, class A>
+struct Elementwise_unary<F, A, true> : public Elementwise_unary<F, A, false> {
+
+  typedef Elementwise_unary<F, A, false> base_type;
+  typedef typename base_type::value_type value_type;
+  typedef typename base_type::result_type result_type;
+
+  Elementwise_unary(const F& f, const A& a) : base_type(f, a), first_(), last_() {}
+
+  value_type operator[](size_t i) const {
+    if (i < first_ || i >= last_)
+      fill(i);
+    return buffer_[i - first_];
+  }
+
+private:
+
+  //! Number of elements evaluated at once
+  static constexpr size_t chunk_size = 256;
+
+  //! Evaluate the chunk that starts at element i
+  void fill(size_t i) const {
+
+    size_t n = 1;
+    for (int j=0; j<result_type::rank(); ++j)
+      n *= this->size(j);
+
+    first_ = i;
+    last_ = n - i < chunk_size ? n : i + chunk_size;
+    for (size_t j=first_; j<last_; ++j)
+      buffer_[j - first_] = this->a_[j];
+    F::apply(last_ - first_, buffer_, buffer_);
+  }
+
+  mutable value_type buffer_[chunk_size];
+  mutable size_t first_, last_;
+};
+
+//! Element-wise evaluator partial template specialization for functions of
+// one argument
+template <class F, class A>
+struct Elementwise<FunExprOp<F, A, EmptyType> > : public Elementwise_unary<F, A> {
+
+  explicit Elementwise(const FunExprOp<F, A, EmptyType>& e)
+  : Elementwise_unary<F, A>(e.function(), e.left()) {}
+};
+
+//! Element-wise evaluator partial template specialization for functions of
+// two arguments, of which one may be a scalar
+template <class F, class A, class B>
+struct Elementwise<FunExprOp<F, A, B> > {
+
+  typedef typename Elementwise<typename std::conditional<
+  Function_argument<A>::scalar, B, A>::type>::value_type value_type;
+  typedef typename Elementwise<typename std::conditional<
+  Function_argument<A>::scalar, B, A>::type>::result_type result_type;
+
+  explicit Elementwise(const FunExprOp<F, A, B>& e)
+  : f_(e.function()), a_(e.left()), b_(e.right()) {
+
+    // size assertion
+    for (int i=0; i<result_type::rank(); ++i)
+      assert(Function_argument<A>::scalar || Function_argument<B>::scalar ||
+             a_.size(i) == b_.size(i));
+  }
+
+  size_t size(size_t i) const
+  { return Function_argument<A>::scalar ? b_.size(i) : a_.size(i); }
+
+  template <class R>
+  bool aliased(const R& dst) const
+  { return a_.aliased(dst) || b_.aliased(dst); }
+
+  value_type operator[](size_t i) const
+  { return value_type(f_(a_[i], b_[i])); }
+
+  value_type operator()(size_t i, size_t j) const
+  { return value_type(f_(a_(i,j), b_(i,j))); }
+
+private:
+  F f_;
+  Elementwise_argument<A, value_type> a_;
+  Elementwise_argument<B, value_type> b_;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// product traits
+
+//! Operand traits class template
+/*! Describes the operands of a product that can be handed over directly to a
+ * level 2 or level 3 BLAS routine, i.e., scaled (and possibly transposed)
+ * vectors and matrices.
+ */
+template <class X>
+struct Operand_traits {
+  enum { value = false, rank = 0, transposed = false };
+};
+
+//! Operand traits partial template specialization for scalar*array
+template <int d, typename T>
+struct Operand_traits<SAm<d,T> > {
+
+  enum { value = d == 1 || d == 2, rank = d, transposed = false };
+
+  typedef Array<d,T> array_type;
+
+  static const array_type& array(const SAm<d,T>& x)
+  { return x.right(); }
+
+  static T scalar(const SAm<d,T>& x)
+  { return x.left(); }
+};
+
+//! Operand traits partial template specialization for scalar*transposed array
+template <int d, typename T>
+struct Operand_traits<Expr<BinExprOp<ExprLiteral<T>, At<d,T>, ApMul> > > {
+
+  enum { value = d == 1 || d == 2, rank = d, transposed = true };
+
+  typedef Array<d,T> array_type;
+  typedef Expr<BinExprOp<ExprLiteral<T>, At<d,T>, ApMul> > operand_type;
+
+  static const array_type& array(const operand_type& x)
+  { return x.right().left(); }
+
+  static T scalar(const operand_type& x)
+  { return x.left(); }
+};
+
+//! Operand traits partial template specialization for scalar*view
+template <int d, typename T>
+struct Operand_traits<SWm<d,T> > {
+
+  enum { value = d == 1 || d == 2, rank = d, transposed = false };
+
+  typedef View<d,T> array_type;
+
+  static array_type array(const SWm<d,T>& x)
+  { return x.right(); }
+
+  static T scalar(const SWm<d,T>& x)
+  { return x.left(); }
+};
+
+//! Operand traits partial template specialization for scalar*transposed view
+template <int d, typename T>
+struct Operand_traits<SWtm<d,T> > {
+
+  enum { value = d == 1 || d == 2, rank = d, transposed = true };
+
+  typedef View<d,T> array_type;
+
+  static array_type array(const SWtm<d,T>& x)
+  { return x.right().left(); }
+
+  static T scalar(const SWtm<d,T>& x)
+  { return x.left(); }
+};
+
+
+//! Product traits class template
+/*! Determines whether an expression is a matrix--matrix, matrix--vector or
+ * vector--vector outer product (or a scaled sum of those) that can be
+ * evaluated by BLAS directly into the destination, i.e.,
+ * \f$ C \leftarrow \alpha \text{op}(A)\text{op}(B) + \beta C \f$.
+ */
+template <class E>
+struct Product_traits {
+  enum { value = false };
+};
+
+//! Product traits partial template specialization for expressions
+template <class A>
+struct Product_traits<Expr<A> > {
+  enum { value = Product_traits<A>::value };
+};
+
+//! Product traits partial template specialization for multiplications
+template <class X, class Y>
+struct Product_traits<BinExprOp<X, Y, ApMul> > {
+
+  typedef Operand_traits<X> left_traits;
+  typedef Operand_traits<Y> right_traits;
+
+  enum { value = left_traits::value && right_traits::value &&
+    // gemm
+    ((left_traits::rank == 2 && right_traits::rank == 2) ||
+     // gemv
+     (left_traits::rank == 2 && right_traits::rank == 1 && !right_traits::transposed) ||
+     // ger
+     (left_traits::rank == 1 && !left_traits::transposed &&
+      right_traits::rank == 1 && right_traits::transposed)) };
+};
+
+//! Product traits partial template specialization for scalings
+template <typename S, class P>
+struct Product_traits<BinExprOp<ExprLiteral<S>, Expr<P>, ApMul> > {
+  enum { value = Product_traits<P>::value };
+};
+
+//! Product traits partial template specialization for additions
+template <class A, class B>
+struct Product_traits<BinExprOp<A, B, ApAdd> > {
+  enum { value = Product_traits<A>::value && Product_traits<B>::value };
+};
+
+//! Product traits partial template specialization for subtractions
+template <class A, class B>
+struct Product_traits<BinExprOp<A, B, ApSub> > {
+  enum { value = Product_traits<A>::value && Product_traits<B>::value };
+};
+
+
+//! Update traits class template
+/*! Determines whether an expression is the sum or difference of a product and
+ * an element-wise expression, e.g., \f$ \alpha AB + \beta C \f$ or
+ * \f$ b - Ax \f$. Such expressions are evaluated by writing the element-wise
+ * part into the destination first and then accumulating the product on top of
+ * it with \f$ \beta = 1 \f$.
+ */
+template <class E>
+struct Update_traits {
+  enum { value = false };
+};
+
+//! Update traits partial template specialization for expressions
+template <class A>
+struct Update_traits<Expr<A> > {
+  enum { value = Update_traits<A>::value };
+};
+
+//! Update traits partial template specialization for additions
+template <class A, class B>
+struct Update_traits<BinExprOp<A, B, ApAdd> > {
+  enum { value = (Product_traits<A>::value && Elementwise_traits<B>::value) ||
+    (Elementwise_traits<A>::value && Product_traits<B>::value) };
+};
+
+//! Update traits partial template specialization for subtractions
+template <class A, class B>
+struct Update_traits<BinExprOp<A, B, ApSub> > {
+  enum { value = (Product_traits<A>::value && Elementwise_traits<B>::value) ||
+    (Elementwise_traits<A>::value && Product_traits<B>::value) };
+};
+
+
+//! Chain traits class template
+/*! Determines whether an expression is a chain of products of matrix
+ * operands, e.g., A*B*transpose(C) or A*B*C*x, where a vector can only be the
+ * last factor. The factors are collected at evaluation time so that the chain
+ * is multiplied in the cheapest order instead of from left to right.
+ */
+template <class E, bool operand = Operand_traits<E>::value>
+struct Chain_traits {
+  enum { value = false, length = 0, vector = false };
+};
+
+//! Chain traits partial template specialization for operands
+template <class E>
+struct Chain_traits<E, true> {
+
+  typedef Operand_traits<E> operand_traits;
+
+  enum { value = operand_traits::rank == 2 || !operand_traits::transposed,
+    length = 1, vector = operand_traits::rank == 1 };
+
+  template <class C>
+  static void collect(const E& e, C& c) {
+    c.push(operand_traits::array(e), operand_traits::transposed,
+           operand_traits::scalar(e));
+  }
+};
+
+//! Chain traits partial template specialization for multiplications
+template <class X, class Y>
+struct Chain_traits<Expr<BinExprOp<X, Y, ApMul> >, false> {
+
+  typedef Chain_traits<X> left_traits;
+  typedef Chain_traits<Y> right_traits;
+
+  enum { value = left_traits::value && right_traits::value && !left_traits::vector,
+    length = left_traits::length + right_traits::length,
+    vector = right_traits::vector };
+
+  template <class C>
+  static void collect(const Expr<BinExprOp<X, Y, ApMul> >& e, C& c) {
+    left_traits::collect(e.left(), c);
+    right_traits::collect(e.right(), c);
+  }
+};
+
+
+//! Evaluation kinds, used to dispatch the evaluation of an expression
+enum Evaluation_kind {
+  Temporary_evaluation,
+  Elementwise_evaluation,
+  Product_evaluation,
+  Update_evaluation
+};
+
+//! Evaluation traits class template
+/*! Selects how an expression is evaluated into an existing or a new array. The
+ * fallback, Temporary_evaluation, evaluates the branches of the expression
+ * into temporaries.
+ */
+template <class E>
+struct Evaluation_traits {
+  enum { value = Elementwise_traits<E>::value ? Elementwise_evaluation :
+    Product_traits<E>::value ? Product_evaluation :
+    Update_traits<E>::value ? Update_evaluation : Temporary_evaluation };
+};
+
+
+//! Product evaluator, declared but only defined for the expressions for which
+// Product_traits is true.
+/*! Every specialization provides the result type of the product, checks for
+ * the shape and aliasing of a destination array, and the evaluation of the
+ * product into a destination array with arbitrary \f$ \alpha \f$ and
+ * \f$ \beta \f$ factors.
+ */
+template <class E>
+struct Product;
+
+//! Update evaluator, declared but only defined for the expressions for which
+// Update_traits is true.
+template <class E>
+struct Update;
+
+//! Product chain evaluator, for the expressions for which Chain_traits is true
+template <typename T>
+class Chain;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// applicative classes
+
+
+//! Applicative class for the fused evaluation of element-wise expressions
+/*! Writes the result of an element-wise expression directly into the
+ * destination, so that an expression like a + 2*b - c + d is evaluated in a
+ * single pass over memory.
+ */
+class ApElementwise {
+public:
+
+  //! Evaluate an element-wise expression into a new array
+  template <class E>
+  static typename Elementwise<E>::result_type apply(const Elementwise<E>& ev) {
+
+    typedef typename Elementwise<E>::result_type result_type;
+
+    result_type r;
+    for (int i=0; i<result_type::rank(); ++i)
+      r.n_[i] = ev.size(i);
+    r.data_ = result_type::allocate(r.init_strides());
+
+    assign(r, ev);
+    return r;
+  }
+
+  //! Evaluate an element-wise expression into an existing array
+  template <int d, typename T, class S, class E>
+  static Array<d,T,S>& assign(Array<d,T,S>& r, const Elementwise<E>& ev) {
+
+    if (ev.aliased(r)) {
+      Array<d,T> t = apply(ev);
+      return assign(r, Elementwise<Array<d,T> >(t));
+    }
+    traverse(r, ev, Assign_op(), Int2Type<Elementwise_traits<E>::linear>());
+    return r;
+  }
+
+  //! Add an element-wise expression to an existing array
+  template <int d, typename T, class S, class E>
+  static Array<d,T,S>& add(Array<d,T,S>& r, const Elementwise<E>& ev) {
+
+    if (ev.aliased(r)) {
+      Array<d,T> t = apply(ev);
+      return add(r, Elementwise<Array<d,T> >(t));
+    }
+    traverse(r, ev, Add_op(), Int2Type<Elementwise_traits<E>::linear>());
+    return r;
+  }
+
+  //! Evaluate an element-wise expression into the elements of a view
+  template <int d, typename T, class E>
+  static View<d,T>& assign(View<d,T>& r, const Elementwise<E>& ev) {
+
+    if (ev.aliased(r)) {
+      Array<d,T> t = apply(ev);
+      return assign(r, Elementwise<Array<d,T> >(t));
+    }
+    traverse(r, ev, Assign_op(), Int2Type<d>());
+    return r;
+  }
+
+  //! Add an element-wise expression to the elements of a view
+  template <int d, typename T, class E>
+  static View<d,T>& add(View<d,T>& r, const Elementwise<E>& ev) {
+
+    if (ev.aliased(r)) {
+      Array<d,T> t = apply(ev);
+      return add(r, Elementwise<Array<d,T> >(t));
+    }
+    traverse(r, ev, Add_op(), Int2Type<d>());
+    return r;
+  }
+
+private:
+
+  //! Tile size of the blocked traversal
+  static constexpr size_t tile_size = 32;
+
+  //! Minimum number of elements for which the blocked traversal is threaded
+  static constexpr size_t parallel_size = 1 << 16;
+
+  struct Assign_op {
+    template <typename T>
+    void operator()(T& x, T y) const { x = y; }
+  };
+
+  struct Add_op {
+    template <typename T>
+    void operator()(T& x, T y) const { x += y; }
+  };
+
+  //! Linear traversal, a single loop over contiguous memory
+  /*! Large arrays are split in cache-sized chunks that are evaluated
+   * concurrently. Evaluators of functions buffer the elements they read
+   * ahead, so each chunk is evaluated with its own copy of the evaluator.
+   */
+  template <int d, typename T, class S, class E, class Op>
+  static void traverse(Array<d,T,S>& r, const Elementwise<E>& ev, Op op, Int2Type<true>) {
+
+    T* p = r.data_;
+    const size_t n = r.size();
+    if (n < parallel_size) {
+      for (size_t i=0; i<n; ++i)
+        op(p[i], ev[i]);
+      return;
+    }
+
+    const size_t chunk = cache_chunk<T>();
+    parallel_for(0, (n + chunk - 1) / chunk, [=, &ev](size_t c) {
+      const Elementwise<E> local(ev);
+      const size_t b = c*chunk, e = std::min(b + chunk, n);
+      for (size_t i=b; i<e; ++i)
+        op(p[i], local[i]);
+    });
+  }
+
+  //! Blocked traversal for matrix expressions with transposed operands
+  /*! The destination is visited in square tiles so that the operands read
+   * with swapped strides stay within a few cache lines and pages while a tile
+   * is written. Column blocks of large matrices are evaluated concurrently.
+   */
+  template <typename T, class S, class E, class Op>
+  static void traverse(Array<2,T,S>& r, const Elementwise<E>& ev, Op op, Int2Type<false>)
+  { blocked(r.data_, r.rows(), r.columns(), 1, r.rows(), ev, op); }
+
+  //! Strided traversal of a vector view
+  template <typename T, class E, class Op>
+  static void traverse(View<1,T>& r, const Elementwise<E>& ev, Op op, Int2Type<1>) {
+
+    T* p = r.data();
+    const size_t n = r.size(), s = r.stride(0);
+    for (size_t i=0; i<n; ++i)
+      op(p[i*s], ev[i]);
+  }
+
+  //! Blocked traversal of a matrix view
+  template <typename T, class E, class Op>
+  static void traverse(View<2,T>& r, const Elementwise<E>& ev, Op op, Int2Type<2>)
+  { blocked(r.data(), r.rows(), r.columns(), r.stride(0), r.stride(1), ev, op); }
+
+  //! Traversal of a view of higher rank, the indices along each dimension are
+  // advanced like an odometer
+  template <int d, typename T, class E, class Op>
+  static void traverse(View<d,T>& r, const Elementwise<E>& ev, Op op, Int2Type<d>) {
+
+    T* p = r.data();
+    size_t idx[d] = {}, o = 0;
+    const size_t n = r.size();
+    for (size_t i=0; i<n; ++i) {
+      op(p[o], ev[i]);
+      for (int j=0; j<d; ++j) {
+        o += r.stride(j);
+        if (++idx[j] < r.size(j))
+          break;
+        o -= idx[j]*r.stride(j);
+        idx[j] = 0;
+      }
+    }
+  }
+
+  //! Blocked traversal of a matrix stored with row stride rs and column
+  // stride cs
+  template <typename T, class E, class Op>
+  static void blocked(T* p, size_t m, size_t n, size_t rs, size_t cs,
+                      const Elementwise<E>& ev, Op op) {
+
+    auto column_block = [=, &ev](size_t b) {
+
+      const size_t j0 = b*tile_size, j1 = std::min(j0 + tile_size, n);
+      for (size_t i0=0; i0<m; i0 += tile_size) {
+        const size_t i1 = std::min(i0 + tile_size, m);
+        for (size_t j=j0; j<j1; ++j)
+          for (size_t i=i0; i<i1; ++i)
+            op(p[i*rs + j*cs], ev(i,j));
+      }
+    };
+
+    const size_t blocks = (n + tile_size - 1) / tile_size;
+    if (m*n < parallel_size)
+      for (size_t b=0; b<blocks; ++b)
+        column_block(b);
+    else
+      parallel_for(0, blocks, column_block);
+  }
+};
+
+
+//! Applicative class for the assignment of expressions
+/*! Dispatches on Evaluation_traits so that element-wise expressions, products
+ * and updates are written directly into the memory of the destination array
+ * whenever it has the right shape and does not alias the operands of a
+ * product. Otherwise the result is evaluated into a new array and moved into
+ * the destination.
+ */
+class ApAssign {
+public:
+
+  //! array -- expression assignment
+  template <int d, typename T, class S, class A>
+  static Array<d,T,S>& apply(Array<d,T,S>& r, const Expr<A>& e) {
+    return apply(r, e, Int2Type<Evaluation_traits<A>::value>());
+  }
+
+  //! view -- expression assignment
+  /*! The view cannot be resized, so the expression has to conform to it.
+   * Products are evaluated in place unless they read from the view.
+   */
+  template <int d, typename T, class A>
+  static View<d,T>& apply(View<d,T>& r, const Expr<A>& e) {
+    return apply(r, e, Int2Type<Evaluation_traits<A>::value>());
+  }
+
+  //! Evaluate an expression into a new array without temporaries
+  template <class E>
+  static typename E::result_type evaluate(const E& e) {
+    return evaluate(e, Int2Type<Evaluation_traits<E>::value>());
+  }
+
+private:
+
+  //! Determines whether the memory of an array can be overwritten
+  template <int d, typename T, class S>
+  static bool reusable(const Array<d,T,S>& r)
+  { return r.data_ && !r.wrapped_; }
+
+  //! array -- element-wise expression assignment
+  template <int d, typename T, class S, class A>
+  static Array<d,T,S>& apply(Array<d,T,S>& r, const Expr<A>& e,
+                             Int2Type<Elementwise_evaluation>) {
+
+    Elementwise<A> ev(e.expr());
+
+    bool conforms = reusable(r);
+    for (int i=0; i<d; ++i)
+      conforms = conforms && r.n_[i] == ev.size(i);
+
+    if (conforms)
+      return ApElementwise::assign(r, ev);
+    return r = ApElementwise::apply(ev);
+  }
+
+  //! array -- product assignment
+  template <int d, typename T, class A>
+  static Array<d,T>& apply(Array<d,T>& r, const Expr<A>& e,
+                           Int2Type<Product_evaluation>) {
+
+    if (reusable(r) && Product<A>::conforms(e.expr(), r) && !Product<A>::aliased(e.expr(), r))
+      return Product<A>::apply(e.expr(), T(1), T(), r);
+    return r = Product<A>::evaluate(e.expr());
+  }
+
+  //! array -- update assignment
+  template <int d, typename T, class A>
+  static Array<d,T>& apply(Array<d,T>& r, const Expr<A>& e,
+                           Int2Type<Update_evaluation>) {
+
+    if (reusable(r) && Update<A>::conforms(e.expr(), r) && !Update<A>::aliased(e.expr(), r))
+      return Update<A>::assign(e.expr(), r);
+    return r = Update<A>::evaluate(e.expr());
+  }
+
+  //! array -- product or update assignment, for arrays that do not use the
+  // default allocator, evaluated into a temporary and copied
+  template <int d, typename T, class S, class A, int kind>
+  static Array<d,T,S>& apply(Array<d,T,S>& r, const Expr<A>& e, Int2Type<kind>) {
+    return r = evaluate(e.expr());
+  }
+
+  //! array -- expression assignment
+  template <int d, typename T, class S, class A>
+  static Array<d,T,S>& apply(Array<d,T,S>& r, const Expr<A>& e,
+                             Int2Type<Temporary_evaluation>) {
+    return r = e();
+  }
+
+  //! view -- element-wise expression assignment
+  template <int d, typename T, class A>
+  static View<d,T>& apply(View<d,T>& r, const Expr<A>& e, Int2Type<Elementwise_evaluation>) {
+
+    Elementwise<A> ev(e.expr());
+
+    // size assertion
+    for (int i=0; i<d; ++i)
+      assert(r.size(i) == ev.size(i));
+
+    return ApElementwise::assign(r, ev);
+  }
+
+  //! view -- product assignment
+  template <int d, typename T, class A>
+  static View<d,T>& apply(View<d,T>& r, const Expr<A>& e, Int2Type<Product_evaluation>) {
+
+    assert(Product<A>::conforms(e.expr(), r));
+
+    if (Product<A>::aliased(e.expr(), r))
+      return copy(r, Product<A>::evaluate(e.expr()));
+    return Product<A>::apply(e.expr(), T(1), T(), r);
+  }
+
+  //! view -- update assignment
+  template <int d, typename T, class A>
+  static View<d,T>& apply(View<d,T>& r, const Expr<A>& e, Int2Type<Update_evaluation>) {
+
+    assert(Update<A>::conforms(e.expr(), r));
+
+    if (Update<A>::aliased(e.expr(), r))
+      return copy(r, Update<A>::evaluate(e.expr()));
+    return Update<A>::assign(e.expr(), r);
+  }
+
+  //! view -- expression assignment
+  template <int d, typename T, class A>
+  static View<d,T>& apply(View<d,T>& r, const Expr<A>& e, Int2Type<Temporary_evaluation>)
+  { return copy(r, e()); }
+
+  //! Copy an array into the elements of a view
+  template <int d, typename T>
+  static View<d,T>& copy(View<d,T>& r, const Array<d,T>& a) {
+
+    // size assertion
+    for (int i=0; i<d; ++i)
+      assert(r.size(i) == a.size(i));
+
+    return ApElementwise::assign(r, Elementwise<Array<d,T> >(a));
+  }
+
+  //! Evaluate an element-wise expression
+  template <class E>
+  static typename E::result_type evaluate(const E& e, Int2Type<Elementwise_evaluation>)
+  { return ApElementwise::apply(Elementwise<E>(e)); }
+
+  //! Evaluate a product
+  template <class E>
+  static typename E::result_type evaluate(const E& e, Int2Type<Product_evaluation>)
+  { return Product<E>::evaluate(e); }
+
+  //! Evaluate an update
+  template <class E>
+  static typename E::result_type evaluate(const E& e, Int2Type<Update_evaluation>)
+  { return Update<E>::evaluate(e); }
+};
+
+
+// assignment operator taking an arbitrary expression
+template <int k, typename T, class Alloc>
+template <class A>
+Array<k,T,Alloc>& Array<k,T,Alloc>::operator=(const Expr<A>& expr) {
+  return ApAssign::apply(*this, expr);
+}
+
+// view assignment operator taking an arbitrary expression
+template <int k, typename T>
+template <class A>
+View<k,T>& View<k,T>::operator=(const Expr<A>& expr) {
+  return ApAssign::apply(*this, expr);
+}
+
+
+
+//! Applicative class for the addition operation
+class ApAdd {
+public:
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  // return references
+  
+  //! array -- scalar*array addition
+  template <int d, typename T>
+  static Array<d,T>& apply(Array<d,T>& a, const SAm<d,T>& y) {
+    
+    const Array<d,T>& b = y.right();
+    
+    // size assertion
+    for (size_t i=0; i<d; ++i)
+      assert(a.n_[i] == b.n_[i]);
+    
+    cblas_axpy<T>(a.size(), y.left(), b.data_, 1, a.data_, 1);
+    return a;
+  }
+  
+  //! array -- array addition
+  template <int d, typename T>
+  static Array<d,T> apply(const Array<d,T>& a, const Array<d,T>& b) {
+    
+    typedef BinExprOp<Array<d,T>, Array<d,T>, ApAdd> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(a, b));
+  }
+  
+  //! array -- expr addition
+  /*! Element-wise expressions are added in a single loop, and products and
+   * updates are accumulated by BLAS with \f$ \beta = 1 \f$ unless they read
+   * from the destination array.
+   */
+  template<int d, typename T, class B>
+  static Array<d,T>& apply(Array<d,T>& a, const Expr<B>& b) {
+    return add(a, b, Int2Type<Evaluation_traits<B>::value>());
+  }
+
+  //! array -- view addition
+  template <int d, typename T>
+  static Array<d,T>& apply(Array<d,T>& a, const View<d,T>& b)
+  { return apply(a, T(1)*b); }
+
+  //! view -- expr addition, evaluated like the array -- expr addition
+  template<int d, typename T, class B>
+  static View<d,T>& apply(View<d,T>& a, const Expr<B>& b) {
+    return add(a, b, Int2Type<Evaluation_traits<B>::value>());
+  }
+
+  //! view -- array addition
+  template <int d, typename T>
+  static View<d,T>& apply(View<d,T>& a, const Array<d,T>& b)
+  { return apply(a, T(1)*b); }
+
+  //! view -- view addition
+  template <int d, typename T>
+  static View<d,T>& apply(View<d,T>& a, const View<d,T>& b)
+  { return apply(a, T(1)*b); }
+  
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  // return new objects
+  
+  //! scalar*array -- scalar*array addition
+  template <int d, typename T>
+  static Array<d,T> apply(const SAm<d,T>& x, const SAm<d,T>& y) {
+    
+    typedef BinExprOp<SAm<d,T>, SAm<d,T>, ApAdd> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(x, y));
+  }
+  
+  //! expr -- expr addition, evaluated without temporaries
+  template<class A, class B>
+  static typename std::enable_if<
+  Evaluation_traits<BinExprOp<Expr<A>, Expr<B>, ApAdd> >::value != Temporary_evaluation,
+  typename Return_type<Expr<A>, Expr<B>, ApAdd>::result_type>::type
+  apply(const Expr<A>& a, const Expr<B>& b) {
+    
+    typedef BinExprOp<Expr<A>, Expr<B>, ApAdd> ExprT;
+    return ApAssign::evaluate(ExprT(a, b));
+  }
+  
+  //! expr -- expr addition
+  template<class A, class B>
+  static typename std::enable_if<
+  Evaluation_traits<BinExprOp<Expr<A>, Expr<B>, ApAdd> >::value == Temporary_evaluation,
+  typename Return_type<Expr<A>, Expr<B>, ApAdd>::result_type>::type
+  apply(const Expr<A>& a, const Expr<B>& b) {
+    return a()+b();
+  }
+  
+private:
+  
+  //! array -- element-wise expr addition, evaluated in a single loop
+  template<class R, class B>
+  static R& add(R& a, const Expr<B>& b, Int2Type<Elementwise_evaluation>) {
+    
+    Elementwise<B> ev(b.expr());
+    
+    // size assertion
+    for (int i=0; i<R::rank(); ++i)
+      assert(a.size(i) == ev.size(i));
+    
+    return ApElementwise::add(a, ev);
+  }
+  
+  //! array -- product addition, C <- alpha*op(A)*op(B) + C
+  template<class R, class B>
+  static R& add(R& a, const Expr<B>& b, Int2Type<Product_evaluation>) {
+    
+    typedef typename R::value_type value_type;
+    assert(Product<B>::conforms(b.expr(), a));
+    
+    if (Product<B>::aliased(b.expr(), a))
+      return a += b();
+    return Product<B>::apply(b.expr(), value_type(1), value_type(1), a);
+  }
+  
+  //! array -- update addition
+  template<class R, class B>
+  static R& add(R& a, const Expr<B>& b, Int2Type<Update_evaluation>) {
+    
+    assert(Update<B>::conforms(b.expr(), a));
+    
+    if (Update<B>::aliased(b.expr(), a))
+      return a += b();
+    return Update<B>::add(b.expr(), a);
+  }
+  
+  //! array -- expr addition
+  template<class R, class B>
+  static R& add(R& a, const Expr<B>& b, Int2Type<Temporary_evaluation>) {
+    return a += b();
+  }
+};
+
+//! Applicative class for the subtraction operation
+class ApSub {
+public:
+  
+  //! array -- array subtraction
+  template <int d, typename T>
+  static Array<d,T> apply(const Array<d,T>& a, const Array<d,T>& b) {
+    
+    typedef BinExprOp<Array<d,T>, Array<d,T>, ApSub> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(a, b));
+  }
+  
+  //! expr -- expr subtraction, evaluated without temporaries
+  template<class A, class B>
+  static typename std::enable_if<
+  Evaluation_traits<BinExprOp<Expr<A>, Expr<B>, ApSub> >::value != Temporary_evaluation,
+  typename Return_type<Expr<A>, Expr<B>, ApSub>::result_type>::type
+  apply(const Expr<A>& a, const Expr<B>& b) {
+    
+    typedef BinExprOp<Expr<A>, Expr<B>, ApSub> ExprT;
+    return ApAssign::evaluate(ExprT(a, b));
+  }
+  
+  //! expr -- expr subtraction
+  template<class A, class B>
+  static typename std::enable_if<
+  Evaluation_traits<BinExprOp<Expr<A>, Expr<B>, ApSub> >::value == Temporary_evaluation,
+  typename Return_type<Expr<A>, Expr<B>, ApSub>::result_type>::type
+  apply(const Expr<A>& a, const Expr<B>& b) {
+    return a()-b();
+  }
+};
+
+//! Applicative class for the multiplication operation
+class ApMul {
+public:
+  
+  //! scalar types
+  template <typename T>
+  static ExprLiteral<T> apply(const ExprLiteral<T>& a, const ExprLiteral<T>& b)
+  { return ExprLiteral<T>(a*b); }
+
+  //! scalar -- array multiplication
+  template <int d, typename T>
+  static Array<d,T> apply(const ExprLiteral<T>& a, const Array<d,T>& b) {
+    
+    typedef BinExprOp<ExprLiteral<T>, Array<d,T>, ApMul> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(a, b));
+  }
+
+  //! scalar -- view multiplication
+  template <int d, typename T>
+  static Array<d,T> apply(const ExprLiteral<T>& a, const View<d,T>& b) {
+    
+    typedef BinExprOp<ExprLiteral<T>, View<d,T>, ApMul> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(a, b));
+  }
+
+  //! expression -- scalar multiplication
+  template <typename T, class A>
+  static auto apply(const Expr<A> &a, const ExprLiteral<T> &b)
+  -> decltype(a()) {
+    return a()*b();
+  }
+
+  //! scalar -- element-wise expression multiplication
+  template <typename T, class B>
+  static auto apply(const ExprLiteral<T> &a, const Expr<B> &b)
+  -> typename std::enable_if<Elementwise_traits<B>::value, decltype(b())>::type {
+    
+    typedef BinExprOp<ExprLiteral<T>, Expr<B>, ApMul> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(a, b));
+  }
+
+  //! scalar -- expression multiplication
+  template <typename T, class B>
+  static auto apply(const ExprLiteral<T> &a, const Expr<B> &b)
+  -> typename std::enable_if<!Elementwise_traits<B>::value, decltype(b())>::type {
+    return a()*b();
   }
   
   //! transposed vector -- scalar*vector multiplication
@@ -477,7 +1767,7 @@ public:
     const vector_type<T>& y = b.right();
     
     assert(x.size() == y.size());
-    return b.left()*cblas_dot(x.size(), x.data_, 1, y.data_, 1);
+    return T(b.left())*cblas_dot(x.size(), x.data_, 1, y.data_, 1);
   }
   
   //! scalar*vector -- transposed vector multiplication
@@ -503,20 +1793,15 @@ public:
     assert(x.size() == y.size());
     T dot = cblas_dot<T>(x.size(), x.data_, 1, y.data_, 1);
     
-    return ExprLiteral<T>((b.left())*a.left()*dot);
+    return ExprLiteral<T>(T(b.left())*T(a.left())*dot);
   }
   
   //! scalar*vector -- scalar*transposed vector multiplication
   template <typename T>
-  static matrix_type<T> apply(const SVm<T>& a, const SVtm<T>& b) {
+  static matrix_type<T> apply(const SVm<T>& x, const SVtm<T>& y) {
     
-    const vector_type<T>& x = a.right();
-    const vector_type<T>& y = b.right().left();
-    
-    matrix_type<T> r(x.size(), y.size());
-    
-    cblas_ger<T>(x.size(), y.size(), a.left()*b.left(), x.data_, 1, y.data_, 1, r.data_, r.n_[0]);
-    return r;
+    typedef BinExprOp<SVm<T>, SVtm<T>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(x, y));
   }
   
   //! (scalar -- vector multiplication) -- (scalar -- matrix multiplication) multiplication
@@ -530,9 +1815,9 @@ public:
     // check size
     assert(b.rows() == 1);
     
-    matrix_type<T> r(a.size(), b.columns());
+    matrix_type<T> r(a.size(), b.columns(), uninitialized);
     cblas_gemm<T>(CblasNoTrans, CblasNoTrans, r.rows(), r.columns(), 1,
-                  x.left() * y.left(), a.data_, a.size(), b.data_, b.rows(),
+                  x.left()() * y.left()(), a.data_, a.size(), b.data_, b.rows(),
                   0.0, r.data_, r.rows());
     return r;
   }
@@ -541,180 +1826,1076 @@ public:
   template <typename T>
   static matrix_type<T> apply(const SMm<T>& x, const SMm<T>& y) {
     
+    typedef BinExprOp<SMm<T>, SMm<T>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(x, y));
+  }
+  
+  //! scalar*matrix -- scalar*vector multiplication
+  template <typename T>
+  static vector_type<T> apply(const SMm<T>& x, const SVm<T>& y) {
+    
+    typedef BinExprOp<SMm<T>, SVm<T>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(x, y));
+  }
+  
+  //! scalar*transposed matrix -- scalar*vector multiplication
+  template <typename T>
+  static vector_type<T> apply(const SMtm<T>& x, const SVm<T>& y) {
+    
+    typedef BinExprOp<SMtm<T>, SVm<T>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(x, y));
+  }
+  
+  //! scalar*transposed matrix -- scalar*matrix multiplication
+  template <typename T>
+  static matrix_type<T> apply(const SMtm<T>& x, const SMm<T>& y) {
+    
+    typedef BinExprOp<SMtm<T>, SMm<T>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(x, y));
+  }
+  
+  //! scalar*matrix -- scalar*transposed vector multiplication
+  template <typename T>
+  static matrix_type<T> apply(const SMm<T> &x, const SVtm<T> &y) {
+    
     // get matrix refernces
     const matrix_type<T>& a = x.right();
-    const matrix_type<T>& b = y.right();
+    const vector_type<T>& b = y.right().left();
+    
+    // check size
+    assert(a.columns() == 1);
+    
+    matrix_type<T> r(a.rows(), b.size(), uninitialized);
+    cblas_gemm(CblasNoTrans, CblasTrans, r.rows(), r.columns(),
+               a.columns(), x.left()()*y.left()(),
+               a.data_, a.rows(), b.data_, b.size(), T(), r.data_, r.rows());
+    return r;
+  }
+
+  
+  //! scalar*matrix -- scalar*transposed matrix multiplication
+  template <typename T>
+  static matrix_type<T> apply(const SMm<T>& x, const SMtm<T>& y) {
+    
+    typedef BinExprOp<SMm<T>, SMtm<T>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(x, y));
+  }
+  
+  //! scalar*transposed matrix -- scalar*transposed matrix multiplication
+  template <typename T>
+  static matrix_type<T> apply(const SMtm<T>& x, const SMtm<T>& y) {
+    
+    typedef BinExprOp<SMtm<T>, SMtm<T>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(x, y));
+  }
+  
+  //! transposed vector -- expr multiplication
+  template<typename T, class B>
+  static typename Return_type<SVtm<T>, Expr<B>, ApMul>::result_type
+  apply(const SVtm<T>& a, const Expr<B>& b) {
+    return a*b();
+  }
+  
+  
+  //! transposed vector -- matrix multiplication -- expression multiplication
+  template<typename T, class B>
+  static typename Return_type<SVtm<T>, Expr<B>, ApMul>::result_type
+  apply(const SVtmSMmm<T>& a, const Expr<B>& b) {
+    
+    T s = a.left().left()() * a.right().left()();
+    const vector_type<T>& v = a.left().right().left();
+    const matrix_type<T>& m = a.right().right();
+    
+    assert(v.size() == m.rows());
+    vector_type<T> r(m.columns(), uninitialized);
+    
+    cblas_gemm(CblasNoTrans,CblasNoTrans, 1, m.columns(),
+               v.size(), s, v.data_, 1, m.data_, m.rows(),
+               T(), r.data_, 1);
+    
+    return transpose(r)*b;
+  }
+  
+  //! expr -- expr multiplication
+  /*! Chains of three or more matrix operands, e.g., A*B*C*x, are multiplied in
+   * the order that needs the fewest operations. Otherwise, if one of the
+   * branches is a product and the other one an operand that BLAS reads in
+   * place, e.g., A*B*transpose(C), only the product is evaluated into a
+   * temporary and the operand is kept lazy.
+   */
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b) {
+    
+    typedef Operand_traits<Expr<A> > left_traits;
+    typedef Operand_traits<Expr<B> > right_traits;
+    typedef Chain_traits<Expr<BinExprOp<Expr<A>, Expr<B>, ApMul> > > chain_traits;
+    
+    return apply(a, b, Int2Type<
+                 Product_traits<BinExprOp<Expr<A>, Expr<B>, ApMul> >::value ? 1 :
+                 left_traits::value && left_traits::rank == 1 && left_traits::transposed &&
+                 right_traits::value && right_traits::rank == 1 && !right_traits::transposed ? 2 :
+                 chain_traits::value && (chain_traits::length > 2) ? 3 : 0>());
+  }
+  
+private:
+  
+  //! operand -- operand multiplication, evaluated directly by BLAS for the
+  // operands (e.g., views) that do not have a dedicated overload
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b, Int2Type<1>) {
+    
+    typedef BinExprOp<Expr<A>, Expr<B>, ApMul> ExprT;
+    return Product<ExprT>::evaluate(ExprT(a, b));
+  }
+  
+  //! transposed vector -- vector multiplication
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b, Int2Type<2>) {
+    
+    typedef Operand_traits<Expr<A> > left_traits;
+    typedef Operand_traits<Expr<B> > right_traits;
+    
+    const typename left_traits::array_type& x = left_traits::array(a);
+    const typename right_traits::array_type& y = right_traits::array(b);
+    
+    assert(x.size() == y.size());
+    return left_traits::scalar(a)*right_traits::scalar(b)*
+    cblas_dot(x.size(), pointer(x), increment(x), pointer(y), increment(y));
+  }
+  
+  //! chain of products
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b, Int2Type<3>) {
+    
+    typedef typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type result_type;
+    
+    Chain<typename result_type::value_type> chain;
+    Chain_traits<Expr<A> >::collect(a, chain);
+    Chain_traits<Expr<B> >::collect(b, chain);
+    
+    result_type r;
+    chain.evaluate(r);
+    return r;
+  }
+  
+  //! expr -- expr multiplication
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b, Int2Type<0>) {
+    return apply(a, b, Int2Type<Product_traits<A>::value && Operand_traits<Expr<B> >::value>(),
+                 Int2Type<Operand_traits<Expr<A> >::value && Product_traits<B>::value>());
+  }
+  
+  //! product -- operand multiplication
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b, Int2Type<true>, Int2Type<false>) {
+    
+    typedef typename Operand_traits<Expr<B> >::array_type::value_type value_type;
+    const typename Product<A>::result_type t = Product<A>::evaluate(a.expr());
+    return (value_type(1)*t)*b;
+  }
+  
+  //! operand -- product multiplication
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b, Int2Type<false>, Int2Type<true>) {
+    
+    typedef typename Operand_traits<Expr<A> >::array_type::value_type value_type;
+    const typename Product<B>::result_type t = Product<B>::evaluate(b.expr());
+    return a*(value_type(1)*t);
+  }
+  
+  //! expr -- expr multiplication
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b, Int2Type<false>, Int2Type<false>) {
+    return a()*b();
+  }
+  
+public:
+  
+  ////////////////////////////////////////////////////////////////////////////////
+  // in-place kernels, used by the product evaluators
+  
+  //! matrix -- matrix multiplication, C <- alpha*op(A)*op(B) + beta*C
+  /*! The operands and the destination are arrays or views. Views are passed
+   * to BLAS in place with their leading dimension if one of their strides is
+   * one, and copied otherwise.
+   */
+  template <class A, class B, class C>
+  static C& gemm(bool ta, const A& a, bool tb, const B& b, typename C::value_type alpha,
+                 typename C::value_type beta, C& c) {
+    
+    typedef typename C::value_type T;
+    
+    size_t lda, ldb, ldc;
+    bool fa, fb, fc;
+    if (!layout(a, lda, fa))
+      return gemm(ta, matrix_type<T>(a), tb, b, alpha, beta, c);
+    if (!layout(b, ldb, fb))
+      return gemm(ta, a, tb, matrix_type<T>(b), alpha, beta, c);
+    if (!layout(c, ldc, fc)) {
+      matrix_type<T> t(c);
+      gemm(ta, a, tb, b, alpha, beta, t);
+      c = t;
+      return c;
+    }
+    
+    const size_t m = ta ? a.columns() : a.rows();
+    const size_t n = tb ? b.rows() : b.columns();
+    const size_t k = ta ? a.rows() : a.columns();
+    
+    // check size
+    assert(k == (tb ? b.columns() : b.rows()));
+    assert(c.rows() == m && c.columns() == n);
+    
+    // operands stored by rows are read as their transposes
+    ta = ta != fa;
+    tb = tb != fb;
+    
+    // the product of a matrix and its own transpose is symmetric, so only one
+    // triangle is computed, and it does not matter whether c is stored by rows
+    if (ta != tb && pointer(a) == pointer(b) && lda == ldb && fa == fb &&
+        a.rows() == b.rows() && a.columns() == b.columns()) {
+      syrk(ta, m, k, alpha, pointer(a), lda, beta, pointer(c), ldc);
+      return c;
+    }
+    
+    // a destination stored by rows is computed as C' <- alpha*op(B)'*op(A)' + beta*C'
+    if (fc)
+      cblas_gemm<T>(tb ? CblasNoTrans : CblasTrans, ta ? CblasNoTrans : CblasTrans,
+                    n, m, k, alpha, pointer(b), ldb, pointer(a), lda,
+                    beta, pointer(c), ldc);
+    else
+      cblas_gemm<T>(ta ? CblasTrans : CblasNoTrans, tb ? CblasTrans : CblasNoTrans,
+                    m, n, k, alpha, pointer(a), lda, pointer(b), ldb,
+                    beta, pointer(c), ldc);
+    return c;
+  }
+  
+  //! matrix -- vector multiplication, y <- alpha*op(A)*x + beta*y
+  template <class A, class X, class Y>
+  static Y& gemv(bool ta, const A& a, const X& x, typename Y::value_type alpha,
+                 typename Y::value_type beta, Y& y) {
+    
+    typedef typename Y::value_type T;
+    
+    size_t lda;
+    bool fa;
+    if (!layout(a, lda, fa))
+      return gemv(ta, matrix_type<T>(a), x, alpha, beta, y);
+    
+    // check size
+    assert(x.size() == (ta ? a.rows() : a.columns()));
+    assert(y.size() == (ta ? a.columns() : a.rows()));
+    
+    cblas_gemv<T>(ta != fa ? CblasTrans : CblasNoTrans,
+                  fa ? a.columns() : a.rows(), fa ? a.rows() : a.columns(), alpha,
+                  pointer(a), lda, pointer(x), increment(x), beta, pointer(y), increment(y));
+    return y;
+  }
+  
+  //! vector -- transposed vector multiplication, A <- alpha*x*y' + beta*A
+  template <class X, class Y, class A>
+  static A& ger(const X& x, const Y& y, typename A::value_type alpha,
+                typename A::value_type beta, A& a) {
+    
+    typedef typename A::value_type T;
+    
+    size_t lda;
+    bool fa;
+    if (!layout(a, lda, fa)) {
+      matrix_type<T> t(a);
+      ger(x, y, alpha, beta, t);
+      a = t;
+      return a;
+    }
     
     // check size
-    assert(a.columns() == b.rows());
+    assert(a.rows() == x.size() && a.columns() == y.size());
     
-    matrix_type<T> r(a.rows(), b.columns());
-    cblas_gemm<T>(CblasNoTrans, CblasNoTrans, r.rows(), r.columns(),
-               a.columns(), x.left()*y.left(),
-               a.data_, a.rows(), b.data_, b.rows(), 0.0, r.data_, r.rows());
-    return r;
+    // ger only accumulates, so scale the destination first
+    scale(a, beta);
+    
+    // a destination stored by rows is computed as A' <- alpha*y*x' + A'
+    if (fa)
+      cblas_ger<T>(y.size(), x.size(), alpha, pointer(y), increment(y),
+                   pointer(x), increment(x), pointer(a), lda);
+    else
+      cblas_ger<T>(x.size(), y.size(), alpha, pointer(x), increment(x),
+                   pointer(y), increment(y), pointer(a), lda);
+    return a;
   }
   
-  //! scalar*matrix -- scalar*vector multiplication
+private:
+  
+  //! Symmetric rank k update C <- alpha*op(A)*op(A)' + beta*C, where op(A) is
+  // A' if ta is true, of an n x n matrix stored by columns
+  /*! BLAS syrk computes the upper triangle, which is then mirrored. Since beta*C
+   * need not be symmetric, the difference between its lower and upper
+   * triangles is kept in the lower triangle in the meantime.
+   */
   template <typename T>
-  static vector_type<T> apply(const SMm<T>& x, const SVm<T>& y) {
+  static void syrk(bool ta, size_t n, size_t k, T alpha, T* a, size_t lda,
+                   T beta, T* c, size_t ldc) {
     
-    // get matrix refernces
-    const matrix_type<T>& a = x.right();
-    const vector_type<T>& b = y.right();
+    if (beta != T())
+      for (size_t j=0; j<n; ++j)
+        for (size_t i=j+1; i<n; ++i)
+          c[i + j*ldc] -= c[j + i*ldc];
     
-    // check size
-    assert(a.columns() == b.size());
+    cblas_syrk<T>(CblasUpper, ta ? CblasTrans : CblasNoTrans, n, k, alpha,
+                  a, lda, beta, c, ldc);
     
-    vector_type<T> r(a.rows());
-    cblas_gemv<T>(CblasNoTrans, a.rows(), a.columns(), x.left() * y.left(),
-               a.data_, a.rows(), b.data_, 1, 0., r.data_, 1);
-    return r;
+    for (size_t j=0; j<n; ++j)
+      for (size_t i=j+1; i<n; ++i)
+        c[i + j*ldc] = beta != T() ? c[j + i*ldc] + beta*c[i + j*ldc] : c[j + i*ldc];
   }
   
-  //! scalar*transposed matrix -- scalar*matrix multiplication
+  //! Pointer to the first element of an array or view, as taken by BLAS
+  template <class A>
+  static typename A::value_type* pointer(const A& a)
+  { return const_cast<typename A::value_type*>(a.data()); }
+  
+  //! Increment of a vector
+  template <typename T, class S>
+  static size_t increment(const Array<1,T,S>&)
+  { return 1; }
+  
+  //! Increment of a vector view
   template <typename T>
-  static matrix_type<T> apply(const SMtm<T>&x, const SMm<T> &y) {
-    
-    // get matrix refernces
-    const matrix_type<T>& a = x.right().left();
-    const matrix_type<T>& b = y.right();
-    
-    // check size
-    assert(a.rows() == b.rows());
-        
-    matrix_type<T> r(a.columns(), b.columns());
-    cblas_gemm<T>(CblasTrans, CblasNoTrans, r.rows(), r.columns(),
-               a.rows(), x.left()*y.left(),
-               a.data_, a.rows(), b.data_, b.rows(), 1.0, r.data_, r.rows());
-    return r;
+  static size_t increment(const View<1,T>& v)
+  { return v.stride(0); }
+  
+  //! Storage of a matrix as seen by BLAS, arrays are always stored by columns
+  template <typename T, class S>
+  static bool layout(const Array<2,T,S>& a, size_t& ld, bool& flipped) {
+    ld = std::max<size_t>(a.rows(), 1);
+    flipped = false;
+    return true;
   }
   
-  //! scalar*matrix -- scalar*transposed vector multiplication
+  //! Storage of a matrix view as seen by BLAS
+  /*! A view is stored by columns if its row stride is one, and by rows (i.e.,
+   * flipped) if its column stride is one. Otherwise it cannot be passed to
+   * BLAS and false is returned.
+   */
   template <typename T>
-  static matrix_type<T> apply(const SMm<T> &x, const SVtm<T> &y) {
+  static bool layout(const View<2,T>& v, size_t& ld, bool& flipped) {
     
-    // get matrix refernces
-    const matrix_type<T>& a = x.right();
-    const vector_type<T>& b = y.right().left();
-    
-    // check size
-    assert(a.columns() == 1);
+    if (v.stride(0) == 1 || v.rows() == 1) {
+      ld = std::max<size_t>(v.columns() > 1 ? v.stride(1) : v.rows(), 1);
+      flipped = false;
+      return ld >= v.rows();
+    }
+    if (v.stride(1) == 1 || v.columns() == 1) {
+      ld = std::max<size_t>(v.rows() > 1 ? v.stride(0) : v.columns(), 1);
+      flipped = true;
+      return ld >= v.columns();
+    }
+    return false;
+  }
+  
+  //! Scale a matrix, a zero factor overwrites the (possibly uninitialized)
+  // elements
+  template <typename T, class S>
+  static void scale(Array<2,T,S>& a, T beta) {
+    if (beta == T())
+      std::fill_n(a.data_, a.size(), T());
+    else if (beta != T(1))
+      cblas_scal<T>(a.size(), beta, a.data_, 1);
+  }
+  
+  //! Scale a matrix view column by column
+  template <typename T>
+  static void scale(View<2,T>& v, T beta) {
     
-    matrix_type<T> r(a.rows(), b.size());
-    cblas_gemm(CblasNoTrans, CblasTrans, r.rows(), r.columns(),
-               a.columns(), x.left()*y.left(),
-               a.data_, a.rows(), b.data_, b.size(), 1.0, r.data_, r.rows());
-    return r;
+    if (beta == T(1))
+      return;
+    for (size_t j=0; j<v.columns(); ++j) {
+      T* p = v.data() + j*v.stride(1);
+      if (beta == T())
+        for (size_t i=0; i<v.rows(); ++i)
+          p[i*v.stride(0)] = T();
+      else
+        cblas_scal<T>(v.rows(), beta, p, v.stride(0));
+    }
   }
+};
 
+//! Applicative class for the division operation
+class ApDiv {
+public:
   
-  //! scalar*matrix -- scalar*transposed matrix multiplication
+  
+  // expr -- expr divition
+  template<class A, class B>
+  static typename Return_type<Expr<A>, Expr<B>, ApDiv>::result_type
+  apply(const Expr<A>& a, const Expr<B>& b) {
+    return a()/b();
+  }
+};
+
+
+//! ApTr -- transpose
+class ApTr {
+  
+  public:
+  
+  // this function should never be called
   template <typename T>
-  static matrix_type<T> apply(const SMm<T> &x, const SMtm<T> &y) {
-    
-    // get matrix refernces
-    const matrix_type<T>& a = x.right();
-    const matrix_type<T>& b = y.right().left();
-    
-    // check size
-    assert(a.columns() == b.columns());
-    
-    matrix_type<T> r(a.rows(), b.rows());
-    cblas_gemm(CblasNoTrans, CblasTrans, r.rows(), r.columns(),
-               a.columns(), x.left()*y.left(),
-               a.data_, a.rows(), b.data_, b.rows(), 1.0, r.data_, r.rows());
-    return r;
+  static inline vector_type<T> apply(const vector_type<T>& a, EmptyType) {
+    cout<<"*** ERROR *** Cannot return the transpose of a vector"<<endl;
+    exit(1);
   }
   
-  //! scalar*transposed matrix -- scalar*transposed matrix multiplication
+  //! Transpose matrix
+  /*! Transposes are otherwise kept lazy, so this is only called when a
+   * transposed matrix has to be materialized. The copy is done by the blocked
+   * (and threaded for large matrices) element-wise kernel.
+   */
   template <typename T>
-  static matrix_type<T> apply(const SMtm<T> &x, const SMtm<T> &y) {
+  static inline matrix_type<T> apply(const matrix_type<T>& a, EmptyType) {
     
-    // get matrix refernces
-    const matrix_type<T>& a = x.right().left();
-    const matrix_type<T>& b = y.right().left();
+    typedef BinExprOp<matrix_type<T>, EmptyType, ApTr> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(ExprT(a, EmptyType())));
+  }
+  
+  // this function should never be called
+  template <typename T>
+  static inline vector_type<T> apply(const View<1,T>& a, EmptyType) {
+    cout<<"*** ERROR *** Cannot return the transpose of a vector"<<endl;
+    exit(1);
+  }
+  
+  //! Transpose matrix view
+  template <typename T>
+  static inline matrix_type<T> apply(const View<2,T>& a, EmptyType) {
     
-    // check size
-    assert(a.rows() == b.columns());
+    typedef BinExprOp<View<2,T>, EmptyType, ApTr> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(ExprT(a, EmptyType())));
+  }
+};
+
+
+//! Applicative class for element-wise functions
+class ApMap {
+  
+public:
+  
+  //! Function of element-wise expressions, evaluated in a single loop
+  template <class F, class A, class B>
+  static typename std::enable_if<Elementwise_traits<FunExprOp<F,A,B> >::value,
+  typename FunExprOp<F,A,B>::result_type>::type
+  apply(const FunExprOp<F,A,B>& e) {
+    return ApElementwise::apply(Elementwise<FunExprOp<F,A,B> >(e));
+  }
+  
+  //! Function of other expressions, e.g., products, which are evaluated into
+  // temporaries first
+  template <class F, class A, class B>
+  static typename std::enable_if<!Elementwise_traits<FunExprOp<F,A,B> >::value,
+  typename FunExprOp<F,A,B>::result_type>::type
+  apply(const FunExprOp<F,A,B>& e) {
+    return apply(e.function(), argument(e.left()), argument(e.right()));
+  }
+  
+private:
+  
+  template <class F, class A, class B>
+  static typename FunExprOp<F,A,B>::result_type
+  apply(const F& f, const A& a, const B& b) {
     
-    matrix_type<T> r(a.columns(), b.rows());
-    cblas_gemm(CblasTrans, CblasTrans, r.rows(), r.columns(),
-               a.rows(), x.left()*y.left(),
-               a.data_, a.rows(), b.data_, b.rows(), 1.0, r.data_, r.rows());
+    typedef FunExprOp<F,A,B> ExprT;
+    return ApElementwise::apply(Elementwise<ExprT>(ExprT(f, a, b)));
+  }
+  
+  //! Arguments that are read element by element
+  template <class X>
+  static typename std::enable_if<Elementwise_traits<X>::value ||
+  Function_argument<X>::scalar, const X&>::type
+  argument(const X& x)
+  { return x; }
+  
+  static const EmptyType& argument(const EmptyType& x)
+  { return x; }
+  
+  //! Arguments that are evaluated into temporaries
+  template <class A>
+  static typename std::enable_if<!Elementwise_traits<A>::value,
+  typename Expr<A>::result_type>::type
+  argument(const Expr<A>& x)
+  { return x(); }
+};
+
+//! Overloaded operator() for evaluating an element-wise function
+template<class F, class A, class B>
+typename FunExprOp<F,A,B>::result_type FunExprOp<F,A,B>::operator()() const
+{ return ApMap::apply(*this); }
+
+
+////////////////////////////////////////////////////////////////////////////////
+// product evaluation
+
+//! Product kernel class template, selects the BLAS routine used to evaluate a
+// product from the ranks of its operands
+template <class X, class Y, int r1 = Operand_traits<X>::rank, int r2 = Operand_traits<Y>::rank>
+struct Product_kernel;
+
+//! Product kernel partial template specialization for matrix -- matrix
+// products, evaluated with gemm
+template <class X, class Y>
+struct Product_kernel<X, Y, 2, 2> {
+
+  typedef Operand_traits<X> left_traits;
+  typedef Operand_traits<Y> right_traits;
+  typedef typename left_traits::array_type::value_type value_type;
+  typedef Array<2, value_type> result_type;
+  typedef BinExprOp<X, Y, ApMul> expression_type;
+
+  static size_t rows(const expression_type& e) {
+    const typename left_traits::array_type& a = left_traits::array(e.left());
+    return left_traits::transposed ? a.columns() : a.rows();
+  }
+
+  static size_t columns(const expression_type& e) {
+    const typename right_traits::array_type& b = right_traits::array(e.right());
+    return right_traits::transposed ? b.rows() : b.columns();
+  }
+
+  template <class C>
+  static bool conforms(const expression_type& e, const C& c)
+  { return c.rows() == rows(e) && c.columns() == columns(e); }
+
+  template <class C>
+  static bool aliased(const expression_type& e, const C& c) {
+    return overlap(c, left_traits::array(e.left())) ||
+    overlap(c, right_traits::array(e.right()));
+  }
+
+  template <class C>
+  static C& apply(const expression_type& e, value_type alpha, value_type beta, C& c) {
+    return ApMul::gemm(left_traits::transposed, left_traits::array(e.left()),
+                       right_traits::transposed, right_traits::array(e.right()),
+                       alpha*left_traits::scalar(e.left())*right_traits::scalar(e.right()),
+                       beta, c);
+  }
+
+  static result_type evaluate(const expression_type& e, value_type alpha = value_type(1)) {
+    result_type r(rows(e), columns(e), uninitialized);
+    apply(e, alpha, value_type(), r);
+    return r;
+  }
+};
+
+//! Product kernel partial template specialization for matrix -- vector
+// products, evaluated with gemv
+template <class X, class Y>
+struct Product_kernel<X, Y, 2, 1> {
+
+  typedef Operand_traits<X> left_traits;
+  typedef Operand_traits<Y> right_traits;
+  typedef typename right_traits::array_type::value_type value_type;
+  typedef Array<1, value_type> result_type;
+  typedef BinExprOp<X, Y, ApMul> expression_type;
+
+  static size_t rows(const expression_type& e) {
+    const typename left_traits::array_type& a = left_traits::array(e.left());
+    return left_traits::transposed ? a.columns() : a.rows();
+  }
+
+  template <class C>
+  static bool conforms(const expression_type& e, const C& y)
+  { return y.size() == rows(e); }
+
+  template <class C>
+  static bool aliased(const expression_type& e, const C& y) {
+    return overlap(y, left_traits::array(e.left())) ||
+    overlap(y, right_traits::array(e.right()));
+  }
+
+  template <class C>
+  static C& apply(const expression_type& e, value_type alpha, value_type beta, C& y) {
+    return ApMul::gemv(left_traits::transposed, left_traits::array(e.left()),
+                       right_traits::array(e.right()),
+                       alpha*left_traits::scalar(e.left())*right_traits::scalar(e.right()),
+                       beta, y);
+  }
+
+  static result_type evaluate(const expression_type& e, value_type alpha = value_type(1)) {
+    result_type r(rows(e), uninitialized);
+    apply(e, alpha, value_type(), r);
+    return r;
+  }
+};
+
+//! Product kernel partial template specialization for vector -- transposed
+// vector products, evaluated with ger
+template <class X, class Y>
+struct Product_kernel<X, Y, 1, 1> {
+
+  typedef Operand_traits<X> left_traits;
+  typedef Operand_traits<Y> right_traits;
+  typedef typename left_traits::array_type vector_type;
+  typedef typename vector_type::value_type value_type;
+  typedef Array<2, value_type> result_type;
+  typedef BinExprOp<X, Y, ApMul> expression_type;
+
+  template <class C>
+  static bool conforms(const expression_type& e, const C& c) {
+    return c.rows() == left_traits::array(e.left()).size() &&
+    c.columns() == right_traits::array(e.right()).size();
+  }
+
+  template <class C>
+  static bool aliased(const expression_type& e, const C& c) {
+    return overlap(c, left_traits::array(e.left())) ||
+    overlap(c, right_traits::array(e.right()));
+  }
+
+  template <class C>
+  static C& apply(const expression_type& e, value_type alpha, value_type beta, C& c) {
+    return ApMul::ger(left_traits::array(e.left()), right_traits::array(e.right()),
+                      alpha*left_traits::scalar(e.left())*right_traits::scalar(e.right()),
+                      beta, c);
+  }
+
+  static result_type evaluate(const expression_type& e, value_type alpha = value_type(1)) {
+    result_type r(left_traits::array(e.left()).size(), right_traits::array(e.right()).size(),
+                  uninitialized);
+    apply(e, alpha, value_type(), r);
+    return r;
+  }
+};
+
+
+//! Product evaluator partial template specialization for expressions
+template <class A>
+struct Product<Expr<A> > {
+
+  typedef typename Product<A>::result_type result_type;
+  typedef typename Product<A>::value_type value_type;
+
+  template <class C>
+  static bool conforms(const Expr<A>& e, const C& c)
+  { return Product<A>::conforms(e.expr(), c); }
+
+  template <class C>
+  static bool aliased(const Expr<A>& e, const C& c)
+  { return Product<A>::aliased(e.expr(), c); }
+
+  template <class C>
+  static C& apply(const Expr<A>& e, value_type alpha, value_type beta, C& c)
+  { return Product<A>::apply(e.expr(), alpha, beta, c); }
+
+  static result_type evaluate(const Expr<A>& e, value_type alpha = value_type(1))
+  { return Product<A>::evaluate(e.expr(), alpha); }
+};
+
+//! Product evaluator partial template specialization for multiplications
+template <class X, class Y>
+struct Product<BinExprOp<X, Y, ApMul> > : public Product_kernel<X, Y> {};
+
+//! Product evaluator partial template specialization for scalings
+template <typename S, class P>
+struct Product<BinExprOp<ExprLiteral<S>, Expr<P>, ApMul> > {
+
+  typedef typename Product<P>::result_type result_type;
+  typedef typename Product<P>::value_type value_type;
+  typedef BinExprOp<ExprLiteral<S>, Expr<P>, ApMul> expression_type;
+
+  template <class C>
+  static bool conforms(const expression_type& e, const C& c)
+  { return Product<P>::conforms(e.right().expr(), c); }
+
+  template <class C>
+  static bool aliased(const expression_type& e, const C& c)
+  { return Product<P>::aliased(e.right().expr(), c); }
+
+  template <class C>
+  static C& apply(const expression_type& e, value_type alpha, value_type beta, C& c) {
+    return Product<P>::apply(e.right().expr(), alpha*value_type(e.left()), beta, c);
+  }
+
+  static result_type evaluate(const expression_type& e, value_type alpha = value_type(1))
+  { return Product<P>::evaluate(e.right().expr(), alpha*value_type(e.left())); }
+};
+
+//! Product evaluator base class template for sums and differences of
+// products, where the second product is accumulated on top of the first one
+template <class A, class B, class Op>
+struct Product_sum {
+
+  typedef typename Product<A>::result_type result_type;
+  typedef typename Product<A>::value_type value_type;
+  typedef BinExprOp<A, B, Op> expression_type;
+
+  template <class C>
+  static bool conforms(const expression_type& e, const C& c)
+  { return Product<A>::conforms(e.left(), c) && Product<B>::conforms(e.right(), c); }
+
+  template <class C>
+  static bool aliased(const expression_type& e, const C& c)
+  { return Product<A>::aliased(e.left(), c) || Product<B>::aliased(e.right(), c); }
+
+  template <class C>
+  static C& apply(const expression_type& e, value_type alpha, value_type beta, C& c) {
+    Product<A>::apply(e.left(), alpha, beta, c);
+    return Product<B>::apply(e.right(), sign()*alpha, value_type(1), c);
+  }
+
+  static result_type evaluate(const expression_type& e, value_type alpha = value_type(1)) {
+    result_type r = Product<A>::evaluate(e.left(), alpha);
+    Product<B>::apply(e.right(), sign()*alpha, value_type(1), r);
+    return r;
+  }
+
+private:
+
+  static value_type sign()
+  { return std::is_same<Op, ApSub>::value ? value_type(-1) : value_type(1); }
+};
+
+//! Product evaluator partial template specialization for additions
+template <class A, class B>
+struct Product<BinExprOp<A, B, ApAdd> > : public Product_sum<A, B, ApAdd> {};
+
+//! Product evaluator partial template specialization for subtractions
+template <class A, class B>
+struct Product<BinExprOp<A, B, ApSub> > : public Product_sum<A, B, ApSub> {};
+
+
+//! Update evaluator base class template
+/*! Evaluates sp*p + sw*w, where p is a product and w an element-wise
+ * expression, by writing the element-wise part into the destination in a
+ * single loop and accumulating the product on top of it. If the element-wise
+ * part is a scaling of the destination itself, as in \f$ C = \alpha AB +
+ * \beta C \f$, the scaling is passed to BLAS as the \f$ \beta \f$ factor.
+ */
+template <class P, class W>
+struct Update_kernel {
+
+  typedef typename Product<P>::result_type result_type;
+  typedef typename Product<P>::value_type value_type;
+  typedef Elementwise<BinExprOp<ExprLiteral<value_type>, W, ApMul> > elementwise_type;
+
+  //! r <- sp*p + sw*w
+  template <class C>
+  static C& assign(const P& p, value_type sp, const W& w, value_type sw, C& r) {
+
+    value_type beta;
+    if (scales(w, r, beta))
+      return Product<P>::apply(p, sp, sw*beta, r);
+
+    elementwise_type ev(ExprLiteral<value_type>(sw), w);
+    check(ev, r);
+    ApElementwise::assign(r, ev);
+    return Product<P>::apply(p, sp, value_type(1), r);
+  }
+
+  //! r <- r + sp*p + sw*w
+  template <class C>
+  static C& add(const P& p, value_type sp, const W& w, value_type sw, C& r) {
+
+    elementwise_type ev(ExprLiteral<value_type>(sw), w);
+    check(ev, r);
+    ApElementwise::add(r, ev);
+    return Product<P>::apply(p, sp, value_type(1), r);
+  }
+
+  //! Evaluate sp*p + sw*w into a new array
+  static result_type evaluate(const P& p, value_type sp, const W& w, value_type sw) {
+
+    result_type r = ApElementwise::apply(elementwise_type(ExprLiteral<value_type>(sw), w));
+    Product<P>::apply(p, sp, value_type(1), r);
+    return r;
+  }
+
+private:
+
+  //! Size assertion between the element-wise part and the destination
+  template <class C>
+  static void check(const elementwise_type& ev, const C& r) {
+    for (int i=0; i<C::rank(); ++i)
+      assert(ev.size(i) == r.size(i));
+  }
+
+  //! Determines whether the element-wise part is a scaling of the destination
+  template <int d, typename T, class C>
+  static bool scales(const SAm<d,T>& w, const C& r, value_type& s) {
+    if (!same_layout(w.right(), r))
+      return false;
+    s = w.left();
+    return true;
+  }
+
+  //! Determines whether the element-wise part is a scaling of the destination
+  // view
+  template <int d, typename T, class C>
+  static bool scales(const SWm<d,T>& w, const C& r, value_type& s) {
+    if (!same_layout(w.right(), r))
+      return false;
+    s = w.left();
+    return true;
+  }
+
+  template <class E, class C>
+  static bool scales(const E&, const C&, value_type&)
+  { return false; }
+};
+
+//! Update evaluator base class template for binary operations, where the
+// product is the left branch if left is true and the right branch otherwise
+template <class A, class B, class Op, bool left = Product_traits<A>::value>
+struct Update_binary;
+
+//! Update evaluator base class template for products on the left branch
+template <class A, class B, class Op>
+struct Update_binary<A, B, Op, true> {
+
+  typedef Update_kernel<A, B> kernel_type;
+  typedef typename kernel_type::result_type result_type;
+  typedef typename kernel_type::value_type value_type;
+  typedef BinExprOp<A, B, Op> expression_type;
+
+  template <class C>
+  static bool conforms(const expression_type& e, const C& r)
+  { return Product<A>::conforms(e.left(), r); }
+
+  template <class C>
+  static bool aliased(const expression_type& e, const C& r)
+  { return Product<A>::aliased(e.left(), r); }
+
+  template <class C>
+  static C& assign(const expression_type& e, C& r)
+  { return kernel_type::assign(e.left(), value_type(1), e.right(), sign(), r); }
+
+  template <class C>
+  static C& add(const expression_type& e, C& r)
+  { return kernel_type::add(e.left(), value_type(1), e.right(), sign(), r); }
+
+  static result_type evaluate(const expression_type& e)
+  { return kernel_type::evaluate(e.left(), value_type(1), e.right(), sign()); }
+
+private:
+
+  static value_type sign()
+  { return std::is_same<Op, ApSub>::value ? value_type(-1) : value_type(1); }
+};
+
+//! Update evaluator base class template for products on the right branch
+template <class A, class B, class Op>
+struct Update_binary<A, B, Op, false> {
+
+  typedef Update_kernel<B, A> kernel_type;
+  typedef typename kernel_type::result_type result_type;
+  typedef typename kernel_type::value_type value_type;
+  typedef BinExprOp<A, B, Op> expression_type;
+
+  template <class C>
+  static bool conforms(const expression_type& e, const C& r)
+  { return Product<B>::conforms(e.right(), r); }
+
+  template <class C>
+  static bool aliased(const expression_type& e, const C& r)
+  { return Product<B>::aliased(e.right(), r); }
+
+  template <class C>
+  static C& assign(const expression_type& e, C& r)
+  { return kernel_type::assign(e.right(), sign(), e.left(), value_type(1), r); }
+
+  template <class C>
+  static C& add(const expression_type& e, C& r)
+  { return kernel_type::add(e.right(), sign(), e.left(), value_type(1), r); }
+
+  static result_type evaluate(const expression_type& e)
+  { return kernel_type::evaluate(e.right(), sign(), e.left(), value_type(1)); }
+
+private:
+
+  static value_type sign()
+  { return std::is_same<Op, ApSub>::value ? value_type(-1) : value_type(1); }
+};
+
+//! Update evaluator partial template specialization for expressions
+template <class A>
+struct Update<Expr<A> > {
+
+  typedef typename Update<A>::result_type result_type;
+
+  template <class C>
+  static bool conforms(const Expr<A>& e, const C& r)
+  { return Update<A>::conforms(e.expr(), r); }
+
+  template <class C>
+  static bool aliased(const Expr<A>& e, const C& r)
+  { return Update<A>::aliased(e.expr(), r); }
+
+  template <class C>
+  static C& assign(const Expr<A>& e, C& r)
+  { return Update<A>::assign(e.expr(), r); }
+
+  template <class C>
+  static C& add(const Expr<A>& e, C& r)
+  { return Update<A>::add(e.expr(), r); }
+
+  static result_type evaluate(const Expr<A>& e)
+  { return Update<A>::evaluate(e.expr()); }
+};
+
+//! Update evaluator partial template specialization for additions
+template <class A, class B>
+struct Update<BinExprOp<A, B, ApAdd> > : public Update_binary<A, B, ApAdd> {};
+
+//! Update evaluator partial template specialization for subtractions
+template <class A, class B>
+struct Update<BinExprOp<A, B, ApSub> > : public Update_binary<A, B, ApSub> {};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// product chain evaluation
+
+//! Product chain evaluator
+/*! The factors of a chain are collected as views, so that arrays, views and
+ * their transposes are read in place. The order of the multiplications is
+ * found with the matrix chain dynamic program on the runtime dimensions, e.g.,
+ * A*B*C*x is evaluated as A*(B*(C*x)) with three gemv calls instead of
+ * forming A*B first. Intermediate products are evaluated into temporaries.
+ */
+template <typename T>
+class Chain {
+
+  typedef View<2,T> matrix_view;
+  typedef View<1,T> vector_view;
+
+  std::vector<matrix_view> factors_; //!< Factors of the chain
+  std::vector<bool> transposed_;     //!< Whether each factor is transposed
+  std::vector<size_t> p_;            //!< Factor i is p_[i] x p_[i+1]
+  std::vector<size_t> split_;        //!< Last factor of the left branch of (i,j)
+  T scalar_;                         //!< Product of the scalars of the factors
+
+public:
+
+  Chain() : scalar_(1) {}
+
+  //! Add a factor to the end of the chain
+  template <class A>
+  void push(const A& a, bool transposed, T s) {
+
+    const matrix_view v = view(a);
+    const size_t m = transposed ? v.columns() : v.rows();
+    const size_t n = transposed ? v.rows() : v.columns();
+
+    // size assertion
+    assert(p_.empty() || p_.back() == m);
+
+    if (p_.empty())
+      p_.push_back(m);
+    p_.push_back(n);
+    factors_.push_back(v);
+    transposed_.push_back(transposed);
+    scalar_ *= s;
+  }
+
+  //! Evaluate a chain of matrices
+  Array<2,T>& evaluate(Array<2,T>& r) {
+    order();
+    r = Array<2,T>(p_.front(), p_.back(), uninitialized);
+    multiply(0, factors_.size() - 1, scalar_, view(r));
+    return r;
+  }
+
+  //! Evaluate a chain of matrices ending in a vector
+  Array<1,T>& evaluate(Array<1,T>& r) {
+    order();
+    r = Array<1,T>(p_.front(), uninitialized);
+    multiply(0, factors_.size() - 1, scalar_, view(r));
     return r;
   }
-  
-  //! transposed vector -- expr multiplication
-  template<typename T, class B>
-  static typename Return_type<SVtm<T>, Expr<B>, ApMul>::result_type
-  apply(const SVtm<T>& a, const Expr<B>& b) {
-    return a*b();
+
+private:
+
+  //! Matrix chain dynamic program, the cost of a product is the number of
+  // multiply-adds. Ties are broken towards the left to right order.
+  void order() {
+
+    const size_t n = factors_.size();
+    std::vector<size_t> cost(n*n, 0);
+    split_.assign(n*n, 0);
+
+    for (size_t l=1; l<n; ++l)
+      for (size_t i=0; i+l<n; ++i) {
+        const size_t j = i + l;
+        for (size_t k=i; k<j; ++k) {
+          const size_t c = cost[i*n + k] + cost[(k+1)*n + j] + p_[i]*p_[k+1]*p_[j+1];
+          if (k == i || c <= cost[i*n + j]) {
+            cost[i*n + j] = c;
+            split_[i*n + j] = k;
+          }
+        }
+      }
   }
-  
-  
-  //! transposed vector -- matrix multiplication -- expression multiplication
-  template<typename T, class B>
-  static typename Return_type<SVtm<T>, Expr<B>, ApMul>::result_type
-  apply(const SVtmSMmm<T>& a, const Expr<B>& b) {
-    
-    T s = a.left().left() * a.right().left();
-    const vector_type<T>& v = a.left().right().left();
-    const matrix_type<T>& m = a.right().right();
-    
-    assert(v.size() == m.rows());
-    vector_type<T> r(m.columns());
-    
-    cblas_gemm(CblasNoTrans,CblasNoTrans, 1, m.columns(),
-               v.size(), s, v.data_, 1, m.data_, m.rows(),
-               1.0, r.data_, 1);
-    
-    return transpose(r)*b;
+
+  //! Evaluate alpha times the product of factors i to j into c
+  void multiply(size_t i, size_t j, T alpha, matrix_view c) const {
+
+    const size_t k = split_[i*factors_.size() + j];
+
+    Array<2,T> l, r;
+    const matrix_view a = operand(i, k, l), b = operand(k+1, j, r);
+    const bool ta = i == k && transposed_[i], tb = k+1 == j && transposed_[j];
+
+    if (p_[j+1] == 1) {
+      const vector_view x = column(b, tb);
+      vector_view y = column(c, false);
+      ApMul::gemv(ta, a, x, alpha, T(), y);
+    } else
+      ApMul::gemm(ta, a, tb, b, alpha, T(), c);
   }
-  
-  //! expr -- expr multiplication
-  template<class A, class B>
-  static typename Return_type<Expr<A>, Expr<B>, ApMul>::result_type
-  apply(const Expr<A>& a, const Expr<B>& b) {
-    return a()*b();
+
+  //! Factor i if i == j, and otherwise the product of factors i to j
+  // evaluated into t
+  matrix_view operand(size_t i, size_t j, Array<2,T>& t) const {
+
+    if (i == j)
+      return factors_[i];
+    t = Array<2,T>(p_[i], p_[j+1], uninitialized);
+    multiply(i, j, T(1), view(t));
+    return view(t);
   }
-};
 
-//! Applicative class for the division operation
-class ApDiv {
-public:
-  
-  
-  // expr -- expr divition
-  template<class A, class B>
-  static typename Return_type<Expr<A>, Expr<B>, ApDiv>::result_type
-  apply(const Expr<A>& a, const Expr<B>& b) {
-    return a()/b();
+  //! The single column of a matrix view, or of its transpose
+  static vector_view column(const matrix_view& v, bool transposed) {
+    const size_t n[] = { transposed ? v.columns() : v.rows() };
+    const size_t s[] = { transposed ? v.stride(1) : v.stride(0) };
+    return vector_view(v.data(), n, s);
   }
-};
 
+  template <class S>
+  static matrix_view view(const Array<2,T,S>& a) {
+    const size_t n[] = { a.rows(), a.columns() }, s[] = { 1, a.rows() };
+    return matrix_view(const_cast<T*>(a.data()), n, s);
+  }
 
-//! ApTr -- transpose
-class ApTr {
-  
-  public:
-  
-  // this function should never be called
-  template <typename T>
-  static inline vector_type<T> apply(const vector_type<T>& a, EmptyType) {
-    cout<<"*** ERROR *** Cannot return the transpose of a vector"<<endl;
-    exit(1);
+  static matrix_view view(const matrix_view& v)
+  { return v; }
+
+  //! View of a vector as a matrix with a single column
+  template <class S>
+  static matrix_view view(const Array<1,T,S>& x) {
+    const size_t n[] = { x.size(), 1 }, s[] = { 1, x.size() };
+    return matrix_view(const_cast<T*>(x.data()), n, s);
   }
-  
-  //! Transpose matrix
-  template <typename T>
-  static inline matrix_type<T> apply(const matrix_type<T>& a, EmptyType) {
-    
-    matrix_type<T> r(a.columns(), a.rows());
-    for(size_t i=0; i<r.rows(); ++i)
-      for(size_t j=0; j<r.columns(); ++j)
-        r(i,j) = a(j,i);
-    return r;
+
+  //! View of a vector view as a matrix with a single column
+  static matrix_view view(const vector_view& x) {
+    const size_t n[] = { x.size(), 1 }, s[] = { x.stride(0), x.size()*x.stride(0) };
+    return matrix_view(x.data(), n, s);
   }
 };
 
@@ -728,7 +2909,7 @@ class ApTr {
 
 //! unary operator+(any)
 template <class A>
-typename std::enable_if<!is_arithmetic<A>::value, A>::type
+typename std::enable_if<!Is_scalar<A>::value, A>::type
 operator+(const A& a)
 { return a; }
 
@@ -874,7 +3055,7 @@ operator*(const Array<d1,T>& a, const Array<d2,T>& b) {
 
 //! operator*(scalar, expr)
 template <typename S, class B>
-typename std::enable_if<is_arithmetic<S>::value, Expr<BinExprOp< ExprLiteral<S>, Expr<B>, ApMul> > >::type
+typename std::enable_if<Is_scalar<S>::value, Expr<BinExprOp< ExprLiteral<S>, Expr<B>, ApMul> > >::type
 operator*(S a, const Expr<B>& b) {
   
   typedef BinExprOp< ExprLiteral<S>, Expr<B>, ApMul> ExprT;
@@ -883,7 +3064,7 @@ operator*(S a, const Expr<B>& b) {
 
 //! operator*(expr, scalar)
 template <typename S, class A>
-typename std::enable_if<is_arithmetic<S>::value, Expr<BinExprOp< ExprLiteral<S>, Expr<A>, ApMul> > >::type
+typename std::enable_if<Is_scalar<S>::value, Expr<BinExprOp< ExprLiteral<S>, Expr<A>, ApMul> > >::type
 operator*(const Expr<A>& a, S b) {
   
   typedef BinExprOp< ExprLiteral<S>, Expr<A>, ApMul> ExprT;
@@ -892,7 +3073,7 @@ operator*(const Expr<A>& a, S b) {
 
 //! operator*(scalar, array addition)
 template <int d, typename S, typename T>
-typename std::enable_if<is_arithmetic<S>::value && is_arithmetic<T>::value, Array<d, T>>::type
+typename std::enable_if<Is_scalar<S>::value && Is_scalar<T>::value, Array<d, T>>::type
 operator*(S a, const AAa<d,T>& b) {
 
   typedef BinExprOp< ExprLiteral<T>, AAa<d,T>, ApMul> ExprT;
@@ -901,20 +3082,20 @@ operator*(S a, const AAa<d,T>& b) {
 
 //! operator*(scalar, scalar*expr)
 template <typename S, class T, class B>
-typename std::enable_if<is_arithmetic<S>::value, Expr<BinExprOp< ExprLiteral<T>, Expr<B>, ApMul> > >::type
+typename std::enable_if<Is_scalar<S>::value, Expr<BinExprOp< ExprLiteral<T>, Expr<B>, ApMul> > >::type
 operator*(S a, const Expr<BinExprOp< ExprLiteral<T>, Expr<B>, ApMul> >& b) {
   
   typedef BinExprOp< ExprLiteral<T>, Expr<B>, ApMul> ExprT;
-  return Expr<ExprT>(ExprT(ExprLiteral<T>(a*b.left()),b.right()));
+  return Expr<ExprT>(ExprT(ExprLiteral<T>(a*b.left()()),b.right()));
 }
 
 //! operator*(scalar, scalar*expr*expr)
 template <typename S, class T, class A, class B>
-typename std::enable_if<is_arithmetic<S>::value, Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> > >::type
+typename std::enable_if<Is_scalar<S>::value, Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> > >::type
 operator*(S a, const Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> >& b) {
   
   typedef BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> ExprT;
-  T scalar = a*b.left().left();
+  T scalar = a*b.left().left()();
   const A& left_expr = b.left().right();
   const Expr<B>& right_expr = b.right();
   
@@ -923,11 +3104,11 @@ operator*(S a, const Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >
 
 //! operator*(scalar*expr*expr, scalar)
 template <typename S, class T, class A, class B>
-typename std::enable_if<is_arithmetic<S>::value, Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> > >::type
+typename std::enable_if<Is_scalar<S>::value, Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> > >::type
 operator*(const Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> >& b, S a) {
   
   typedef BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Expr<B>, ApMul> ExprT;
-  T scalar = a*b.left().left();
+  T scalar = a*b.left().left()();
   const A& left_expr = b.left().right();
   const Expr<B>& right_expr = b.right();
   
@@ -936,16 +3117,16 @@ operator*(const Expr<BinExprOp< Expr<BinExprOp<ExprLiteral<T>, A , ApMul> >, Exp
 
 //! operator*(scalar*expr, scalar)
 template <typename S, class T, class A>
-typename std::enable_if<is_arithmetic<S>::value, Expr<BinExprOp< ExprLiteral<T>, Expr<A>, ApMul> > >::type
+typename std::enable_if<Is_scalar<S>::value, Expr<BinExprOp< ExprLiteral<T>, Expr<A>, ApMul> > >::type
 operator*(const Expr<BinExprOp< ExprLiteral<T>, Expr<A>, ApMul> >& a, S b) {
   
   typedef BinExprOp< ExprLiteral<T>, Expr<A>, ApMul> ExprT;
-  return Expr<ExprT>(ExprT(ExprLiteral<T>(a.left()*b),a.right()));
+  return Expr<ExprT>(ExprT(ExprLiteral<T>(a.left()()*b),a.right()));
 }
 
 //! operator*(scalar, array)
 template <int d, typename S, typename T>
-typename std::enable_if<is_arithmetic<S>::value, SAm<d,T> >::type
+typename std::enable_if<Is_scalar<S>::value, SAm<d,T> >::type
 operator*(S a, const Array<d,T>& b) {
   
   typedef typename SAm<d,T>::expression_type ExprT;
@@ -954,7 +3135,7 @@ operator*(S a, const Array<d,T>& b) {
 
 //! operator*(array, scalar)
 template <int d, typename S, typename T>
-typename std::enable_if<is_arithmetic<S>::value, SAm<d,T> >::type
+typename std::enable_if<Is_scalar<S>::value, SAm<d,T> >::type
 operator*(const Array<d,T>& a, S b) {
   
   typedef typename SAm<d,T>::expression_type ExprT;
@@ -963,20 +3144,20 @@ operator*(const Array<d,T>& a, S b) {
 
 //! operator*(scalar*array, scalar)
 template <int d, typename S, typename T>
-typename std::enable_if<is_arithmetic<S>::value, SAm<d,T> >::type
+typename std::enable_if<Is_scalar<S>::value, SAm<d,T> >::type
 operator*(const SAm<d,T>& a, S b) {
   
   typedef typename SAm<d,T>::expression_type ExprT;
-  return SAm<d,T>(ExprT(ExprLiteral<T>(a.left()*b),a.right()));
+  return SAm<d,T>(ExprT(ExprLiteral<T>(a.left()()*b),a.right()));
 }
 
 //! operator*(scalar, scalar*array)
 template <int d, typename S, typename T>
-typename std::enable_if<is_arithmetic<S>::value, SAm<d,T> >::type
+typename std::enable_if<Is_scalar<S>::value, SAm<d,T> >::type
 operator*(S a, const SAm<d,T>& b) {
   
   typedef typename SAm<d,T>::expression_type ExprT;
-  return SAm<d,T>(ExprT(ExprLiteral<T>(a*b.left()),b.right()));
+  return SAm<d,T>(ExprT(ExprLiteral<T>(a*b.left()()),b.right()));
 }
 
 
@@ -1023,7 +3204,7 @@ operator*(const Array<d,T>& a, const Expr<BinExprOp< ExprLiteral<T>, Expr<B>, Ap
 
 //! operator*(scalar, transposed object)
 template <int d, typename S, typename T>
-typename std::enable_if<is_arithmetic<S>::value,
+typename std::enable_if<Is_scalar<S>::value,
 Expr<
 BinExprOp<
 ExprLiteral<T>,
@@ -1053,7 +3234,7 @@ operator/(const Expr<A>& a, const Expr<B>& b) {
 
 //! operator/(array, scalar)
 template <int d, typename S, typename T>
-typename std::enable_if<is_arithmetic<S>::value, SAm<d,T> >::type
+typename std::enable_if<Is_scalar<S>::value, SAm<d,T> >::type
 operator/(const Array<d,T>& a, S b) {
   
   typedef typename SAm<d,T>::expression_type ExprT;
@@ -1091,7 +3272,7 @@ transpose(const Expr< BinExprOp< ExprLiteral<typename A::value_type>, Expr< BinE
   typedef typename A::value_type value_type;
   
   typedef BinExprOp< ExprLiteral<typename A::value_type>, A , ApMul> ExprT;
-  value_type s = a.left() * a.right().left().left();
+  value_type s = a.left()() * a.right().left().left()();
   return Expr<ExprT>(ExprT(s, a.right().left().right()));
 }
 
@@ -1109,7 +3290,7 @@ operator+=(Array<d,T>& a, const Array<d,T>& b) {
 
 //! operator+=(any, any)
 template <class A, class B>
-typename std::enable_if<!is_arithmetic<A>::value && !is_arithmetic<B>::value, A& >::type
+typename std::enable_if<!Is_scalar<A>::value && !Is_scalar<B>::value, A& >::type
 operator+=(A& a, const B& b) {
   typedef RefBinExprOp<A, B, ApAdd> ExprT;
   return Expr<ExprT>(ExprT(a,b))();
@@ -1134,6 +3315,449 @@ A& operator-=(A& a, const B& b) {
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+// view operators
+
+
+// view addition compound assignment operator taking an arbitrary expression
+template <int k, typename T>
+template <class A>
+View<k,T>& View<k,T>::operator+=(const Expr<A>& expr) {
+  return ApAdd::apply(*this, expr);
+}
+
+//! operator*(scalar, view)
+template <int d, typename S, typename T>
+typename std::enable_if<Is_scalar<S>::value, SWm<d,T> >::type
+operator*(S a, const View<d,T>& b) {
+  
+  typedef typename SWm<d,T>::expression_type ExprT;
+  return SWm<d,T>(ExprT(ExprLiteral<T>(a),b));
+}
+
+//! operator*(view, scalar)
+template <int d, typename S, typename T>
+typename std::enable_if<Is_scalar<S>::value, SWm<d,T> >::type
+operator*(const View<d,T>& a, S b) {
+  
+  typedef typename SWm<d,T>::expression_type ExprT;
+  return SWm<d,T>(ExprT(ExprLiteral<T>(b),a));
+}
+
+//! operator*(scalar, scalar*view)
+template <int d, typename S, typename T>
+typename std::enable_if<Is_scalar<S>::value, SWm<d,T> >::type
+operator*(S a, const SWm<d,T>& b) {
+  
+  typedef typename SWm<d,T>::expression_type ExprT;
+  return SWm<d,T>(ExprT(ExprLiteral<T>(a*b.left()()),b.right()));
+}
+
+//! operator*(scalar*view, scalar)
+template <int d, typename S, typename T>
+typename std::enable_if<Is_scalar<S>::value, SWm<d,T> >::type
+operator*(const SWm<d,T>& a, S b) {
+  
+  typedef typename SWm<d,T>::expression_type ExprT;
+  return SWm<d,T>(ExprT(ExprLiteral<T>(a.left()()*b),a.right()));
+}
+
+//! operator/(view, scalar)
+template <int d, typename S, typename T>
+typename std::enable_if<Is_scalar<S>::value, SWm<d,T> >::type
+operator/(const View<d,T>& a, S b) {
+  
+  typedef typename SWm<d,T>::expression_type ExprT;
+  return SWm<d,T>(ExprT(ExprLiteral<T>(1/b),a));
+}
+
+//! unary operator-(view)
+template <int d, typename T>
+Array<d,T> operator-(const View<d,T>& a) {
+  return T(-1)*a;
+}
+
+//! operator*(view, view)
+template <int d1, int d2, typename T>
+Expr<BinExprOp<SWm<d1,T>, SWm<d2,T>, ApMul> >
+operator*(const View<d1,T>& a, const View<d2,T>& b) {
+  
+  typedef BinExprOp<SWm<d1,T>, SWm<d2,T>, ApMul> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator*(view, array)
+template <int d1, int d2, typename T>
+Expr<BinExprOp<SWm<d1,T>, SAm<d2,T>, ApMul> >
+operator*(const View<d1,T>& a, const Array<d2,T>& b) {
+  
+  typedef BinExprOp<SWm<d1,T>, SAm<d2,T>, ApMul> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator*(array, view)
+template <int d1, int d2, typename T>
+Expr<BinExprOp<SAm<d1,T>, SWm<d2,T>, ApMul> >
+operator*(const Array<d1,T>& a, const View<d2,T>& b) {
+  
+  typedef BinExprOp<SAm<d1,T>, SWm<d2,T>, ApMul> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator*(view, expr)
+template <int d, typename T, class B>
+Expr<BinExprOp<SWm<d,T>, Expr<B>, ApMul> >
+operator*(const View<d,T>& a, const Expr<B>& b) {
+  
+  typedef BinExprOp<SWm<d,T>, Expr<B>, ApMul> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, b));
+}
+
+//! operator*(expr, view)
+template <int d, typename T, class A>
+Expr<BinExprOp<Expr<A>, SWm<d,T>, ApMul> >
+operator*(const Expr<A>& a, const View<d,T>& b) {
+  
+  typedef BinExprOp<Expr<A>, SWm<d,T>, ApMul> ExprT;
+  return Expr<ExprT>(ExprT(a, T(1)*b));
+}
+
+//! operator+(view, view)
+template <int d, typename T>
+Expr<BinExprOp<SWm<d,T>, SWm<d,T>, ApAdd> >
+operator+(const View<d,T>& a, const View<d,T>& b) {
+  
+  typedef BinExprOp<SWm<d,T>, SWm<d,T>, ApAdd> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator+(view, array)
+template <int d, typename T>
+Expr<BinExprOp<SWm<d,T>, SAm<d,T>, ApAdd> >
+operator+(const View<d,T>& a, const Array<d,T>& b) {
+  
+  typedef BinExprOp<SWm<d,T>, SAm<d,T>, ApAdd> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator+(array, view)
+template <int d, typename T>
+Expr<BinExprOp<SAm<d,T>, SWm<d,T>, ApAdd> >
+operator+(const Array<d,T>& a, const View<d,T>& b) {
+  
+  typedef BinExprOp<SAm<d,T>, SWm<d,T>, ApAdd> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator+(view, expr)
+template <int d, typename T, class B>
+Expr<BinExprOp<SWm<d,T>, Expr<B>, ApAdd> >
+operator+(const View<d,T>& a, const Expr<B>& b) {
+  
+  typedef BinExprOp<SWm<d,T>, Expr<B>, ApAdd> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, b));
+}
+
+//! operator+(expr, view)
+template <int d, typename T, class A>
+Expr<BinExprOp<Expr<A>, SWm<d,T>, ApAdd> >
+operator+(const Expr<A>& a, const View<d,T>& b) {
+  
+  typedef BinExprOp<Expr<A>, SWm<d,T>, ApAdd> ExprT;
+  return Expr<ExprT>(ExprT(a, T(1)*b));
+}
+
+//! operator-(view, view)
+template <int d, typename T>
+Expr<BinExprOp<SWm<d,T>, SWm<d,T>, ApSub> >
+operator-(const View<d,T>& a, const View<d,T>& b) {
+  
+  typedef BinExprOp<SWm<d,T>, SWm<d,T>, ApSub> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator-(view, array)
+template <int d, typename T>
+Expr<BinExprOp<SWm<d,T>, SAm<d,T>, ApSub> >
+operator-(const View<d,T>& a, const Array<d,T>& b) {
+  
+  typedef BinExprOp<SWm<d,T>, SAm<d,T>, ApSub> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator-(array, view)
+template <int d, typename T>
+Expr<BinExprOp<SAm<d,T>, SWm<d,T>, ApSub> >
+operator-(const Array<d,T>& a, const View<d,T>& b) {
+  
+  typedef BinExprOp<SAm<d,T>, SWm<d,T>, ApSub> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, T(1)*b));
+}
+
+//! operator-(view, expr)
+template <int d, typename T, class B>
+Expr<BinExprOp<SWm<d,T>, Expr<B>, ApSub> >
+operator-(const View<d,T>& a, const Expr<B>& b) {
+  
+  typedef BinExprOp<SWm<d,T>, Expr<B>, ApSub> ExprT;
+  return Expr<ExprT>(ExprT(T(1)*a, b));
+}
+
+//! operator-(expr, view)
+template <int d, typename T, class A>
+Expr<BinExprOp<Expr<A>, SWm<d,T>, ApSub> >
+operator-(const Expr<A>& a, const View<d,T>& b) {
+  
+  typedef BinExprOp<Expr<A>, SWm<d,T>, ApSub> ExprT;
+  return Expr<ExprT>(ExprT(a, T(1)*b));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// operators for arrays with a non-default allocator
+
+//! Allocator operand class template
+/*! Arrays whose memory is obtained from a non-default allocator take part in
+ * expressions through a view of all their elements, which is stored by value
+ * in the expression. Any other operand is passed through unchanged.
+ */
+template <class A>
+struct Allocator_operand {
+  enum { custom = false };
+  static const A& operand(const A& a) { return a; }
+};
+
+//! Allocator operand partial template specialization for arrays
+template <int d, typename T, class Alloc>
+struct Allocator_operand<Array<d,T,Alloc> > {
+  enum { custom = !std::is_same<Alloc, aligned_allocator<T> >::value };
+  static View<d,T> operand(const Array<d,T,Alloc>& a)
+  { return const_cast<Array<d,T,Alloc>&>(a).view(); }
+};
+
+//! Helper class template that enables the operators below only if an operand
+// is an array with a non-default allocator
+template <class A, class B>
+using Custom_operands = typename std::enable_if<Allocator_operand<A>::custom ||
+Allocator_operand<B>::custom>::type;
+
+//! operator+ for arrays with a non-default allocator
+template <class A, class B, class = Custom_operands<A,B> >
+auto operator+(const A& a, const B& b)
+-> decltype(Allocator_operand<A>::operand(a) + Allocator_operand<B>::operand(b))
+{ return Allocator_operand<A>::operand(a) + Allocator_operand<B>::operand(b); }
+
+//! operator- for arrays with a non-default allocator
+template <class A, class B, class = Custom_operands<A,B> >
+auto operator-(const A& a, const B& b)
+-> decltype(Allocator_operand<A>::operand(a) - Allocator_operand<B>::operand(b))
+{ return Allocator_operand<A>::operand(a) - Allocator_operand<B>::operand(b); }
+
+//! operator* for arrays with a non-default allocator
+template <class A, class B, class = Custom_operands<A,B> >
+auto operator*(const A& a, const B& b)
+-> decltype(Allocator_operand<A>::operand(a) * Allocator_operand<B>::operand(b))
+{ return Allocator_operand<A>::operand(a) * Allocator_operand<B>::operand(b); }
+
+//! operator/ for arrays with a non-default allocator
+template <class A, class B, class = Custom_operands<A,B> >
+auto operator/(const A& a, const B& b)
+-> decltype(Allocator_operand<A>::operand(a) / Allocator_operand<B>::operand(b))
+{ return Allocator_operand<A>::operand(a) / Allocator_operand<B>::operand(b); }
+
+//! unary operator- for arrays with a non-default allocator
+template <int d, typename T, class Alloc,
+class = Custom_operands<Array<d,T,Alloc>, EmptyType> >
+Array<d,T> operator-(const Array<d,T,Alloc>& a) {
+  return -Allocator_operand<Array<d,T,Alloc> >::operand(a);
+}
+
+//! transpose for arrays with a non-default allocator
+template <int d, typename T, class Alloc,
+class = Custom_operands<Array<d,T,Alloc>, EmptyType> >
+auto transpose(const Array<d,T,Alloc>& a)
+-> decltype(transpose(Allocator_operand<Array<d,T,Alloc> >::operand(a)))
+{ return transpose(Allocator_operand<Array<d,T,Alloc> >::operand(a)); }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// element-wise functions
+
+//! Function object for the exponential
+struct Exp_op {
+  template <typename T>
+  T operator()(T x) const
+  { return std::exp(x); }
+  
+  template <typename T>
+  static void apply(size_t n, const T* x, T* y)
+  { Simd::exp(n, x, y); }
+};
+
+//! Function object for the natural logarithm
+struct Log_op {
+  template <typename T>
+  T operator()(T x) const
+  { return std::log(x); }
+  
+  template <typename T>
+  static void apply(size_t n, const T* x, T* y)
+  { Simd::log(n, x, y); }
+};
+
+//! Function object for the square root
+struct Sqrt_op {
+  template <typename T>
+  T operator()(T x) const
+  { return std::sqrt(x); }
+};
+
+//! Function object for the absolute value
+struct Abs_op {
+  template <typename T>
+  auto operator()(T x) const -> decltype(std::abs(x))
+  { return std::abs(x); }
+};
+
+//! Function object for the hyperbolic tangent
+struct Tanh_op {
+  template <typename T>
+  T operator()(T x) const
+  { return std::tanh(x); }
+};
+
+//! Function object for powers
+struct Pow_op {
+  template <typename T>
+  T operator()(T x, T y) const
+  { return std::pow(x, y); }
+};
+
+//! Function object for the larger of two elements
+struct Max_op {
+  template <typename T>
+  T operator()(T x, T y) const
+  { return x < y ? y : x; }
+};
+
+//! Function object for the smaller of two elements
+struct Min_op {
+  template <typename T>
+  T operator()(T x, T y) const
+  { return y < x ? y : x; }
+};
+
+//! Function object for the product of two elements
+struct Hadamard_op {
+  template <typename T>
+  T operator()(T x, T y) const
+  { return x*y; }
+};
+
+//! Function object for the quotient of two elements
+struct Divide_op {
+  template <typename T>
+  T operator()(T x, T y) const
+  { return x/y; }
+};
+
+//! Vectorized function traits partial template specialization for the
+// exponential
+template <typename T>
+struct Vectorized_function<Exp_op, T> : public Simd::Floating<T> {};
+
+//! Vectorized function traits partial template specialization for the
+// logarithm
+template <typename T>
+struct Vectorized_function<Log_op, T> : public Simd::Floating<T> {};
+
+
+//! Element-wise function of an array, view or expression
+/*! The function is evaluated lazily, so it is fused with the element-wise
+ * operations around it, e.g., y = 2.*map(f, x) + z is evaluated in a single
+ * loop without temporaries. The results are converted to the element type.
+ * \param f - Function object taking an element
+ * \param a - Argument of the function
+ */
+template <class F, class A>
+typename std::enable_if<Function_argument<A>::value && !Function_argument<A>::scalar,
+Expr<FunExprOp<F, A, EmptyType> > >::type
+map(const F& f, const A& a) {
+  
+  typedef FunExprOp<F, A, EmptyType> ExprT;
+  return Expr<ExprT>(ExprT(f, a, EmptyType()));
+}
+
+//! Element-wise function of two arrays, views or expressions of the same
+// shape, one of which may be a scalar
+/*! \param f - Function object taking two elements
+ * \param a - First argument of the function
+ * \param b - Second argument of the function
+ */
+template <class F, class A, class B>
+typename std::enable_if<Function_argument<A>::value && Function_argument<B>::value &&
+!(Function_argument<A>::scalar && Function_argument<B>::scalar),
+Expr<FunExprOp<F, typename Function_argument<A>::type, typename Function_argument<B>::type> >
+>::type
+map(const F& f, const A& a, const B& b) {
+  
+  typedef FunExprOp<F, typename Function_argument<A>::type,
+  typename Function_argument<B>::type> ExprT;
+  return Expr<ExprT>(ExprT(f, a, b));
+}
+
+//! Element-wise exponential, vectorized for float and double elements
+template <class A>
+auto exp(const A& a) -> decltype(map(Exp_op(), a))
+{ return map(Exp_op(), a); }
+
+//! Element-wise natural logarithm, vectorized for float and double elements
+template <class A>
+auto log(const A& a) -> decltype(map(Log_op(), a))
+{ return map(Log_op(), a); }
+
+//! Element-wise square root
+template <class A>
+auto sqrt(const A& a) -> decltype(map(Sqrt_op(), a))
+{ return map(Sqrt_op(), a); }
+
+//! Element-wise absolute value
+template <class A>
+auto abs(const A& a) -> decltype(map(Abs_op(), a))
+{ return map(Abs_op(), a); }
+
+//! Element-wise hyperbolic tangent
+template <class A>
+auto tanh(const A& a) -> decltype(map(Tanh_op(), a))
+{ return map(Tanh_op(), a); }
+
+//! Element-wise power, either argument may be a scalar
+template <class A, class B>
+auto pow(const A& a, const B& b) -> decltype(map(Pow_op(), a, b))
+{ return map(Pow_op(), a, b); }
+
+//! Element-wise maximum, either argument may be a scalar, e.g., max(x, 0.)
+template <class A, class B>
+auto max(const A& a, const B& b) -> decltype(map(Max_op(), a, b))
+{ return map(Max_op(), a, b); }
+
+//! Element-wise minimum, either argument may be a scalar
+template <class A, class B>
+auto min(const A& a, const B& b) -> decltype(map(Min_op(), a, b))
+{ return map(Min_op(), a, b); }
+
+//! Element-wise (Hadamard) product of two arrays of the same shape
+template <class A, class B>
+auto hadamard(const A& a, const B& b) -> decltype(map(Hadamard_op(), a, b))
+{ return map(Hadamard_op(), a, b); }
+
+//! Element-wise quotient of two arrays of the same shape, either argument may
+// be a scalar
+template <class A, class B>
+auto divide(const A& a, const B& b) -> decltype(map(Divide_op(), a, b))
+{ return map(Divide_op(), a, b); }
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // operator<<
 
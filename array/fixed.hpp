@@ -0,0 +1,549 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file fixed.hpp
+ *
+ * \brief This file contains the Array partial template specialization for
+ * arrays whose extents are known at compile time, e.g., the 3x3 matrices and
+ * 3x3x3x3 tensors of finite element computations.
+ */
+
+#ifndef ARRAY_FIXED_HPP
+#define ARRAY_FIXED_HPP
+
+#include "functions.hpp"
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! Compile-time extents, passed to Array in place of the allocator
+/*! Array<2, double, Extents<3,3> > is a 3x3 matrix stored on the stack.
+ * Extents partial template specialization that finishes the recursion.
+ */
+template <> struct Extents<> {
+
+  //! Number of elements
+  static constexpr size_t size() { return 1; }
+
+  //! Size along the ith direction
+  static constexpr size_t extent(size_t) { return 1; }
+
+  //! Distance between consecutive elements along the ith direction
+  static constexpr size_t stride(size_t) { return 1; }
+};
+
+//! Extents partial template specialization, peels off the first extent
+template <size_t m, size_t... n> struct Extents<m, n...> {
+
+  static_assert(m > 0, "*** ERROR *** Array dimension cannot be zero.");
+
+  //! Number of elements
+  static constexpr size_t size() { return m * Extents<n...>::size(); }
+
+  //! Size along the ith direction
+  static constexpr size_t extent(size_t i) {
+    return i == 0 ? m : Extents<n...>::extent(i - 1);
+  }
+
+  //! Distance between consecutive elements along the ith direction
+  static constexpr size_t stride(size_t i) {
+    return i == 0 ? 1 : m * Extents<n...>::stride(i - 1);
+  }
+};
+
+
+//! Number of iterations up to which Unroll expands a loop at compile time
+constexpr size_t unroll_limit = 16;
+
+//! Loop unrolled at compile time, calls f(i) for i in [o, o + n)
+/*! The range is split in halves, so the recursion depth grows with log2(n)
+ * instead of n. Loops longer than unroll_limit are left to the compiler.
+ */
+template <size_t n, size_t o = 0, bool unrolled = n <= unroll_limit>
+struct Unroll {
+  template <class F> static void apply(F &&f) {
+    Unroll<n / 2, o>::apply(f);
+    Unroll<n - n / 2, o + n / 2>::apply(f);
+  }
+};
+
+//! Loop unrolled at compile time, partial template specialization for loops
+// too long to be unrolled
+template <size_t n, size_t o> struct Unroll<n, o, false> {
+  template <class F> static void apply(F &&f) {
+    for (size_t i = o; i < o + n; ++i)
+      f(i);
+  }
+};
+
+//! Loop unrolled at compile time, partial template specialization for a
+// single iteration
+template <size_t o> struct Unroll<1, o, true> {
+  template <class F> static void apply(F &&f) { f(o); }
+};
+
+//! Loop unrolled at compile time, partial template specialization that
+// finishes the recursion
+template <size_t o> struct Unroll<0, o, true> {
+  template <class F> static void apply(F &&) {}
+};
+
+
+//! Array partial template specialization for compile-time extents
+/*! The elements are stored in the object itself, in the same column-major
+ * order as dynamic arrays, so no memory is allocated. Element access uses
+ * constant strides, and the operators below evaluate eagerly into new fixed
+ * arrays with loops that are unrolled at compile time instead of calling
+ * BLAS or LAPACK, which only pay off for larger arrays.
+ * \tparam k - Tensor rank
+ * \tparam T - Type stored in the tensor
+ * \tparam n - Tensor dimensions
+ */
+template <int k, typename T, size_t... n> class Array<k, T, Extents<n...> > {
+
+  static_assert(sizeof...(n) == k,
+                "*** ERROR *** Number of extents does not match array rank.");
+
+public:
+  typedef T value_type;
+  typedef Extents<n...> extents_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T *iterator;
+  typedef const T *const_iterator;
+
+private:
+  T data_[extents_type::size()]; //!< Tensor elements
+
+  template <int, typename, class> friend class Array;
+
+public:
+  //! Rank of the tensor
+  constexpr static int rank() { return k; }
+
+  //! Size of the tensor
+  constexpr static size_t size() { return extents_type::size(); }
+
+  //! Size along the ith direction
+  constexpr static size_t size(size_t i) { return extents_type::extent(i); }
+
+  //! Distance between consecutive elements along dimension dim
+  constexpr static size_t stride(size_t dim) { return extents_type::stride(dim); }
+
+  //! Matrix rows
+  constexpr static size_t rows() {
+    static_assert(k == 2, "*** ERROR *** Rows are only defined for matrices.");
+    return size(0);
+  }
+
+  //! Matrix columns
+  constexpr static size_t columns() {
+    static_assert(k == 2, "*** ERROR *** Columns are only defined for matrices.");
+    return size(1);
+  }
+
+  //! Pointer to memory for raw access
+  pointer data() { return data_; }
+
+  //! Pointer to memory for raw access
+  const_pointer data() const { return data_; }
+
+  //! Default constructor, all elements are set to zero
+  Array() : data_() {}
+
+  //! Constructor that leaves the elements uninitialized
+  explicit Array(UninitializedType) {}
+
+  //! Constructor that sets all elements to v
+  explicit Array(value_type v) {
+    Unroll<size()>::apply([&](size_t i) { data_[i] = v; });
+  }
+
+  //! Helper structure used to process initializer lists
+  template <int d, typename U> struct Initializer_list {
+
+    typedef std::initializer_list<
+    typename Initializer_list<d - 1, U>::list_type> list_type;
+
+    static void process(list_type l, pointer p) {
+
+      assert(l.size() == size(k - d));
+      size_t j = 0;
+      for (const auto &r : l)
+        Initializer_list<d - 1, U>::process(r, p + stride(k - d) * j++);
+    }
+  };
+
+  //! Helper structure used to process initializer lists, partial template
+  //specialization to finish recursion
+  template <typename U> struct Initializer_list<1, U> {
+
+    typedef std::initializer_list<U> list_type;
+
+    static void process(list_type l, pointer p) {
+
+      assert(l.size() == size(k - 1));
+      size_t j = 0;
+      for (const auto &r : l)
+        p[stride(k - 1) * j++] = r;
+    }
+  };
+
+  typedef typename Initializer_list<k, T>::list_type initializer_type;
+
+  //! Initializer list constructor, the outer list runs along the first
+  // dimension as for dynamic arrays
+  Array(initializer_type l) { Initializer_list<k, T>::process(l, data_); }
+
+  //! Constructor taking a dynamic array with the same extents
+  template <class S> explicit Array(const Array<k, T, S> &a) {
+    for (int i = 0; i < k; ++i)
+      assert(a.size(i) == size(i));
+    std::copy_n(a.data(), size(), data_);
+  }
+
+private:
+  //! Helper function used to compute the index on the one-dimensional array
+  //that stores the tensor elements, the strides are compile-time constants
+  template <int d, typename I> static size_t index(I i) {
+    assert(static_cast<size_t>(i) < size(d));
+    return i * stride(d);
+  }
+
+  //! Helper function used to compute the index, recursion over the indices
+  template <int d, typename I, typename... Rest>
+  static size_t index(I i, Rest... rest) {
+    return index<d>(i) + index<d + 1>(rest...);
+  }
+
+public:
+  //! Indexed access through operator()
+  template <typename... Args> reference operator()(Args... params) {
+
+    static_assert(sizeof...(Args) == k,
+                  "*** ERROR *** Number of parameters does not match array rank.");
+    return data_[index<0>(params...)];
+  }
+
+  //! Indexed access through operator() for constant tensors
+  template <typename... Args> value_type operator()(Args... params) const {
+
+    static_assert(sizeof...(Args) == k,
+                  "*** ERROR *** Number of parameters does not match array rank.");
+    return data_[index<0>(params...)];
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // compound assignment operators
+
+  //! Multiplication compound assignment operator
+  Array &operator*=(value_type s) {
+    Unroll<size()>::apply([&](size_t i) { data_[i] *= s; });
+    return *this;
+  }
+
+  //! Division compound assignment operator
+  Array &operator/=(value_type s) {
+    Unroll<size()>::apply([&](size_t i) { data_[i] /= s; });
+    return *this;
+  }
+
+  //! Summation compound assignment operator
+  Array &operator+=(const Array &b) {
+    Unroll<size()>::apply([&](size_t i) { data_[i] += b.data_[i]; });
+    return *this;
+  }
+
+  //! Subtraction compound assignment operator
+  Array &operator-=(const Array &b) {
+    Unroll<size()>::apply([&](size_t i) { data_[i] -= b.data_[i]; });
+    return *this;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // norms
+
+  //! Norm of a vector or matrix
+  /*! Vectors support the 1-, 2- and infinity norms, matrices the 1- and
+   * infinity norms, as their dynamic counterparts. The default is the
+   * 2-norm for vectors and the 1-norm for matrices.
+   */
+  typename Real_type<T>::type norm(Norm_type t = k == 1 ? Norm_2 : Norm_1) const {
+    static_assert(k == 1 || k == 2,
+                  "*** ERROR *** Norms are only defined for vectors and matrices.");
+    return norm(t, Int2Type<k>());
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // iterator functions
+
+  iterator begin() { return data_; }
+  const_iterator begin() const { return data_; }
+  iterator end() { return data_ + size(); }
+  const_iterator end() const { return data_ + size(); }
+
+  //! Standard output
+  friend std::ostream &operator<<(std::ostream &os, const Array &a) {
+    const size_t dims[] = { n... };
+    return Print<k>::print(os, dims, a.data_);
+  }
+
+private:
+  //! Helper function used by norm for vectors
+  typename Real_type<T>::type norm(Norm_type t, Int2Type<1>) const {
+
+    typedef typename Real_type<T>::type real_type;
+    real_type r = real_type();
+    switch (t) {
+      case Norm_1:
+        Unroll<size()>::apply([&](size_t i) { r += std::abs(data_[i]); });
+        break;
+      case Norm_2:
+        Unroll<size()>::apply([&](size_t i) { r += std::norm(data_[i]); });
+        r = std::sqrt(r);
+        break;
+      case Norm_inf:
+        Unroll<size()>::apply([&](size_t i) { r = std::max<real_type>(r, std::abs(data_[i])); });
+        break;
+      default:
+        cout<<"Error: "<<t<<" not implemented for vectors"<<endl;
+        exit(1);
+    }
+    return r;
+  }
+
+  //! Helper function used by norm for matrices
+  typename Real_type<T>::type norm(Norm_type t, Int2Type<2>) const {
+
+    typedef typename Real_type<T>::type real_type;
+    real_type r = real_type();
+    switch (t) {
+      case Norm_1:
+        // maximum absolute column sum
+        Unroll<columns()>::apply([&](size_t j) {
+          real_type s = real_type();
+          Unroll<rows()>::apply([&](size_t i) { s += std::abs(data_[i + j * rows()]); });
+          r = std::max(r, s);
+        });
+        break;
+      case Norm_inf:
+        // maximum absolute row sum
+        Unroll<rows()>::apply([&](size_t i) {
+          real_type s = real_type();
+          Unroll<columns()>::apply([&](size_t j) { s += std::abs(data_[i + j * rows()]); });
+          r = std::max(r, s);
+        });
+        break;
+      default:
+        cout<<"Error: "<<t<<" not implemented for matrices"<<endl;
+        exit(1);
+    }
+    return r;
+  }
+};
+
+
+// copy helper taking a fixed array, used by the dynamic array constructor and
+// assignment operator that take arrays with a different allocator, so that
+// fixed arrays can be handed to the expression templates and to the BLAS and
+// LAPACK based functions
+template <int k, typename T, class Alloc>
+template <size_t... m>
+void Array<k, T, Alloc>::copy(const Array<k, T, Extents<m...> > &src) {
+
+  for (int i = 0; i < k; ++i)
+    n_[i] = src.size(i);
+  wrapped_ = false;
+  data_ = allocate(init_strides());
+  std::uninitialized_copy_n(src.data(), src.size(), data_);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// fixed-extent alias templates
+
+//! Vector with m elements stored on the stack
+template <size_t m, typename T = double>
+using fixed_vector_type = Array<1, T, Extents<m> >;
+
+//! Matrix with m rows and n columns stored on the stack
+template <size_t m, size_t n, typename T = double>
+using fixed_matrix_type = Array<2, T, Extents<m, n> >;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// fixed-extent operators
+
+//! operator+(fixed array, fixed array)
+template <int k, typename T, size_t... n>
+Array<k, T, Extents<n...> > operator+(const Array<k, T, Extents<n...> > &a,
+                                      const Array<k, T, Extents<n...> > &b) {
+  Array<k, T, Extents<n...> > r(uninitialized);
+  Unroll<Extents<n...>::size()>::apply(
+      [&](size_t i) { r.data()[i] = a.data()[i] + b.data()[i]; });
+  return r;
+}
+
+//! operator-(fixed array, fixed array)
+template <int k, typename T, size_t... n>
+Array<k, T, Extents<n...> > operator-(const Array<k, T, Extents<n...> > &a,
+                                      const Array<k, T, Extents<n...> > &b) {
+  Array<k, T, Extents<n...> > r(uninitialized);
+  Unroll<Extents<n...>::size()>::apply(
+      [&](size_t i) { r.data()[i] = a.data()[i] - b.data()[i]; });
+  return r;
+}
+
+//! unary operator-(fixed array)
+template <int k, typename T, size_t... n>
+Array<k, T, Extents<n...> > operator-(const Array<k, T, Extents<n...> > &a) {
+  Array<k, T, Extents<n...> > r(uninitialized);
+  Unroll<Extents<n...>::size()>::apply([&](size_t i) { r.data()[i] = -a.data()[i]; });
+  return r;
+}
+
+//! operator*(scalar, fixed array)
+template <typename S, int k, typename T, size_t... n>
+typename std::enable_if<Is_scalar<S>::value, Array<k, T, Extents<n...> > >::type
+operator*(S s, const Array<k, T, Extents<n...> > &a) {
+  Array<k, T, Extents<n...> > r(uninitialized);
+  Unroll<Extents<n...>::size()>::apply([&](size_t i) { r.data()[i] = s * a.data()[i]; });
+  return r;
+}
+
+//! operator*(fixed array, scalar)
+template <typename S, int k, typename T, size_t... n>
+typename std::enable_if<Is_scalar<S>::value, Array<k, T, Extents<n...> > >::type
+operator*(const Array<k, T, Extents<n...> > &a, S s) {
+  return s * a;
+}
+
+//! operator/(fixed array, scalar)
+template <typename S, int k, typename T, size_t... n>
+typename std::enable_if<Is_scalar<S>::value, Array<k, T, Extents<n...> > >::type
+operator/(const Array<k, T, Extents<n...> > &a, S s) {
+  Array<k, T, Extents<n...> > r(uninitialized);
+  Unroll<Extents<n...>::size()>::apply([&](size_t i) { r.data()[i] = a.data()[i] / s; });
+  return r;
+}
+
+//! operator*(fixed matrix, fixed matrix)
+template <typename T, size_t m, size_t p, size_t q>
+Array<2, T, Extents<m, q> > operator*(const Array<2, T, Extents<m, p> > &a,
+                                      const Array<2, T, Extents<p, q> > &b) {
+  Array<2, T, Extents<m, q> > c(uninitialized);
+  const T *pa = a.data(), *pb = b.data();
+  T *pc = c.data();
+  Unroll<q>::apply([&](size_t j) {
+    Unroll<m>::apply([&](size_t i) {
+      T s = T();
+      Unroll<p>::apply([&](size_t l) { s += pa[i + l * m] * pb[l + j * p]; });
+      pc[i + j * m] = s;
+    });
+  });
+  return c;
+}
+
+//! operator*(fixed matrix, fixed vector)
+template <typename T, size_t m, size_t p>
+Array<1, T, Extents<m> > operator*(const Array<2, T, Extents<m, p> > &a,
+                                   const Array<1, T, Extents<p> > &x) {
+  Array<1, T, Extents<m> > y(uninitialized);
+  const T *pa = a.data(), *px = x.data();
+  T *py = y.data();
+  Unroll<m>::apply([&](size_t i) {
+    T s = T();
+    Unroll<p>::apply([&](size_t l) { s += pa[i + l * m] * px[l]; });
+    py[i] = s;
+  });
+  return y;
+}
+
+//! Transpose of a fixed matrix
+template <typename T, size_t m, size_t n>
+Array<2, T, Extents<n, m> > transpose(const Array<2, T, Extents<m, n> > &a) {
+  Array<2, T, Extents<n, m> > r(uninitialized);
+  const T *pa = a.data();
+  T *pr = r.data();
+  Unroll<n>::apply([&](size_t j) {
+    Unroll<m>::apply([&](size_t i) { pr[j + i * n] = pa[i + j * m]; });
+  });
+  return r;
+}
+
+//! Inverse of a fixed square matrix
+/*! Computed by Gauss-Jordan elimination with partial pivoting on a copy that
+ * lives on the stack. Throws SingularMatrixException with the (one based)
+ * index of the zero pivot, like the LAPACK based inverse.
+ */
+template <typename T, size_t m>
+Array<2, T, Extents<m, m> > inverse(const Array<2, T, Extents<m, m> > &A) {
+
+  Array<2, T, Extents<m, m> > a(A), r(uninitialized);
+  T *pa = a.data(), *pr = r.data();
+
+  // start from the identity
+  Unroll<m * m>::apply([&](size_t i) { pr[i] = i % (m + 1) == 0 ? T(1) : T(); });
+
+  for (size_t c = 0; c < m; ++c) {
+
+    // find pivot row
+    size_t p = c;
+    for (size_t i = c + 1; i < m; ++i)
+      if (std::abs(pa[i + c * m]) > std::abs(pa[p + c * m]))
+        p = i;
+    if (pa[p + c * m] == T())
+      throw SingularMatrixException(c + 1);
+
+    // swap rows
+    if (p != c)
+      Unroll<m>::apply([&](size_t j) {
+        std::swap(pa[c + j * m], pa[p + j * m]);
+        std::swap(pr[c + j * m], pr[p + j * m]);
+      });
+
+    // scale pivot row
+    const T s = T(1) / pa[c + c * m];
+    Unroll<m>::apply([&](size_t j) {
+      pa[c + j * m] *= s;
+      pr[c + j * m] *= s;
+    });
+
+    // eliminate column c from the other rows
+    Unroll<m>::apply([&](size_t i) {
+      const T f = pa[i + c * m];
+      if (i == c || f == T())
+        return;
+      Unroll<m>::apply([&](size_t j) {
+        pa[i + j * m] -= f * pa[c + j * m];
+        pr[i + j * m] -= f * pr[c + j * m];
+      });
+    });
+  }
+  return r;
+}
+
+
+__END_ARRAY_NAMESPACE__
+
+#endif /* ARRAY_FIXED_HPP */
@@ -28,10 +28,13 @@
 #define CPPARRAY_FUNCTIONS_HPP
 
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include "expr.hpp"
 
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 
 __BEGIN_ARRAY_NAMESPACE__
@@ -40,14 +43,14 @@ __BEGIN_ARRAY_NAMESPACE__
  *
  * This functions creates a square tensor and puts the value 1 in the diagonal.
  */
-template <int k, typename T> Array<k, T> identity(size_t s) {
+template <int k, typename T, class Alloc> Array<k, T, Alloc> identity(size_t s) {
 
   static_assert(k != 1, "Error: Cannot create identity vector");
 
-  Array<k, T> a(s);
+  Array<k, T, Alloc> a(s);
   size_t idx = 1;
   for (int i = 1; i < k; ++i)
-    idx += pow(s, i);
+    idx += std::pow(s, i);
   for (int i = 0; i < s; ++i)
     a.data_[i * idx] = 1.;
   return a;
@@ -55,7 +58,8 @@ template <int k, typename T> Array<k, T> identity(size_t s) {
 
 /*! \brief Creates a vector from a matrix by stacking columns
  */
-template <int k, typename T> Array<1, T> vec(const Array<k, T> &m) {
+template <int k, typename T, class Alloc>
+Array<1, T> vec(const Array<k, T, Alloc> &m) {
   return m.vec();
 }
 
@@ -63,7 +67,7 @@ template <int k, typename T> Array<1, T> vec(const Array<k, T> &m) {
 
 //! Cast scalar into an Array
 template <class S, typename T>
-typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<S, T>::value,
+typename std::enable_if<Is_scalar<T>::value && !std::is_same<S, T>::value,
                         S>::type
 algebraic_cast(T v) {
   S s(1);
@@ -72,54 +76,447 @@ algebraic_cast(T v) {
 }
 
 //! Cast Array into a scalar
-template <class S, int k, typename T>
-typename std::enable_if<std::is_arithmetic<S>::value, S>::type
-algebraic_cast(const Array<k, T> &a) {
+template <class S, int k, typename T, class Alloc>
+typename std::enable_if<Is_scalar<S>::value, S>::type
+algebraic_cast(const Array<k, T, Alloc> &a) {
   return a.template algebraic_cast<S>();
 }
 
 //! Provide casting between arrays
-template <class S, int k, typename T>
-typename std::enable_if<!std::is_arithmetic<S>::value, S>::type
-algebraic_cast(const Array<k, T> &m) {
+template <class S, int k, typename T, class Alloc>
+typename std::enable_if<!Is_scalar<S>::value, S>::type
+algebraic_cast(const Array<k, T, Alloc> &m) {
   static_assert(
-      S::rank() != Array<k, T>::rank(),
+      S::rank() != k,
       "Error: Algebraic cast does not work for Array objects of the same type");
   return m.template algebraic_cast<S>();
 }
 
-#if defined(HAVE_LAPACK) || defined(HAVE_CLAPACK)
+//! Symmetric matrix tag
+/*! Refers to a matrix that is known to be symmetric, so that its products
+ * with vectors and matrices are evaluated with BLAS symv and symm, which only
+ * read its lower triangle. Created with symmetric(A), e.g., y = symmetric(K)*x.
+ */
+template <typename T, class S> class Symmetric {
+
+  const Array<2, T, S> &a_; //!< Symmetric matrix
+
+public:
+  typedef T value_type;
+
+  //! Constructor
+  explicit Symmetric(const Array<2, T, S> &a) : a_(a) {
+    assert(a.rows() == a.columns());
+  }
+
+  //! Symmetric matrix
+  const Array<2, T, S> &matrix() const { return a_; }
+
+  //! Number of rows and columns
+  size_t size() const { return a_.rows(); }
+
+  //! Pointer to memory, as taken by BLAS
+  T *data() const { return const_cast<T *>(a_.data()); }
+};
+
+//! Tags a matrix as symmetric, see Symmetric
+template <typename T, class S> Symmetric<T, S> symmetric(const Array<2, T, S> &a) {
+  return Symmetric<T, S>(a);
+}
+
+//! operator*(symmetric matrix, vector), evaluated with symv
+template <typename T, class S, class V>
+Array<1, T, V> operator*(const Symmetric<T, S> &a, const Array<1, T, V> &x) {
+
+  assert(x.size() == a.size());
+  Array<1, T, V> y(a.size(), uninitialized);
+  cblas_symv<T>(CblasLower, a.size(), T(1), a.data(), a.size(),
+                const_cast<T *>(x.data()), 1, T(), y.data(), 1);
+  return y;
+}
+
+//! operator*(symmetric matrix, matrix), evaluated with symm
+template <typename T, class S, class M>
+Array<2, T, M> operator*(const Symmetric<T, S> &a, const Array<2, T, M> &b) {
+
+  assert(b.rows() == a.size());
+  Array<2, T, M> c(b.rows(), b.columns(), uninitialized);
+  cblas_symm<T>(CblasLeft, CblasLower, c.rows(), c.columns(), T(1), a.data(),
+                a.size(), const_cast<T *>(b.data()), b.rows(), T(), c.data(),
+                c.rows());
+  return c;
+}
+
+//! operator*(matrix, symmetric matrix), evaluated with symm
+template <typename T, class S, class M>
+Array<2, T, M> operator*(const Array<2, T, M> &b, const Symmetric<T, S> &a) {
+
+  assert(b.columns() == a.size());
+  Array<2, T, M> c(b.rows(), b.columns(), uninitialized);
+  cblas_symm<T>(CblasRight, CblasLower, c.rows(), c.columns(), T(1), a.data(),
+                a.size(), const_cast<T *>(b.data()), b.rows(), T(), c.data(),
+                c.rows());
+  return c;
+}
+
+//! Triangular matrix tag
+/*! Refers to the upper or lower triangle of a matrix, optionally with a unit
+ * diagonal that is not read, so that products are evaluated with BLAS trmm and
+ * systems are solved with trsv and trsm without forming an inverse. Created
+ * with upper(A), lower(A), unit_upper(A) and unit_lower(A). Transposes and
+ * inverses are kept lazy, e.g., x = inverse(lower(L))*b solves L x = b.
+ */
+template <typename T, class S> class Triangular {
+
+  const Array<2, T, S> &a_; //!< Matrix whose triangle is referenced
+  bool upper_;              //!< Upper or lower triangle
+  bool unit_;               //!< Unit diagonal, not referenced
+  bool transposed_;         //!< Transposed triangle
+
+public:
+  typedef T value_type;
+
+  //! Constructor
+  Triangular(const Array<2, T, S> &a, bool upper, bool unit,
+             bool transposed = false)
+      : a_(a), upper_(upper), unit_(unit), transposed_(transposed) {
+    assert(a.rows() == a.columns());
+  }
+
+  //! Matrix whose triangle is referenced
+  const Array<2, T, S> &matrix() const { return a_; }
+
+  //! Number of rows and columns
+  size_t size() const { return a_.rows(); }
+
+  //! Pointer to memory, as taken by BLAS
+  T *data() const { return const_cast<T *>(a_.data()); }
+
+  //! Whether the upper triangle is referenced
+  bool upper() const { return upper_; }
+
+  //! Whether the diagonal is taken as one
+  bool unit() const { return unit_; }
+
+  //! Whether the triangle is transposed
+  bool transposed() const { return transposed_; }
+};
+
+//! Inverse of a triangular matrix, never formed but applied through trsv and
+// trsm
+template <typename T, class S> class Triangular_inverse {
+
+  Triangular<T, S> t_; //!< Inverted triangular matrix
+
+public:
+  //! Constructor
+  explicit Triangular_inverse(const Triangular<T, S> &t) : t_(t) {}
+
+  //! Inverted triangular matrix
+  const Triangular<T, S> &triangular() const { return t_; }
+};
+
+//! Tags the upper triangle of a matrix, see Triangular
+template <typename T, class S> Triangular<T, S> upper(const Array<2, T, S> &a) {
+  return Triangular<T, S>(a, true, false);
+}
+
+//! Tags the lower triangle of a matrix, see Triangular
+template <typename T, class S> Triangular<T, S> lower(const Array<2, T, S> &a) {
+  return Triangular<T, S>(a, false, false);
+}
+
+//! Tags the upper triangle of a matrix with a unit diagonal, see Triangular
+template <typename T, class S>
+Triangular<T, S> unit_upper(const Array<2, T, S> &a) {
+  return Triangular<T, S>(a, true, true);
+}
+
+//! Tags the lower triangle of a matrix with a unit diagonal, see Triangular
+template <typename T, class S>
+Triangular<T, S> unit_lower(const Array<2, T, S> &a) {
+  return Triangular<T, S>(a, false, true);
+}
+
+//! Transpose of a triangular matrix
+template <typename T, class S>
+Triangular<T, S> transpose(const Triangular<T, S> &t) {
+  return Triangular<T, S>(t.matrix(), t.upper(), t.unit(), !t.transposed());
+}
+
+//! Inverse of a triangular matrix
+template <typename T, class S>
+Triangular_inverse<T, S> inverse(const Triangular<T, S> &t) {
+  return Triangular_inverse<T, S>(t);
+}
+
+//! Solve the triangular system t x = b, overwriting the vector b with x (trsv)
+template <typename T, class S, class V>
+void solve_in_place(const Triangular<T, S> &t, Array<1, T, V> &b) {
+
+  assert(b.size() == t.size());
+  cblas_trsv<T>(t.upper() ? CblasUpper : CblasLower,
+                t.transposed() ? CblasTrans : CblasNoTrans,
+                t.unit() ? CblasUnit : CblasNonUnit, t.size(), t.data(),
+                t.size(), b.data(), 1);
+}
+
+//! Solve the triangular systems t X = B, overwriting the matrix B with X
+// (trsm)
+template <typename T, class S, class M>
+void solve_in_place(const Triangular<T, S> &t, Array<2, T, M> &b) {
+
+  assert(b.rows() == t.size());
+  cblas_trsm<T>(CblasLeft, t.upper() ? CblasUpper : CblasLower,
+                t.transposed() ? CblasTrans : CblasNoTrans,
+                t.unit() ? CblasUnit : CblasNonUnit, b.rows(), b.columns(),
+                T(1), t.data(), t.size(), b.data(), b.rows());
+}
+
+//! Solution of the triangular system t x = b for a vector or matrix b
+template <int k, typename T, class S, class B>
+Array<k, T, B> solve(const Triangular<T, S> &t, const Array<k, T, B> &b) {
+  Array<k, T, B> x(b);
+  solve_in_place(t, x);
+  return x;
+}
+
+//! operator*(inverse of triangular matrix, vector or matrix), evaluated with
+// trsv or trsm
+template <int k, typename T, class S, class B>
+Array<k, T, B> operator*(const Triangular_inverse<T, S> &t,
+                         const Array<k, T, B> &b) {
+  return solve(t.triangular(), b);
+}
+
+//! operator*(matrix, inverse of triangular matrix), evaluated with trsm
+template <typename T, class S, class M>
+Array<2, T, M> operator*(const Array<2, T, M> &b,
+                         const Triangular_inverse<T, S> &i) {
+
+  const Triangular<T, S> &t = i.triangular();
+  assert(b.columns() == t.size());
+  Array<2, T, M> x(b);
+  cblas_trsm<T>(CblasRight, t.upper() ? CblasUpper : CblasLower,
+                t.transposed() ? CblasTrans : CblasNoTrans,
+                t.unit() ? CblasUnit : CblasNonUnit, x.rows(), x.columns(),
+                T(1), t.data(), t.size(), x.data(), x.rows());
+  return x;
+}
+
+//! operator*(triangular matrix, vector or matrix), evaluated with trmm
+template <int k, typename T, class S, class B>
+Array<k, T, B> operator*(const Triangular<T, S> &t, const Array<k, T, B> &b) {
+
+  static_assert(k == 1 || k == 2,
+                "Error: Triangular matrices multiply vectors and matrices");
+  assert(b.size(0) == t.size());
+  Array<k, T, B> x(b);
+  const size_t n = k == 1 ? 1 : b.size(1);
+  cblas_trmm<T>(CblasLeft, t.upper() ? CblasUpper : CblasLower,
+                t.transposed() ? CblasTrans : CblasNoTrans,
+                t.unit() ? CblasUnit : CblasNonUnit, t.size(), n, T(1),
+                t.data(), t.size(), x.data(), t.size());
+  return x;
+}
+
+//! operator*(matrix, triangular matrix), evaluated with trmm
+template <typename T, class S, class M>
+Array<2, T, M> operator*(const Array<2, T, M> &b, const Triangular<T, S> &t) {
+
+  assert(b.columns() == t.size());
+  Array<2, T, M> x(b);
+  cblas_trmm<T>(CblasRight, t.upper() ? CblasUpper : CblasLower,
+                t.transposed() ? CblasTrans : CblasNoTrans,
+                t.unit() ? CblasUnit : CblasNonUnit, x.rows(), x.columns(),
+                T(1), t.data(), t.size(), x.data(), x.rows());
+  return x;
+}
+
+//! Conjugate transpose tag
+/*! Refers to the conjugate transpose of a matrix, so that its products are
+ * evaluated by BLAS gemv and gemm with the CblasConjTrans flag instead of
+ * forming the adjoint, e.g., y = adjoint(A)*x. For real matrices this is the
+ * transpose. Assigning the tag to a matrix forms the adjoint explicitly.
+ */
+template <typename T, class S> class Adjoint {
+
+  const Array<2, T, S> &a_; //!< Matrix whose adjoint is referenced
+
+public:
+  typedef T value_type;
+
+  //! Constructor
+  explicit Adjoint(const Array<2, T, S> &a) : a_(a) {}
+
+  //! Matrix whose adjoint is referenced
+  const Array<2, T, S> &matrix() const { return a_; }
+
+  //! Number of rows of the adjoint
+  size_t rows() const { return a_.columns(); }
+
+  //! Number of columns of the adjoint
+  size_t columns() const { return a_.rows(); }
+
+  //! Pointer to memory, as taken by BLAS
+  T *data() const { return const_cast<T *>(a_.data()); }
+
+  //! Conversion to the explicit conjugate transpose
+  operator Array<2, T>() const {
+    Array<2, T> r(rows(), columns(), uninitialized);
+    for (size_t j = 0; j < r.columns(); ++j)
+      for (size_t i = 0; i < r.rows(); ++i)
+        r(i, j) = conj(a_(j, i));
+    return r;
+  }
+
+private:
+  template <typename U>
+  static typename std::enable_if<Is_complex<U>::value, U>::type conj(U x) {
+    return std::conj(x);
+  }
+
+  template <typename U>
+  static typename std::enable_if<!Is_complex<U>::value, U>::type conj(U x) {
+    return x;
+  }
+};
+
+//! Tags the conjugate transpose of a matrix, see Adjoint
+template <typename T, class S> Adjoint<T, S> adjoint(const Array<2, T, S> &a) {
+  return Adjoint<T, S>(a);
+}
+
+//! operator*(adjoint matrix, vector), evaluated with gemv
+template <typename T, class S, class V>
+Array<1, T, V> operator*(const Adjoint<T, S> &a, const Array<1, T, V> &x) {
+
+  assert(x.size() == a.columns());
+  Array<1, T, V> y(a.rows(), uninitialized);
+  cblas_gemv<T>(CblasConjTrans, a.columns(), a.rows(), T(1), a.data(),
+                a.columns(), const_cast<T *>(x.data()), 1, T(), y.data(), 1);
+  return y;
+}
+
+//! operator*(adjoint matrix, matrix), evaluated with gemm
+template <typename T, class S, class M>
+Array<2, T, M> operator*(const Adjoint<T, S> &a, const Array<2, T, M> &b) {
+
+  assert(b.rows() == a.columns());
+  Array<2, T, M> c(a.rows(), b.columns(), uninitialized);
+  cblas_gemm<T>(CblasConjTrans, CblasNoTrans, c.rows(), c.columns(), b.rows(),
+                T(1), a.data(), a.columns(), const_cast<T *>(b.data()),
+                b.rows(), T(), c.data(), c.rows());
+  return c;
+}
+
+//! operator*(matrix, adjoint matrix), evaluated with gemm
+template <typename T, class S, class M>
+Array<2, T, M> operator*(const Array<2, T, M> &b, const Adjoint<T, S> &a) {
+
+  assert(b.columns() == a.rows());
+  Array<2, T, M> c(b.rows(), a.columns(), uninitialized);
+  cblas_gemm<T>(CblasNoTrans, CblasConjTrans, c.rows(), c.columns(),
+                b.columns(), T(1), const_cast<T *>(b.data()), b.rows(),
+                a.data(), a.columns(), T(), c.data(), c.rows());
+  return c;
+}
+
+//! operator*(adjoint matrix, adjoint matrix), evaluated with gemm
+template <typename T, class S, class R>
+Array<2, T> operator*(const Adjoint<T, S> &a, const Adjoint<T, R> &b) {
+
+  assert(a.columns() == b.rows());
+  Array<2, T> c(a.rows(), b.columns(), uninitialized);
+  cblas_gemm<T>(CblasConjTrans, CblasConjTrans, c.rows(), c.columns(),
+                a.columns(), T(1), a.data(), a.columns(), b.data(),
+                b.columns(), T(), c.data(), c.rows());
+  return c;
+}
+
+//! Conjugated dot product x^H y, evaluated with dotc
+/*! The first vector is conjugated, so dotc(x, x) is the squared 2-norm of a
+ * complex vector. For real vectors this is the dot product.
+ */
+template <typename T, class S, class V>
+T dotc(const Array<1, T, S> &x, const Array<1, T, V> &y) {
+
+  assert(x.size() == y.size());
+  return cblas_dotc<T>(x.size(), const_cast<T *>(x.data()), 1,
+                       const_cast<T *>(y.data()), 1);
+}
+
+//! Scratch memory owned by the calling thread
+/*! Returns a buffer of at least n elements of type T. Every thread keeps one
+ * buffer per type and slot, which only grows, so repeated calls with the same
+ * sizes do not allocate and threads never contend for the allocator. The
+ * contents are undefined and only valid until the next request for the same
+ * type and slot from the same thread.
+ */
+template <typename T, int slot = 0> T *workspace(size_t n) {
+
+  static thread_local std::unique_ptr<T[]> buffer;
+  static thread_local size_t capacity = 0;
+
+  if (capacity < n) {
+    buffer.reset(); // release the old buffer before allocating a larger one
+    buffer.reset(new T[n]);
+    capacity = n;
+  }
+  return buffer.get();
+}
 
 class SingularMatrixException : public std::runtime_error {
 
   size_t f_;
 
+  static std::string message(size_t f) {
+    std::stringstream oss;
+    oss << "Problem encountered factorizing matrix.\nZero factor found in "
+           "upper triangular matrix: u(" << f << "," << f << ") = 0";
+    return oss.str();
+  }
+
 public:
-  SingularMatrixException(size_t f)
-      : std::runtime_error("Problem encountered factorizing matrix."), f_(f) {}
+  SingularMatrixException(size_t f) : std::runtime_error(message(f)), f_(f) {}
 
-  virtual const char *what() const throw() {
-    std::stringstream oss;
-    oss << std::runtime_error::what() << "\nZero factor found in "
-                                         "upper triangular matrix: u(" << f_
-        << "," << f_ << ") = 0";
+  //! Index of the zero factor, one based
+  size_t factor() const { return f_; }
+};
+
+class NotPositiveDefiniteException : public std::runtime_error {
+
+  size_t f_;
 
-    return oss.str().c_str();
+  static std::string message(size_t f) {
+    std::stringstream oss;
+    oss << "Problem encountered factorizing matrix.\nThe leading minor of "
+           "order " << f << " is not positive definite";
+    return oss.str();
   }
+
+public:
+  NotPositiveDefiniteException(size_t f)
+      : std::runtime_error(message(f)), f_(f) {}
+
+  //! Order of the leading minor that is not positive definite
+  size_t order() const { return f_; }
 };
 
-template <int k, typename T> Array<k, T> inverse(const Array<k, T> &A) {
+#if defined(HAVE_LAPACK) || defined(HAVE_CLAPACK)
+
+template <int k, typename T, class Alloc>
+Array<k, T, Alloc> inverse(const Array<k, T, Alloc> &A) {
 
   static_assert(k == 2, "Error: Inverse can only be obtained for matrices");
 
   assert(A.rows() == A.columns());
 
-  Array<k, T> i(A);
+  Array<k, T, Alloc> i(A);
 
+  // pivots and scratch come from the thread's workspace
   int size = A.rows();
-  int *IPIV = new int[size + 1];
-  int LWORK = size * size;
-  double *WORK = new T[LWORK];
+  int *IPIV = workspace<int>(size);
   int INFO;
 
   lapack_getrf(size, size, i.data_, size, IPIV, &INFO);
@@ -127,14 +524,667 @@ template <int k, typename T> Array<k, T> inverse(const Array<k, T> &A) {
   if (INFO != 0)
     throw SingularMatrixException(INFO);
 
-  lapack_getri(size, i.data_, size, IPIV, WORK, LWORK, &INFO);
+  int LWORK = lapack_getri_lwork(size, i.data_, size, IPIV, &INFO);
 
-  delete IPIV;
-  delete WORK;
+  if (INFO != 0)
+    throw SingularMatrixException(INFO);
+
+  lapack_getri(size, i.data_, size, IPIV, workspace<T>(LWORK), LWORK, &INFO);
+
+  if (INFO != 0)
+    throw SingularMatrixException(INFO);
 
   return i;
 }
 
+//! LU factorization of a square matrix
+/*! Factors the matrix once with partial pivoting (LAPACK getrf) and keeps the
+ * factors and the pivots, so that systems with the same matrix and any number
+ * of right-hand sides are solved by forward and backward substitution
+ * (LAPACK getrs). Solving is cheaper and more accurate than multiplying by
+ * the inverse.
+ * \tparam T - Type of the matrix elements
+ * \tparam Alloc - Allocator of the stored factors
+ */
+template <typename T, class Alloc = aligned_allocator<T> > class LU {
+
+public:
+  typedef T value_type;
+  typedef Array<2, T, Alloc> matrix_type;
+
+private:
+  matrix_type lu_;        //!< Factors L and U, the unit diagonal of L is not stored
+  std::vector<int> ipiv_; //!< Pivots, row i was interchanged with row ipiv_[i]-1
+
+public:
+  //! Constructor that factors a copy of the matrix
+  explicit LU(const matrix_type &A) : lu_(A) { factor(); }
+
+  //! Constructor that factors the matrix in place, without copying it
+  explicit LU(matrix_type &&A) : lu_(std::move(A)) { factor(); }
+
+  //! Number of equations
+  size_t size() const { return lu_.rows(); }
+
+  //! Factors L and U stored in a single matrix
+  const matrix_type &factors() const { return lu_; }
+
+  //! Pivot indices, one based as returned by LAPACK
+  const std::vector<int> &pivots() const { return ipiv_; }
+
+  //! Solve the system A x = b, or A' x = b if transposed is true, overwriting
+  // b with the solution x. The right-hand side b is either a vector or a
+  // matrix, in which case every column is solved for.
+  template <int k, class S>
+  void solve_in_place(Array<k, T, S> &b, bool transposed = false) const {
+
+    static_assert(k == 1 || k == 2,
+                  "Error: Right-hand side must be a vector or a matrix");
+    assert(b.size(0) == size());
+
+    int n = size(), nrhs = k == 1 ? 1 : b.size(1), info;
+    lapack_getrs(transposed ? 'T' : 'N', n, nrhs, const_cast<T *>(lu_.data()), n,
+                 const_cast<int *>(ipiv_.data()), b.data(), n, &info);
+    assert(info == 0);
+  }
+
+  //! Solve the system A x = b, or A' x = b if transposed is true
+  template <int k, class S>
+  Array<k, T, S> solve(const Array<k, T, S> &b, bool transposed = false) const {
+    Array<k, T, S> x(b);
+    solve_in_place(x, transposed);
+    return x;
+  }
+
+  //! Determinant of the factored matrix
+  value_type determinant() const {
+    value_type d = 1;
+    for (size_t i = 0; i < size(); ++i)
+      d *= ipiv_[i] == static_cast<int>(i + 1) ? lu_(i, i) : -lu_(i, i);
+    return d;
+  }
+
+private:
+  //! Helper function used by the constructors
+  void factor() {
+
+    assert(lu_.rows() == lu_.columns());
+
+    int n = lu_.rows(), info;
+    ipiv_.resize(n);
+    lapack_getrf(n, n, lu_.data(), n, ipiv_.data(), &info);
+
+    if (info != 0)
+      throw SingularMatrixException(info);
+  }
+};
+
+//! LU factorization of a matrix, see LU
+template <typename T, class Alloc>
+LU<T, Alloc> lu(const Array<2, T, Alloc> &A) {
+  return LU<T, Alloc>(A);
+}
+
+//! Solution of the system A x = b for a vector or matrix right-hand side
+/*! The matrix is factored on every call, use LU to solve several systems
+ * with the same matrix.
+ */
+template <int k, typename T, class Alloc, class S>
+Array<k, T, S> solve(const Array<2, T, Alloc> &A, const Array<k, T, S> &b) {
+  return LU<T, Alloc>(A).solve(b);
+}
+
+//! Cholesky factorization of a symmetric positive definite matrix
+/*! Factors the matrix as A = L L' (LAPACK potrf), which takes half the work
+ * of an LU factorization and needs no pivoting. Only the lower triangle of
+ * the matrix is referenced. Systems with any number of right-hand sides are
+ * then solved with LAPACK potrs.
+ * \tparam T - Type of the matrix elements
+ * \tparam Alloc - Allocator of the stored factor
+ */
+template <typename T, class Alloc = aligned_allocator<T> > class Cholesky {
+
+public:
+  typedef T value_type;
+  typedef Array<2, T, Alloc> matrix_type;
+
+private:
+  matrix_type l_; //!< Factor L in the lower triangle, the upper triangle is
+                  // left as given
+
+public:
+  //! Constructor that factors a copy of the matrix
+  explicit Cholesky(const matrix_type &A) : l_(A) { factor(); }
+
+  //! Constructor that factors the matrix in place, without copying it
+  explicit Cholesky(matrix_type &&A) : l_(std::move(A)) { factor(); }
+
+  //! Number of equations
+  size_t size() const { return l_.rows(); }
+
+  //! Factor L as a triangular matrix, e.g., for solves with L or L' alone
+  Triangular<T, Alloc> lower() const {
+    return Triangular<T, Alloc>(l_, false, false);
+  }
+
+  //! Lower triangular factor L
+  matrix_type factor_l() const {
+    matrix_type L(l_);
+    for (size_t j = 1; j < size(); ++j)
+      std::fill_n(L.data() + j * size(), j, T());
+    return L;
+  }
+
+  //! Solve the system A x = b, overwriting b with the solution x. The
+  // right-hand side b is either a vector or a matrix, in which case every
+  // column is solved for.
+  template <int k, class S> void solve_in_place(Array<k, T, S> &b) const {
+
+    static_assert(k == 1 || k == 2,
+                  "Error: Right-hand side must be a vector or a matrix");
+    assert(b.size(0) == size());
+
+    int n = size(), nrhs = k == 1 ? 1 : b.size(1), info;
+    lapack_potrs('L', n, nrhs, const_cast<T *>(l_.data()), n, b.data(), n,
+                 &info);
+    assert(info == 0);
+  }
+
+  //! Solve the system A x = b
+  template <int k, class S>
+  Array<k, T, S> solve(const Array<k, T, S> &b) const {
+    Array<k, T, S> x(b);
+    solve_in_place(x);
+    return x;
+  }
+
+  //! Natural logarithm of the determinant of the factored matrix, which
+  // does not overflow for large matrices as the determinant itself would
+  value_type log_determinant() const {
+    value_type d = 0;
+    for (size_t i = 0; i < size(); ++i)
+      d += std::log(l_(i, i));
+    return 2 * d;
+  }
+
+  //! Inverse of the factored matrix (LAPACK potri)
+  matrix_type inverse() const {
+
+    matrix_type r(l_);
+    int n = size(), info;
+    lapack_potri('L', n, r.data(), n, &info);
+
+    if (info != 0)
+      throw SingularMatrixException(info);
+
+    // potri only computes the lower triangle
+    for (size_t j = 1; j < size(); ++j)
+      for (size_t i = 0; i < j; ++i)
+        r(i, j) = r(j, i);
+    return r;
+  }
+
+private:
+  //! Helper function used by the constructors
+  void factor() {
+
+    assert(l_.rows() == l_.columns());
+
+    int n = l_.rows(), info;
+    lapack_potrf('L', n, l_.data(), n, &info);
+
+    if (info != 0)
+      throw NotPositiveDefiniteException(info);
+  }
+};
+
+//! Cholesky factorization of a symmetric positive definite matrix, see
+// Cholesky
+template <typename T, class Alloc>
+Cholesky<T, Alloc> cholesky(const Array<2, T, Alloc> &A) {
+  return Cholesky<T, Alloc>(A);
+}
+
+//! Gives a vector the size m, keeping its memory if it already has that size.
+// The last parameter makes vectors and one-column matrices interchangeable.
+// Arrays cannot have a zero dimension, so m = 0 gives an empty vector.
+template <typename T, class S>
+void conform(Array<1, T, S> &a, size_t m, size_t = 1) {
+  if (a.size() != m)
+    a = m > 0 ? Array<1, T, S>(m, uninitialized) : Array<1, T, S>();
+}
+
+//! Gives a matrix the size m x n, keeping its memory if it already has that
+// size. Arrays cannot have a zero dimension, so a size with no elements gives
+// an empty matrix.
+template <typename T, class S>
+void conform(Array<2, T, S> &a, size_t m, size_t n) {
+  if (m == 0 || n == 0)
+    a = Array<2, T, S>();
+  else if (a.rows() != m || a.columns() != n)
+    a = Array<2, T, S>(m, n, uninitialized);
+}
+
+//! QR factorization of a general matrix
+/*! Factors an m x n matrix as A = Q R with Householder reflections (LAPACK
+ * geqrf). Q is kept implicitly as the reflectors below the diagonal and is
+ * applied to other arrays with LAPACK ormqr, so it is formed only if asked
+ * for.
+ * \tparam T - Type of the matrix elements
+ * \tparam Alloc - Allocator of the stored factors
+ */
+template <typename T, class Alloc = aligned_allocator<T> > class QR {
+
+public:
+  typedef T value_type;
+  typedef Array<2, T, Alloc> matrix_type;
+
+private:
+  matrix_type qr_;      //!< R in the upper triangle, reflectors below it
+  std::vector<T> tau_;  //!< Scalar factors of the reflectors
+
+public:
+  //! Constructor that factors a copy of the matrix
+  explicit QR(const matrix_type &A) : qr_(A) { factor(); }
+
+  //! Constructor that factors the matrix in place, without copying it
+  explicit QR(matrix_type &&A) : qr_(std::move(A)) { factor(); }
+
+  //! Rows of the factored matrix
+  size_t rows() const { return qr_.rows(); }
+
+  //! Columns of the factored matrix
+  size_t columns() const { return qr_.columns(); }
+
+  //! Upper triangular factor R, of size min(m,n) x n
+  matrix_type R() const {
+    const size_t p = tau_.size();
+    matrix_type r(p, columns());
+    for (size_t j = 0; j < columns(); ++j)
+      for (size_t i = 0; i <= std::min(j, p - 1); ++i)
+        r(i, j) = qr_(i, j);
+    return r;
+  }
+
+  //! Orthogonal factor Q with orthonormal columns, of size m x min(m,n)
+  matrix_type Q() const {
+    matrix_type q(rows(), tau_.size());
+    for (size_t i = 0; i < tau_.size(); ++i)
+      q(i, i) = T(1);
+    apply_q(q);
+    return q;
+  }
+
+  //! Replace c by Q c, or by Q' c if transposed is true, where c is a vector
+  // or a matrix with m rows
+  template <int k, class S>
+  void apply_q(Array<k, T, S> &c, bool transposed = false) const {
+
+    static_assert(k == 1 || k == 2,
+                  "Error: Q can only be applied to vectors and matrices");
+    assert(c.size(0) == rows());
+
+    int m = rows(), n = k == 1 ? 1 : c.size(1), p = tau_.size(), info;
+    T *a = const_cast<T *>(qr_.data()), *tau = const_cast<T *>(tau_.data());
+    const char trans = transposed ? 'T' : 'N';
+
+    T query;
+    lapack_ormqr('L', trans, m, n, p, a, m, tau, c.data(), m, &query, -1, &info);
+    int lwork = lapack_lwork(query, info, std::max(n, 1));
+    lapack_ormqr('L', trans, m, n, p, a, m, tau, c.data(), m,
+                 workspace<T>(lwork), lwork, &info);
+    assert(info == 0);
+  }
+
+  //! Least squares solution of A x = b for a matrix with at least as many
+  // rows as columns and full column rank, for a vector or matrix b
+  template <int k, class S> Array<k, T, S> solve(const Array<k, T, S> &b) const {
+
+    assert(rows() >= columns());
+
+    Array<k, T, S> y(b);
+    apply_q(y, true);
+
+    // back substitution with R, column by column of the right-hand side
+    const size_t n = columns(), m = rows(), nrhs = k == 1 ? 1 : b.size(1);
+    for (size_t j = 0; j < nrhs; ++j) {
+      T *yj = y.data() + j * m;
+      for (size_t i = n; i-- > 0;) {
+        if (qr_(i, i) == T())
+          throw SingularMatrixException(i + 1);
+        T t = yj[i];
+        for (size_t l = i + 1; l < n; ++l)
+          t -= qr_(i, l) * yj[l];
+        yj[i] = t / qr_(i, i);
+      }
+    }
+    return head(y, n);
+  }
+
+private:
+  //! Helper function used by the constructors
+  void factor() {
+
+    int m = rows(), n = columns(), info;
+    tau_.resize(std::min(m, n));
+
+    T query;
+    lapack_geqrf(m, n, qr_.data(), m, tau_.data(), &query, -1, &info);
+    int lwork = lapack_lwork(query, info, std::max(n, 1));
+    lapack_geqrf(m, n, qr_.data(), m, tau_.data(), workspace<T>(lwork), lwork,
+                 &info);
+    assert(info == 0);
+  }
+
+  //! First n elements of a vector
+  template <class S> static Array<1, T, S> head(const Array<1, T, S> &y, size_t n) {
+    Array<1, T, S> x(n, uninitialized);
+    std::copy_n(y.data(), n, x.data());
+    return x;
+  }
+
+  //! First n rows of a matrix
+  template <class S> static Array<2, T, S> head(const Array<2, T, S> &y, size_t n) {
+    Array<2, T, S> x(n, y.columns(), uninitialized);
+    for (size_t j = 0; j < y.columns(); ++j)
+      std::copy_n(y.data() + j * y.rows(), n, x.data() + j * n);
+    return x;
+  }
+};
+
+//! QR factorization of a general matrix, see QR
+template <typename T, class Alloc> QR<T, Alloc> qr(const Array<2, T, Alloc> &A) {
+  return QR<T, Alloc>(A);
+}
+
+//! Least squares solution written into x
+/*! Solves min |b - A x| for a matrix with at least as many rows as columns,
+ * or the minimum norm solution of A x = b for a matrix with fewer rows than
+ * columns, through LAPACK gels. A must have full rank. x is given its size if
+ * it does not have it already, so repeated solves of the same size do not
+ * allocate.
+ */
+template <int k, typename T, class Alloc, class S, class R>
+void least_squares(const Array<2, T, Alloc> &A, const Array<k, T, S> &b,
+                   Array<k, T, R> &x) {
+
+  static_assert(k == 1 || k == 2,
+                "Error: Right-hand side must be a vector or a matrix");
+  assert(b.size(0) == A.rows());
+
+  int m = A.rows(), n = A.columns(), ld = std::max(m, n),
+      nrhs = k == 1 ? 1 : b.size(1), info;
+
+  // gels overwrites its arguments, so both are copied. The copies are
+  // released on return rather than kept in the thread's workspace because
+  // they are as large as the arguments
+  Array<2, T> a(m, n, uninitialized), c(ld, nrhs, uninitialized);
+  std::copy_n(A.data(), A.size(), a.data());
+  for (int j = 0; j < nrhs; ++j)
+    std::copy_n(b.data() + j * m, m, c.data() + j * ld);
+
+  T query;
+  lapack_gels('N', m, n, nrhs, a.data(), m, c.data(), ld, &query, -1, &info);
+  int lwork = lapack_lwork(query, info, std::max(1, std::min(m, n) + std::max(ld, nrhs)));
+  lapack_gels('N', m, n, nrhs, a.data(), m, c.data(), ld, workspace<T>(lwork),
+              lwork, &info);
+
+  if (info > 0)
+    throw SingularMatrixException(info);
+
+  conform(x, n, nrhs);
+  for (int j = 0; j < nrhs; ++j)
+    std::copy_n(c.data() + j * ld, n, x.data() + j * n);
+}
+
+//! Least squares solution of A x = b, see least_squares(A, b, x)
+template <int k, typename T, class Alloc, class S>
+Array<k, T, S> least_squares(const Array<2, T, Alloc> &A, const Array<k, T, S> &b) {
+  Array<k, T, S> x;
+  least_squares(A, b, x);
+  return x;
+}
+
+//! Parts of the singular value decomposition that are computed
+enum SVD_type {
+  SVD_values, //!< Singular values only
+  SVD_thin,   //!< Singular values and the first min(m,n) singular vectors
+  SVD_full    //!< Singular values and all singular vectors
+};
+
+//! Singular value decomposition A = U diag(s) Vt written into s, U and Vt
+/*! Computed with the divide and conquer algorithm of LAPACK gesdd. For an m x
+ * n matrix with p = min(m,n), s holds the p singular values in decreasing
+ * order. The thin decomposition gives U as m x p and Vt as p x n, the full
+ * one m x m and n x n, and U and Vt are not referenced if only the values are
+ * computed. The outputs are given their sizes if they do not have them
+ * already, so repeated decompositions of the same size do not allocate.
+ */
+template <typename T, class Alloc, class S1, class S2, class S3>
+void svd(const Array<2, T, Alloc> &A, Array<1, T, S1> &s, Array<2, T, S2> &U,
+         Array<2, T, S3> &Vt, SVD_type t = SVD_thin) {
+
+  int m = A.rows(), n = A.columns(), p = std::min(m, n), info;
+  const char jobz = t == SVD_values ? 'N' : t == SVD_thin ? 'S' : 'A';
+
+  conform(s, p);
+  T *u = workspace<T, 2>(1), *vt = u;
+  int ldu = 1, ldvt = 1;
+  if (t != SVD_values) {
+    conform(U, m, t == SVD_thin ? p : m);
+    conform(Vt, t == SVD_thin ? p : n, n);
+    u = U.data(), vt = Vt.data(), ldu = m, ldvt = Vt.rows();
+  }
+
+  // gesdd destroys the matrix, so it is copied. The copy is released on
+  // return rather than kept in the thread's workspace because it is as large
+  // as the matrix
+  Array<2, T> a(m, n, uninitialized);
+  std::copy_n(A.data(), A.size(), a.data());
+  int *iwork = workspace<int>(8 * p);
+
+  T query;
+  lapack_gesdd(jobz, m, n, a.data(), m, s.data(), u, ldu, vt, ldvt, &query, -1,
+               iwork, &info);
+  int lwork = lapack_lwork(query, info, 1);
+  lapack_gesdd(jobz, m, n, a.data(), m, s.data(), u, ldu, vt, ldvt,
+               workspace<T>(lwork), lwork, iwork, &info);
+
+  if (info > 0)
+    throw std::runtime_error("Singular value decomposition did not converge.");
+}
+
+//! Singular values of a matrix in decreasing order
+template <typename T, class Alloc>
+Array<1, T, Alloc> singular_values(const Array<2, T, Alloc> &A) {
+  Array<1, T, Alloc> s;
+  Array<2, T, Alloc> U, Vt;
+  svd(A, s, U, Vt, SVD_values);
+  return s;
+}
+
+//! Singular value decomposition of a general matrix, see svd
+template <typename T, class Alloc = aligned_allocator<T> > class SVD {
+
+public:
+  typedef T value_type;
+  typedef Array<1, T, Alloc> vector_type;
+  typedef Array<2, T, Alloc> matrix_type;
+
+private:
+  vector_type s_;  //!< Singular values in decreasing order
+  matrix_type u_;  //!< Left singular vectors
+  matrix_type vt_; //!< Transposed right singular vectors
+
+public:
+  //! Constructor, computes the thin decomposition by default
+  explicit SVD(const matrix_type &A, SVD_type t = SVD_thin) {
+    svd(A, s_, u_, vt_, t);
+  }
+
+  //! Singular values in decreasing order
+  const vector_type &singular_values() const { return s_; }
+
+  //! Left singular vectors as columns
+  const matrix_type &U() const { return u_; }
+
+  //! Right singular vectors as rows
+  const matrix_type &Vt() const { return vt_; }
+
+  //! Number of singular values larger than tol times the largest one
+  size_t rank(value_type tol = 1e3 * std::numeric_limits<T>::epsilon()) const {
+    size_t r = 0;
+    while (r < s_.size() && s_[r] > tol * s_[0])
+      ++r;
+    return r;
+  }
+};
+
+//! Parts of the symmetric eigendecomposition that are computed
+enum Eigen_type {
+  Eigen_values, //!< Eigenvalues only
+  Eigen_vectors //!< Eigenvalues and eigenvectors
+};
+
+//! Eigenvalues w and eigenvectors Z of a symmetric matrix
+/*! Computes all eigenvalues in ascending order with the divide and conquer
+ * algorithm of LAPACK syevd, and the corresponding orthonormal eigenvectors
+ * as the columns of Z unless only the values are asked for, in which case Z
+ * is not referenced. Only the lower triangle of A is referenced. The outputs
+ * are given their sizes if they do not have them already.
+ */
+template <typename T, class Alloc, class S1, class S2>
+void eigen(const Array<2, T, Alloc> &A, Array<1, T, S1> &w, Array<2, T, S2> &Z,
+           Eigen_type t = Eigen_vectors) {
+
+  assert(A.rows() == A.columns());
+
+  int n = A.rows(), info;
+  const char jobz = t == Eigen_vectors ? 'V' : 'N';
+
+  // syevd overwrites the matrix with the eigenvectors, so if only the values
+  // are asked for it works on a copy, which is released on return rather than
+  // kept in the thread's workspace because it is as large as the matrix
+  conform(w, n);
+  Array<2, T> c;
+  if (t == Eigen_vectors)
+    conform(Z, n, n);
+  else
+    c = Array<2, T>(n, n, uninitialized);
+  T *a = t == Eigen_vectors ? Z.data() : c.data();
+  std::copy_n(A.data(), A.size(), a);
+
+  T query;
+  int iquery;
+  lapack_syevd(jobz, 'L', n, a, n, w.data(), &query, -1, &iquery, -1, &info);
+  int lwork = lapack_lwork(query, info, 1), liwork = lapack_lwork(iquery, info, 1);
+  lapack_syevd(jobz, 'L', n, a, n, w.data(), workspace<T>(lwork), lwork,
+               workspace<int>(liwork), liwork, &info);
+
+  if (info > 0)
+    throw std::runtime_error("Eigenvalue decomposition did not converge.");
+}
+
+//! Helper function used to compute selected eigenpairs of a symmetric matrix
+// with LAPACK syevr, for a range of indices (range = 'I') or of values
+// (range = 'V')
+template <typename T, class Alloc, class S1, class S2>
+void selected_eigen(const Array<2, T, Alloc> &A, char range, T vl, T vu, int il,
+                    int iu, Array<1, T, S1> &w, Array<2, T, S2> &Z,
+                    Eigen_type t) {
+
+  assert(A.rows() == A.columns());
+
+  int n = A.rows(), m = 0, info;
+
+  // syevr destroys its copy of the matrix, which is released on return rather
+  // than kept in the thread's workspace because it is as large as the matrix
+  Array<2, T> a(n, n, uninitialized);
+  T *v = workspace<T, 2>(n), none;
+  int *isuppz =
+      workspace<int, 1>(2 * std::max(range == 'I' ? iu - il + 1 : n, 1));
+
+  auto syevr = [&](char jobz, T *z, int ldz) {
+    std::copy_n(A.data(), A.size(), a.data());
+    T query;
+    int iquery;
+    lapack_syevr(jobz, range, 'L', n, a.data(), n, vl, vu, il, iu, T(), &m, v,
+                 z, ldz, isuppz, &query, -1, &iquery, -1, &info);
+    int lwork = lapack_lwork(query, info, 1), liwork = lapack_lwork(iquery, info, 1);
+    lapack_syevr(jobz, range, 'L', n, a.data(), n, vl, vu, il, iu, T(), &m, v,
+                 z, ldz, isuppz, workspace<T>(lwork), lwork,
+                 workspace<int>(liwork), liwork, &info);
+
+    if (info > 0)
+      throw std::runtime_error("Eigenvalue decomposition did not converge.");
+  };
+
+  if (t == Eigen_values)
+    syevr('N', &none, 1);
+  else {
+    // the number of eigenpairs is only known beforehand for a range of
+    // indices. For a range of values it is found by a first pass without
+    // eigenvectors, which counts the eigenvalues of the same tridiagonal
+    // matrix by bisection and thus finds as many as the second pass, so the
+    // eigenvectors go straight into Z and need no scratch memory
+    if (range == 'V')
+      syevr('N', &none, 1);
+    else
+      m = iu - il + 1;
+    const int columns = m;
+    conform(Z, n, columns);
+    syevr('V', columns > 0 ? Z.data() : &none, std::max(n, 1));
+    assert(m == columns);
+  }
+
+  conform(w, m);
+  std::copy_n(v, m, w.data());
+}
+
+//! Eigenpairs first, ..., first + count - 1 of a symmetric matrix
+/*! The eigenpairs are numbered from zero in ascending order of the
+ * eigenvalues, so first = 0 selects the count smallest ones. Computed with
+ * LAPACK syevr, which only computes the selected eigenvectors, otherwise as
+ * eigen(A, w, Z, t).
+ */
+template <typename T, class Alloc, class S1, class S2>
+void eigen(const Array<2, T, Alloc> &A, Array<1, T, S1> &w, Array<2, T, S2> &Z,
+           size_t first, size_t count, Eigen_type t = Eigen_vectors) {
+
+  assert(first + count <= A.rows());
+
+  if (count == 0) {
+    conform(w, 0);
+    if (t == Eigen_vectors)
+      conform(Z, A.rows(), 0);
+    return;
+  }
+  selected_eigen(A, 'I', T(), T(), first + 1, first + count, w, Z, t);
+}
+
+//! Eigenpairs of a symmetric matrix with eigenvalues in (lower, upper]
+/*! Computed with LAPACK syevr, otherwise as eigen(A, w, Z, t).
+ */
+template <typename T, class Alloc, class S1, class S2>
+void eigen_interval(const Array<2, T, Alloc> &A, Array<1, T, S1> &w,
+                    Array<2, T, S2> &Z,
+                    typename Array<2, T, Alloc>::value_type lower,
+                    typename Array<2, T, Alloc>::value_type upper,
+                    Eigen_type t = Eigen_vectors) {
+
+  assert(lower < upper);
+  selected_eigen(A, 'V', lower, upper, 0, 0, w, Z, t);
+}
+
+//! Eigenvalues of a symmetric matrix in ascending order
+template <typename T, class Alloc>
+Array<1, T, Alloc> eigenvalues(const Array<2, T, Alloc> &A) {
+  Array<1, T, Alloc> w;
+  Array<2, T, Alloc> Z;
+  eigen(A, w, Z, Eigen_values);
+  return w;
+}
+
 #endif /* HAVE_LAPACK */
 
 __END_ARRAY_NAMESPACE__
@@ -28,6 +28,8 @@
 #ifndef LAPACK_IMPL_HPP
 #define LAPACK_IMPL_HPP
 
+#include <algorithm>
+
 #ifdef HAVE_LAPACK
 #define CPPARRAY_CLAPACK(name, NAME) CPPARRAY_FC_GLOBAL(name, NAME)
 #include "fortran_mangling.hh"
@@ -48,12 +50,120 @@ void CPPARRAY_CLAPACK(sgetrf, SGETRF)(int *M, int *N, float *A, int *lda,
                                       int *IPIV, int *INFO);
 void CPPARRAY_CLAPACK(dgetrf, DGETRF)(int *M, int *N, double *A, int *lda,
                                       int *IPIV, int *INFO);
+void CPPARRAY_CLAPACK(cgetrf, CGETRF)(int *M, int *N, std::complex<float> *A,
+                                      int *lda, int *IPIV, int *INFO);
+void CPPARRAY_CLAPACK(zgetrf, ZGETRF)(int *M, int *N, std::complex<double> *A,
+                                      int *lda, int *IPIV, int *INFO);
 
 // generate inverse of a matrix given its LU decomposition
 void CPPARRAY_CLAPACK(sgetri, SGETRI)(int *N, float *A, int *lda, int *IPIV,
                                       float *WORK, int *lwork, int *INFO);
 void CPPARRAY_CLAPACK(dgetri, DGETRI)(int *N, double *A, int *lda, int *IPIV,
                                       double *WORK, int *lwork, int *INFO);
+void CPPARRAY_CLAPACK(cgetri, CGETRI)(int *N, std::complex<float> *A, int *lda,
+                                      int *IPIV, std::complex<float> *WORK,
+                                      int *lwork, int *INFO);
+void CPPARRAY_CLAPACK(zgetri, ZGETRI)(int *N, std::complex<double> *A, int *lda,
+                                      int *IPIV, std::complex<double> *WORK,
+                                      int *lwork, int *INFO);
+
+// solve a system of linear equations given the LU decomposition of its matrix
+void CPPARRAY_CLAPACK(sgetrs, SGETRS)(char *TRANS, int *N, int *NRHS, float *A,
+                                      int *lda, int *IPIV, float *B, int *ldb,
+                                      int *INFO);
+void CPPARRAY_CLAPACK(dgetrs, DGETRS)(char *TRANS, int *N, int *NRHS, double *A,
+                                      int *lda, int *IPIV, double *B, int *ldb,
+                                      int *INFO);
+void CPPARRAY_CLAPACK(cgetrs, CGETRS)(char *TRANS, int *N, int *NRHS,
+                                      std::complex<float> *A, int *lda,
+                                      int *IPIV, std::complex<float> *B,
+                                      int *ldb, int *INFO);
+void CPPARRAY_CLAPACK(zgetrs, ZGETRS)(char *TRANS, int *N, int *NRHS,
+                                      std::complex<double> *A, int *lda,
+                                      int *IPIV, std::complex<double> *B,
+                                      int *ldb, int *INFO);
+
+// Cholesky decomposition of a symmetric positive definite matrix
+void CPPARRAY_CLAPACK(spotrf, SPOTRF)(char *UPLO, int *N, float *A, int *lda,
+                                      int *INFO);
+void CPPARRAY_CLAPACK(dpotrf, DPOTRF)(char *UPLO, int *N, double *A, int *lda,
+                                      int *INFO);
+
+// solve a symmetric positive definite system given its Cholesky decomposition
+void CPPARRAY_CLAPACK(spotrs, SPOTRS)(char *UPLO, int *N, int *NRHS, float *A,
+                                      int *lda, float *B, int *ldb, int *INFO);
+void CPPARRAY_CLAPACK(dpotrs, DPOTRS)(char *UPLO, int *N, int *NRHS, double *A,
+                                      int *lda, double *B, int *ldb, int *INFO);
+
+// generate inverse of a symmetric positive definite matrix given its Cholesky
+// decomposition
+void CPPARRAY_CLAPACK(spotri, SPOTRI)(char *UPLO, int *N, float *A, int *lda,
+                                      int *INFO);
+void CPPARRAY_CLAPACK(dpotri, DPOTRI)(char *UPLO, int *N, double *A, int *lda,
+                                      int *INFO);
+
+// QR decomposition of a general matrix
+void CPPARRAY_CLAPACK(sgeqrf, SGEQRF)(int *M, int *N, float *A, int *lda,
+                                      float *TAU, float *WORK, int *lwork,
+                                      int *INFO);
+void CPPARRAY_CLAPACK(dgeqrf, DGEQRF)(int *M, int *N, double *A, int *lda,
+                                      double *TAU, double *WORK, int *lwork,
+                                      int *INFO);
+
+// multiply a matrix by the orthogonal matrix of a QR decomposition
+void CPPARRAY_CLAPACK(sormqr, SORMQR)(char *SIDE, char *TRANS, int *M, int *N,
+                                      int *K, float *A, int *lda, float *TAU,
+                                      float *C, int *ldc, float *WORK,
+                                      int *lwork, int *INFO);
+void CPPARRAY_CLAPACK(dormqr, DORMQR)(char *SIDE, char *TRANS, int *M, int *N,
+                                      int *K, double *A, int *lda, double *TAU,
+                                      double *C, int *ldc, double *WORK,
+                                      int *lwork, int *INFO);
+
+// least squares solution of an overdetermined or underdetermined system
+void CPPARRAY_CLAPACK(sgels, SGELS)(char *TRANS, int *M, int *N, int *NRHS,
+                                    float *A, int *lda, float *B, int *ldb,
+                                    float *WORK, int *lwork, int *INFO);
+void CPPARRAY_CLAPACK(dgels, DGELS)(char *TRANS, int *M, int *N, int *NRHS,
+                                    double *A, int *lda, double *B, int *ldb,
+                                    double *WORK, int *lwork, int *INFO);
+
+// singular value decomposition of a general matrix, divide and conquer
+void CPPARRAY_CLAPACK(sgesdd, SGESDD)(char *JOBZ, int *M, int *N, float *A,
+                                      int *lda, float *S, float *U, int *ldu,
+                                      float *VT, int *ldvt, float *WORK,
+                                      int *lwork, int *IWORK, int *INFO);
+void CPPARRAY_CLAPACK(dgesdd, DGESDD)(char *JOBZ, int *M, int *N, double *A,
+                                      int *lda, double *S, double *U, int *ldu,
+                                      double *VT, int *ldvt, double *WORK,
+                                      int *lwork, int *IWORK, int *INFO);
+
+// eigenvalues and eigenvectors of a symmetric matrix, divide and conquer
+void CPPARRAY_CLAPACK(ssyevd, SSYEVD)(char *JOBZ, char *UPLO, int *N, float *A,
+                                      int *lda, float *W, float *WORK,
+                                      int *lwork, int *IWORK, int *liwork,
+                                      int *INFO);
+void CPPARRAY_CLAPACK(dsyevd, DSYEVD)(char *JOBZ, char *UPLO, int *N, double *A,
+                                      int *lda, double *W, double *WORK,
+                                      int *lwork, int *IWORK, int *liwork,
+                                      int *INFO);
+
+// selected eigenvalues and eigenvectors of a symmetric matrix, relatively
+// robust representations
+void CPPARRAY_CLAPACK(ssyevr, SSYEVR)(char *JOBZ, char *RANGE, char *UPLO,
+                                      int *N, float *A, int *lda, float *VL,
+                                      float *VU, int *IL, int *IU,
+                                      float *ABSTOL, int *M, float *W, float *Z,
+                                      int *ldz, int *ISUPPZ, float *WORK,
+                                      int *lwork, int *IWORK, int *liwork,
+                                      int *INFO);
+void CPPARRAY_CLAPACK(dsyevr, DSYEVR)(char *JOBZ, char *RANGE, char *UPLO,
+                                      int *N, double *A, int *lda, double *VL,
+                                      double *VU, int *IL, int *IU,
+                                      double *ABSTOL, int *M, double *W,
+                                      double *Z, int *ldz, int *ISUPPZ,
+                                      double *WORK, int *lwork, int *IWORK,
+                                      int *liwork, int *INFO);
 }
 
 // LU decomoposition of a general matrix
@@ -67,6 +177,18 @@ lapack_Xgetrf(int *M, int *N, double *A, int *lda, int *IPIV, int *INFO) {
   CPPARRAY_CLAPACK(dgetrf, DGETRF)(M, N, A, lda, IPIV, INFO);
 }
 
+static void MAY_NOT_BE_USED lapack_Xgetrf(int *M, int *N,
+                                          std::complex<float> *A, int *lda,
+                                          int *IPIV, int *INFO) {
+  CPPARRAY_CLAPACK(cgetrf, CGETRF)(M, N, A, lda, IPIV, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgetrf(int *M, int *N,
+                                          std::complex<double> *A, int *lda,
+                                          int *IPIV, int *INFO) {
+  CPPARRAY_CLAPACK(zgetrf, ZGETRF)(M, N, A, lda, IPIV, INFO);
+}
+
 template <typename T>
 static void lapack_getrf(int M, int N, T *A, int lda, int *IPIV, int *INFO) {
   lapack_Xgetrf(&M, &N, A, &lda, IPIV, INFO);
@@ -84,12 +206,276 @@ static void MAY_NOT_BE_USED lapack_Xgetri(int *N, double *A, int *lda,
   CPPARRAY_CLAPACK(dgetri, DGETRI)(N, A, lda, IPIV, WORK, lwork, INFO);
 }
 
+static void MAY_NOT_BE_USED lapack_Xgetri(int *N, std::complex<float> *A,
+                                          int *lda, int *IPIV,
+                                          std::complex<float> *WORK, int *lwork,
+                                          int *INFO) {
+  CPPARRAY_CLAPACK(cgetri, CGETRI)(N, A, lda, IPIV, WORK, lwork, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgetri(int *N, std::complex<double> *A,
+                                          int *lda, int *IPIV,
+                                          std::complex<double> *WORK,
+                                          int *lwork, int *INFO) {
+  CPPARRAY_CLAPACK(zgetri, ZGETRI)(N, A, lda, IPIV, WORK, lwork, INFO);
+}
+
 template <typename T>
 static void lapack_getri(int N, T *A, int lda, int *IPIV, T *WORK, int lwork,
                          int *INFO) {
   lapack_Xgetri(&N, A, &lda, IPIV, WORK, &lwork, INFO);
 }
 
+// size of a workspace returned by a workspace query in its first element, which
+// is stored in the real part for complex routines
+template <typename T> static int lapack_lwork(T WORK, int INFO, int minimum) {
+  return INFO == 0 ? std::max(static_cast<int>(std::real(WORK)), minimum)
+                   : minimum;
+}
+
+// optimal workspace size of getri, obtained through a workspace query whose
+// INFO is returned to the caller
+template <typename T>
+static int lapack_getri_lwork(int N, T *A, int lda, int *IPIV, int *INFO) {
+  T WORK;
+  lapack_getri(N, A, lda, IPIV, &WORK, -1, INFO);
+  return lapack_lwork(WORK, *INFO, std::max(N, 1));
+}
+
+// solve a system of linear equations given the LU decomposition of its matrix
+static void MAY_NOT_BE_USED lapack_Xgetrs(char *TRANS, int *N, int *NRHS,
+                                          float *A, int *lda, int *IPIV,
+                                          float *B, int *ldb, int *INFO) {
+  CPPARRAY_CLAPACK(sgetrs, SGETRS)(TRANS, N, NRHS, A, lda, IPIV, B, ldb, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgetrs(char *TRANS, int *N, int *NRHS,
+                                          double *A, int *lda, int *IPIV,
+                                          double *B, int *ldb, int *INFO) {
+  CPPARRAY_CLAPACK(dgetrs, DGETRS)(TRANS, N, NRHS, A, lda, IPIV, B, ldb, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgetrs(char *TRANS, int *N, int *NRHS,
+                                          std::complex<float> *A, int *lda,
+                                          int *IPIV, std::complex<float> *B,
+                                          int *ldb, int *INFO) {
+  CPPARRAY_CLAPACK(cgetrs, CGETRS)(TRANS, N, NRHS, A, lda, IPIV, B, ldb, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgetrs(char *TRANS, int *N, int *NRHS,
+                                          std::complex<double> *A, int *lda,
+                                          int *IPIV, std::complex<double> *B,
+                                          int *ldb, int *INFO) {
+  CPPARRAY_CLAPACK(zgetrs, ZGETRS)(TRANS, N, NRHS, A, lda, IPIV, B, ldb, INFO);
+}
+
+template <typename T>
+static void lapack_getrs(char TRANS, int N, int NRHS, T *A, int lda, int *IPIV,
+                         T *B, int ldb, int *INFO) {
+  lapack_Xgetrs(&TRANS, &N, &NRHS, A, &lda, IPIV, B, &ldb, INFO);
+}
+
+// Cholesky decomposition of a symmetric positive definite matrix
+static void MAY_NOT_BE_USED lapack_Xpotrf(char *UPLO, int *N, float *A,
+                                          int *lda, int *INFO) {
+  CPPARRAY_CLAPACK(spotrf, SPOTRF)(UPLO, N, A, lda, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xpotrf(char *UPLO, int *N, double *A,
+                                          int *lda, int *INFO) {
+  CPPARRAY_CLAPACK(dpotrf, DPOTRF)(UPLO, N, A, lda, INFO);
+}
+
+template <typename T>
+static void lapack_potrf(char UPLO, int N, T *A, int lda, int *INFO) {
+  lapack_Xpotrf(&UPLO, &N, A, &lda, INFO);
+}
+
+// solve a symmetric positive definite system given its Cholesky decomposition
+static void MAY_NOT_BE_USED lapack_Xpotrs(char *UPLO, int *N, int *NRHS,
+                                          float *A, int *lda, float *B,
+                                          int *ldb, int *INFO) {
+  CPPARRAY_CLAPACK(spotrs, SPOTRS)(UPLO, N, NRHS, A, lda, B, ldb, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xpotrs(char *UPLO, int *N, int *NRHS,
+                                          double *A, int *lda, double *B,
+                                          int *ldb, int *INFO) {
+  CPPARRAY_CLAPACK(dpotrs, DPOTRS)(UPLO, N, NRHS, A, lda, B, ldb, INFO);
+}
+
+template <typename T>
+static void lapack_potrs(char UPLO, int N, int NRHS, T *A, int lda, T *B,
+                         int ldb, int *INFO) {
+  lapack_Xpotrs(&UPLO, &N, &NRHS, A, &lda, B, &ldb, INFO);
+}
+
+// generate inverse of a symmetric positive definite matrix given its Cholesky
+// decomposition
+static void MAY_NOT_BE_USED lapack_Xpotri(char *UPLO, int *N, float *A,
+                                          int *lda, int *INFO) {
+  CPPARRAY_CLAPACK(spotri, SPOTRI)(UPLO, N, A, lda, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xpotri(char *UPLO, int *N, double *A,
+                                          int *lda, int *INFO) {
+  CPPARRAY_CLAPACK(dpotri, DPOTRI)(UPLO, N, A, lda, INFO);
+}
+
+template <typename T>
+static void lapack_potri(char UPLO, int N, T *A, int lda, int *INFO) {
+  lapack_Xpotri(&UPLO, &N, A, &lda, INFO);
+}
+
+// QR decomposition of a general matrix
+static void MAY_NOT_BE_USED lapack_Xgeqrf(int *M, int *N, float *A, int *lda,
+                                          float *TAU, float *WORK, int *lwork,
+                                          int *INFO) {
+  CPPARRAY_CLAPACK(sgeqrf, SGEQRF)(M, N, A, lda, TAU, WORK, lwork, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgeqrf(int *M, int *N, double *A, int *lda,
+                                          double *TAU, double *WORK, int *lwork,
+                                          int *INFO) {
+  CPPARRAY_CLAPACK(dgeqrf, DGEQRF)(M, N, A, lda, TAU, WORK, lwork, INFO);
+}
+
+template <typename T>
+static void lapack_geqrf(int M, int N, T *A, int lda, T *TAU, T *WORK,
+                         int lwork, int *INFO) {
+  lapack_Xgeqrf(&M, &N, A, &lda, TAU, WORK, &lwork, INFO);
+}
+
+// multiply a matrix by the orthogonal matrix of a QR decomposition
+static void MAY_NOT_BE_USED lapack_Xormqr(char *SIDE, char *TRANS, int *M,
+                                          int *N, int *K, float *A, int *lda,
+                                          float *TAU, float *C, int *ldc,
+                                          float *WORK, int *lwork, int *INFO) {
+  CPPARRAY_CLAPACK(sormqr, SORMQR)(SIDE, TRANS, M, N, K, A, lda, TAU, C, ldc,
+                                   WORK, lwork, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xormqr(char *SIDE, char *TRANS, int *M,
+                                          int *N, int *K, double *A, int *lda,
+                                          double *TAU, double *C, int *ldc,
+                                          double *WORK, int *lwork, int *INFO) {
+  CPPARRAY_CLAPACK(dormqr, DORMQR)(SIDE, TRANS, M, N, K, A, lda, TAU, C, ldc,
+                                   WORK, lwork, INFO);
+}
+
+template <typename T>
+static void lapack_ormqr(char SIDE, char TRANS, int M, int N, int K, T *A,
+                         int lda, T *TAU, T *C, int ldc, T *WORK, int lwork,
+                         int *INFO) {
+  lapack_Xormqr(&SIDE, &TRANS, &M, &N, &K, A, &lda, TAU, C, &ldc, WORK, &lwork,
+                INFO);
+}
+
+// least squares solution of an overdetermined or underdetermined system
+static void MAY_NOT_BE_USED lapack_Xgels(char *TRANS, int *M, int *N, int *NRHS,
+                                         float *A, int *lda, float *B, int *ldb,
+                                         float *WORK, int *lwork, int *INFO) {
+  CPPARRAY_CLAPACK(sgels, SGELS)(TRANS, M, N, NRHS, A, lda, B, ldb, WORK, lwork,
+                                 INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgels(char *TRANS, int *M, int *N, int *NRHS,
+                                         double *A, int *lda, double *B,
+                                         int *ldb, double *WORK, int *lwork,
+                                         int *INFO) {
+  CPPARRAY_CLAPACK(dgels, DGELS)(TRANS, M, N, NRHS, A, lda, B, ldb, WORK, lwork,
+                                 INFO);
+}
+
+template <typename T>
+static void lapack_gels(char TRANS, int M, int N, int NRHS, T *A, int lda, T *B,
+                        int ldb, T *WORK, int lwork, int *INFO) {
+  lapack_Xgels(&TRANS, &M, &N, &NRHS, A, &lda, B, &ldb, WORK, &lwork, INFO);
+}
+
+// singular value decomposition of a general matrix, divide and conquer
+static void MAY_NOT_BE_USED lapack_Xgesdd(char *JOBZ, int *M, int *N, float *A,
+                                          int *lda, float *S, float *U,
+                                          int *ldu, float *VT, int *ldvt,
+                                          float *WORK, int *lwork, int *IWORK,
+                                          int *INFO) {
+  CPPARRAY_CLAPACK(sgesdd, SGESDD)(JOBZ, M, N, A, lda, S, U, ldu, VT, ldvt,
+                                   WORK, lwork, IWORK, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xgesdd(char *JOBZ, int *M, int *N, double *A,
+                                          int *lda, double *S, double *U,
+                                          int *ldu, double *VT, int *ldvt,
+                                          double *WORK, int *lwork, int *IWORK,
+                                          int *INFO) {
+  CPPARRAY_CLAPACK(dgesdd, DGESDD)(JOBZ, M, N, A, lda, S, U, ldu, VT, ldvt,
+                                   WORK, lwork, IWORK, INFO);
+}
+
+template <typename T>
+static void lapack_gesdd(char JOBZ, int M, int N, T *A, int lda, T *S, T *U,
+                         int ldu, T *VT, int ldvt, T *WORK, int lwork,
+                         int *IWORK, int *INFO) {
+  lapack_Xgesdd(&JOBZ, &M, &N, A, &lda, S, U, &ldu, VT, &ldvt, WORK, &lwork,
+                IWORK, INFO);
+}
+
+// eigenvalues and eigenvectors of a symmetric matrix, divide and conquer
+static void MAY_NOT_BE_USED lapack_Xsyevd(char *JOBZ, char *UPLO, int *N,
+                                          float *A, int *lda, float *W,
+                                          float *WORK, int *lwork, int *IWORK,
+                                          int *liwork, int *INFO) {
+  CPPARRAY_CLAPACK(ssyevd, SSYEVD)(JOBZ, UPLO, N, A, lda, W, WORK, lwork, IWORK,
+                                   liwork, INFO);
+}
+
+static void MAY_NOT_BE_USED lapack_Xsyevd(char *JOBZ, char *UPLO, int *N,
+                                          double *A, int *lda, double *W,
+                                          double *WORK, int *lwork, int *IWORK,
+                                          int *liwork, int *INFO) {
+  CPPARRAY_CLAPACK(dsyevd, DSYEVD)(JOBZ, UPLO, N, A, lda, W, WORK, lwork, IWORK,
+                                   liwork, INFO);
+}
+
+template <typename T>
+static void lapack_syevd(char JOBZ, char UPLO, int N, T *A, int lda, T *W,
+                         T *WORK, int lwork, int *IWORK, int liwork,
+                         int *INFO) {
+  lapack_Xsyevd(&JOBZ, &UPLO, &N, A, &lda, W, WORK, &lwork, IWORK, &liwork,
+                INFO);
+}
+
+// selected eigenvalues and eigenvectors of a symmetric matrix, relatively
+// robust representations
+static void MAY_NOT_BE_USED
+lapack_Xsyevr(char *JOBZ, char *RANGE, char *UPLO, int *N, float *A, int *lda,
+              float *VL, float *VU, int *IL, int *IU, float *ABSTOL, int *M,
+              float *W, float *Z, int *ldz, int *ISUPPZ, float *WORK,
+              int *lwork, int *IWORK, int *liwork, int *INFO) {
+  CPPARRAY_CLAPACK(ssyevr, SSYEVR)(JOBZ, RANGE, UPLO, N, A, lda, VL, VU, IL, IU,
+                                   ABSTOL, M, W, Z, ldz, ISUPPZ, WORK, lwork,
+                                   IWORK, liwork, INFO);
+}
+
+static void MAY_NOT_BE_USED
+lapack_Xsyevr(char *JOBZ, char *RANGE, char *UPLO, int *N, double *A, int *lda,
+              double *VL, double *VU, int *IL, int *IU, double *ABSTOL, int *M,
+              double *W, double *Z, int *ldz, int *ISUPPZ, double *WORK,
+              int *lwork, int *IWORK, int *liwork, int *INFO) {
+  CPPARRAY_CLAPACK(dsyevr, DSYEVR)(JOBZ, RANGE, UPLO, N, A, lda, VL, VU, IL, IU,
+                                   ABSTOL, M, W, Z, ldz, ISUPPZ, WORK, lwork,
+                                   IWORK, liwork, INFO);
+}
+
+template <typename T>
+static void lapack_syevr(char JOBZ, char RANGE, char UPLO, int N, T *A, int lda,
+                         T VL, T VU, int IL, int IU, T ABSTOL, int *M, T *W,
+                         T *Z, int ldz, int *ISUPPZ, T *WORK, int lwork,
+                         int *IWORK, int liwork, int *INFO) {
+  lapack_Xsyevr(&JOBZ, &RANGE, &UPLO, &N, A, &lda, &VL, &VU, &IL, &IU, &ABSTOL,
+                M, W, Z, &ldz, ISUPPZ, WORK, &lwork, IWORK, &liwork, INFO);
+}
+
 __END_ARRAY_NAMESPACE__
 
 #endif /* LAPACK_IMPL_HPP */
@@ -0,0 +1,433 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file parallel.hpp
+ *
+ * \brief This file contains the thread pool, the execution policies and the
+ * parallel loop used by the kernels of the library that are not handed over
+ * to BLAS.
+ */
+
+#ifndef ARRAY_PARALLEL_HPP
+#define ARRAY_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "array-config.hpp"
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! Number of hardware threads available to the parallel kernels
+inline size_t hardware_threads() {
+
+  unsigned int n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+
+//! Execution policy of the kernels that are not handed over to BLAS
+/*! Kernels run either sequentially on the calling thread (array::seq) or
+ * split across the threads of the pool (array::par). Kernels that do not
+ * take a policy use the library-wide default, see set_execution_policy.
+ */
+class Execution_policy {
+
+public:
+  constexpr explicit Execution_policy(bool parallel) : parallel_(parallel) {}
+
+  //! Whether work is split across threads
+  constexpr bool parallel() const { return parallel_; }
+
+  bool operator==(const Execution_policy &p) const {
+    return parallel_ == p.parallel_;
+  }
+
+  bool operator!=(const Execution_policy &p) const { return !(*this == p); }
+
+private:
+  bool parallel_;
+};
+
+//! Sequential execution policy
+constexpr Execution_policy seq(false);
+
+//! Parallel execution policy
+constexpr Execution_policy par(true);
+
+//! Library-wide default execution policy, parallel unless changed
+/*! Stored as an atomic flag, so the policy may be changed while threads of the
+ * pool are reading it.
+ */
+inline std::atomic<bool> &default_execution_policy() {
+  static std::atomic<bool> parallel(true);
+  return parallel;
+}
+
+//! Execution policy used by the kernels that do not take one
+inline Execution_policy execution_policy() {
+  return Execution_policy(
+      default_execution_policy().load(std::memory_order_relaxed));
+}
+
+//! Sets the execution policy used by the kernels that do not take one
+inline void set_execution_policy(Execution_policy p) {
+  default_execution_policy().store(p.parallel(), std::memory_order_relaxed);
+}
+
+
+//! Number of parallel loops of the library running on the current thread
+inline int &parallel_depth() {
+  static thread_local int d = 0;
+  return d;
+}
+
+//! Whether the current thread is running an iteration of a parallel loop
+inline bool in_parallel() { return parallel_depth() > 0; }
+
+//! Tells the control of the BLAS threads that a parallel region of the library
+// starts or ends, defined in blas_threads.hpp, which is included at the end of
+// this file
+inline void blas_parallel_region(bool start);
+
+//! Parallel loop or invocation running during the lifetime of the object
+class Parallel_region {
+
+public:
+  Parallel_region() { blas_parallel_region(true); }
+
+  Parallel_region(const Parallel_region &) = delete;
+  Parallel_region &operator=(const Parallel_region &) = delete;
+
+  ~Parallel_region() { blas_parallel_region(false); }
+};
+
+
+//! Number of bytes processed by a thread at a time, so that a chunk of each
+// operand of a kernel fits in the level 2 cache
+constexpr size_t cache_chunk_size = 1 << 18;
+
+//! Number of elements of type T in a cache-sized chunk
+template <typename T> constexpr size_t cache_chunk() {
+  return cache_chunk_size / sizeof(T) > 0 ? cache_chunk_size / sizeof(T) : 1;
+}
+
+
+//! Work-stealing thread pool
+/*! The pool owns hardware_threads() - 1 workers, the calling thread being
+ * the remaining one. Each worker has its own queue of tasks, and idle workers
+ * steal tasks from the back of the queues of the others. The pool is created
+ * on first use and shared by all the kernels of the library.
+ */
+class Thread_pool {
+
+public:
+  typedef std::function<void()> task_type;
+
+  //! Shared pool
+  static Thread_pool &instance() {
+    static Thread_pool pool(hardware_threads() - 1);
+    return pool;
+  }
+
+  explicit Thread_pool(size_t workers)
+      : queues_(workers), next_(), pending_(), done_() {
+    for (size_t i = 0; i < workers; ++i)
+      threads_.emplace_back([this, i]() { work(i); });
+  }
+
+  Thread_pool(const Thread_pool &) = delete;
+  Thread_pool &operator=(const Thread_pool &) = delete;
+
+  ~Thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_ = true;
+    }
+    ready_.notify_all();
+    for (auto &t : threads_)
+      t.join();
+  }
+
+  //! Number of worker threads
+  size_t size() const { return threads_.size(); }
+
+  //! Queues a task, tasks are spread over the workers in turn
+  void submit(task_type task) {
+
+    assert(!queues_.empty());
+    Queue &q = queues_[next_++ % queues_.size()];
+    {
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.tasks.push_front(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++pending_;
+    }
+    ready_.notify_one();
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<task_type> tasks;
+  };
+
+  //! Takes a task from the front of queue i, or steals one from the back of
+  // another queue
+  bool take(size_t i, task_type &task) {
+
+    for (size_t j = 0; j < queues_.size(); ++j) {
+      Queue &q = queues_[(i + j) % queues_.size()];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks.empty()) {
+        if (j == 0) {
+          task = std::move(q.tasks.front());
+          q.tasks.pop_front();
+        } else {
+          task = std::move(q.tasks.back());
+          q.tasks.pop_back();
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //! Worker loop
+  void work(size_t i) {
+
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return done_ || pending_ > 0; });
+        if (done_ && pending_ == 0)
+          return;
+        --pending_;
+      }
+      task_type task;
+      // a task counted as pending is in one of the queues
+      while (!take(i, task))
+        std::this_thread::yield();
+      task();
+    }
+  }
+
+  std::vector<Queue> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> next_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  size_t pending_;
+  bool done_;
+};
+
+
+//! Parallel loop
+/*! Calls f(i) for every i in [begin, end). With the parallel policy, the range
+ * is split in chunks of grain iterations that the calling thread and the
+ * workers of the pool claim one at a time until none is left, so faster
+ * threads take more chunks. The call returns once every iteration is done.
+ * Iterations must be independent. Loops nested in f are safe, since a thread
+ * waiting for its loop only waits for chunks that are already running.
+ */
+template <class F>
+void parallel_for(Execution_policy policy, size_t begin, size_t end, F f,
+                  size_t grain = 1) {
+
+  if (end <= begin)
+    return;
+
+  if (grain == 0)
+    grain = 1;
+
+  const size_t n = end - begin;
+  const size_t chunks = (n + grain - 1) / grain;
+  const size_t threads = std::min(hardware_threads(), chunks);
+
+  if (!policy.parallel() || threads <= 1) {
+    for (size_t i = begin; i < end; ++i)
+      f(i);
+    return;
+  }
+
+  Parallel_region region;
+
+  // state shared with the helpers, which may start after the loop is over
+  struct State {
+    std::atomic<size_t> next;
+    std::atomic<size_t> finished;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  std::shared_ptr<State> state = std::make_shared<State>();
+  state->next = 0;
+  state->finished = 0;
+
+  // claims chunks until none is left, returns after finishing the last one
+  auto run = [=, &f](State &st) {
+    ++parallel_depth();
+    for (size_t c; (c = st.next++) < chunks;) {
+      const size_t b = begin + c * grain, e = std::min(b + grain, end);
+      for (size_t i = b; i < e; ++i)
+        f(i);
+      if (++st.finished == chunks) {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.done.notify_all();
+      }
+    }
+    --parallel_depth();
+  };
+
+  // the helpers hold the state but only use f while chunks are left, that is
+  // while the calling thread is still waiting
+  std::function<void(State &)> helper = run;
+  Thread_pool &pool = Thread_pool::instance();
+  for (size_t t = 1; t < threads; ++t)
+    pool.submit([state, helper]() { helper(*state); });
+
+  run(*state);
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&]() { return state->finished == chunks; });
+}
+
+//! Runs f and g concurrently
+/*! With the parallel policy, g is queued on the pool while the calling thread
+ * runs f. If no worker has started g by then, the calling thread runs it
+ * too, so a thread never waits for a task that is not running, and calls
+ * nested in f or g are safe. The call returns once both are done.
+ */
+template <class F, class G>
+void parallel_invoke(Execution_policy policy, F f, G g) {
+
+  if (!policy.parallel() || hardware_threads() <= 1) {
+    f();
+    g();
+    return;
+  }
+
+  Parallel_region region;
+
+  // 0: g is queued, 1: g is running, 2: g is done
+  struct State {
+    std::atomic<int> stage;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  std::shared_ptr<State> state = std::make_shared<State>();
+  state->stage = 0;
+
+  // the task holds the state but only uses g if it claims it, that is while
+  // the calling thread is still waiting
+  G *pg = &g;
+  Thread_pool::instance().submit([state, pg]() {
+    int queued = 0;
+    if (state->stage.compare_exchange_strong(queued, 1)) {
+      (*pg)();
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->stage = 2;
+      state->done.notify_all();
+    }
+  });
+
+  f();
+
+  int queued = 0;
+  if (state->stage.compare_exchange_strong(queued, 1))
+    g();
+  else {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&]() { return state->stage == 2; });
+  }
+}
+
+//! Parallel loop with the default execution policy
+template <class F>
+void parallel_for(size_t begin, size_t end, F f, size_t grain = 1) {
+  parallel_for(execution_policy(), begin, end, f, grain);
+}
+
+
+//! Copies n elements from src into the uninitialized memory at dst
+/*! Elements that can be copied bitwise are copied in cache-sized chunks by
+ * the threads of the pool.
+ */
+template <typename T>
+void parallel_copy(Execution_policy policy, const T *src, size_t n, T *dst) {
+
+  if (!std::is_trivially_copyable<T>::value) {
+    std::uninitialized_copy_n(src, n, dst);
+    return;
+  }
+
+  const size_t chunk = cache_chunk<T>();
+  parallel_for(policy, 0, (n + chunk - 1) / chunk, [=](size_t c) {
+    const size_t b = c * chunk;
+    std::uninitialized_copy_n(src + b, std::min(chunk, n - b), dst + b);
+  });
+}
+
+//! Copies n elements with the default execution policy
+template <typename T> void parallel_copy(const T *src, size_t n, T *dst) {
+  parallel_copy(execution_policy(), src, n, dst);
+}
+
+//! Fills the uninitialized memory at dst with n copies of v
+template <typename T>
+void parallel_fill(Execution_policy policy, T *dst, size_t n, const T &v) {
+
+  if (!std::is_trivially_copyable<T>::value) {
+    std::uninitialized_fill_n(dst, n, v);
+    return;
+  }
+
+  const size_t chunk = cache_chunk<T>();
+  const T value = v;
+  parallel_for(policy, 0, (n + chunk - 1) / chunk, [=](size_t c) {
+    const size_t b = c * chunk;
+    std::uninitialized_fill_n(dst + b, std::min(chunk, n - b), value);
+  });
+}
+
+//! Fills n elements with the default execution policy
+template <typename T> void parallel_fill(T *dst, size_t n, const T &v) {
+  parallel_fill(execution_policy(), dst, n, v);
+}
+
+
+__END_ARRAY_NAMESPACE__
+
+// definition of blas_parallel_region
+#include "blas_threads.hpp"
+
+#endif /* ARRAY_PARALLEL_HPP */
@@ -31,6 +31,17 @@
 
 __BEGIN_ARRAY_NAMESPACE__
 
+//! Leaf type class template, gives the type of the array that results from
+// evaluating an operand, i.e., views evaluate into arrays.
+template <class A> struct Leaf_type {
+  typedef A type;
+};
+
+//! Leaf type partial template specialization for views
+template <int d, typename T> struct Leaf_type<View<d, T> > {
+  typedef Array<d, T> type;
+};
+
 //! Return type class template, declared but never defined (see the partial
 // template specializatoins).
 template <typename... Params> struct Return_type;
@@ -47,7 +58,8 @@ struct Return_type<Expr<BinExprOp<A, B, Op> > > {
 //! Return type for the operation of an arbitrary object with an arbitrary
 // expression
 template <typename A, typename B, class Op> struct Return_type<A, Expr<B>, Op> {
-  typedef typename Return_type<typename B::left_type, typename B::right_type,
+  typedef typename Return_type<typename Leaf_type<typename B::left_type>::type,
+                               typename Leaf_type<typename B::right_type>::type,
                                typename B::operator_type>::result_type
   right_result;
   typedef typename Return_type<A, right_result, Op>::result_type result_type;
@@ -56,7 +68,8 @@ template <typename A, typename B, class Op> struct Return_type<A, Expr<B>, Op> {
 //! Return type for the operation of an arbitrary expression with an arbitrary
 // object
 template <typename A, typename B, class Op> struct Return_type<Expr<A>, B, Op> {
-  typedef typename Return_type<typename A::left_type, typename A::right_type,
+  typedef typename Return_type<typename Leaf_type<typename A::left_type>::type,
+                               typename Leaf_type<typename A::right_type>::type,
                                typename A::operator_type>::result_type
   left_result;
   typedef typename Return_type<left_result, B, Op>::result_type result_type;
@@ -65,10 +78,12 @@ template <typename A, typename B, class Op> struct Return_type<Expr<A>, B, Op> {
 //! Return type for the operation between two arbitrary expressions
 template <typename A, typename B, class Op>
 struct Return_type<Expr<A>, Expr<B>, Op> {
-  typedef typename Return_type<typename A::left_type, typename A::right_type,
+  typedef typename Return_type<typename Leaf_type<typename A::left_type>::type,
+                               typename Leaf_type<typename A::right_type>::type,
                                typename A::operator_type>::result_type
   left_result;
-  typedef typename Return_type<typename B::left_type, typename B::right_type,
+  typedef typename Return_type<typename Leaf_type<typename B::left_type>::type,
+                               typename Leaf_type<typename B::right_type>::type,
                                typename B::operator_type>::result_type
   right_result;
   typedef typename Return_type<left_result, right_result, Op>::result_type
@@ -79,7 +94,7 @@ struct Return_type<Expr<A>, Expr<B>, Op> {
 
 //! Return type between scalar operations
 template <typename S, class Op>
-struct Return_type<typename std::enable_if<std::is_arithmetic<S>::value, S>::type, S, Op> {
+struct Return_type<typename std::enable_if<Is_scalar<S>::value, S>::type, S, Op> {
   typedef S result_type;
 };
 
@@ -89,6 +104,17 @@ struct Return_type<ExprLiteral<S>, Array<d, T>, Op> {
   typedef Array<d, T> result_type;
 };
 
+//! Return type for array - scalar operations
+template <int d, typename T, typename S, class Op>
+struct Return_type<Array<d, T>, ExprLiteral<S>, Op> {
+  typedef Array<d, T> result_type;
+};
+
+//! Return type for element-wise functions of one array
+template <int d, typename T> struct Return_type<Array<d, T>, EmptyType, ApMap> {
+  typedef Array<d, T> result_type;
+};
+
 //! Return type for vector transposition
 template <typename T> struct Return_type<Array<1, T>, EmptyType, ApTr> {
   typedef BinExprOp<Array<1, T>, EmptyType, ApTr> result_type;
@@ -0,0 +1,653 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file simd.hpp
+ *
+ * \brief This file contains the vectorized level 1 kernels used for element
+ * types that BLAS does not support, such as integers, and the vectorized
+ * exponential and logarithm used by the element-wise expressions.
+ */
+
+#ifndef ARRAY_SIMD_HPP
+#define ARRAY_SIMD_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "array-config.hpp"
+#include "array_fwd.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARRAY_SIMD_X86
+#endif
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! Level 1 kernels for element types without a BLAS implementation
+/*! The kernels mirror the BLAS routines axpy, scal, dot, asum, nrm2 and
+ * iamax. The sweeps compute several reductions at once, and are also used for
+ * the norms of floating point arrays, so each array is read only once.
+ * Contiguous arrays of integers are processed in registers of 32 bytes
+ * (AVX2) or 64 bytes (AVX-512), and the instruction set is chosen once at run
+ * time from the features of the processor, so binaries built for a generic
+ * target still use the widest registers available. Strided arrays and other
+ * element types are processed with plain loops. Like their BLAS counterparts,
+ * the 2-norm and the sums of integers are computed in the element type. The
+ * exponential and the logarithm of contiguous float and double arrays are
+ * evaluated in the same registers with the Cephes polynomials.
+ */
+struct Simd {
+
+  //! Instruction sets used by the kernels
+  enum Isa { Isa_generic, Isa_avx2, Isa_avx512 };
+
+  //! Instruction set used on this processor, detected on first use
+  static Isa isa() {
+    static const Isa i = detect();
+    return i;
+  }
+
+  //! Whether contiguous arrays of type T are processed in vector registers
+  template <typename T>
+  struct Vectorized
+      : std::integral_constant<bool, std::is_integral<T>::value &&
+                                         !std::is_same<T, bool>::value> {};
+
+  //! y <- alpha*x + y
+  template <typename T>
+  static void axpy(size_t n, T alpha, const T *x, size_t incx, T *y,
+                   size_t incy) {
+    if (incx == 1 && incy == 1 &&
+        dispatch<Axpy>(typename Vectorized<T>::type(), n, alpha, x, y))
+      return;
+    for (size_t i = 0; i < n; ++i)
+      y[i * incy] += alpha * x[i * incx];
+  }
+
+  //! x <- alpha*x
+  template <typename T> static void scal(size_t n, T alpha, T *x, size_t incx) {
+    if (incx == 1 &&
+        dispatch<Scal>(typename Vectorized<T>::type(), n, alpha, x))
+      return;
+    for (size_t i = 0; i < n; ++i)
+      x[i * incx] *= alpha;
+  }
+
+  //! Dot product x'*y
+  template <typename T>
+  static T dot(size_t n, const T *x, size_t incx, const T *y, size_t incy) {
+    T r = T();
+    if (incx == 1 && incy == 1 &&
+        dispatch<Dot>(typename Vectorized<T>::type(), n, x, y, &r))
+      return r;
+    for (size_t i = 0; i < n; ++i)
+      r += x[i * incx] * y[i * incy];
+    return r;
+  }
+
+  //! Sum of absolute values
+  template <typename T> static T asum(size_t n, const T *x, size_t incx) {
+    T r = T();
+    if (incx == 1 &&
+        dispatch<Asum>(typename Vectorized<T>::type(), n, x, &r))
+      return r;
+    for (size_t i = 0; i < n; ++i)
+      r += magnitude(x[i * incx]);
+    return r;
+  }
+
+  //! Euclidean norm, truncated for integers
+  template <typename T> static T nrm2(size_t n, const T *x, size_t incx) {
+    return static_cast<T>(std::sqrt(dot(n, x, incx, x, incx)));
+  }
+
+  //! Index of the first element of largest absolute value, 0 if n is 0
+  template <typename T> static size_t iamax(size_t n, const T *x, size_t incx) {
+    T m = T();
+    if (incx == 1 &&
+        dispatch<Amax>(typename Vectorized<T>::type(), n, x, &m)) {
+      for (size_t i = 0; i < n; ++i)
+        if (magnitude(x[i]) == m)
+          return i;
+    }
+    size_t r = 0;
+    for (size_t i = 0; i < n; ++i)
+      if (magnitude(x[i * incx]) > m) {
+        m = magnitude(x[i * incx]);
+        r = i;
+      }
+    return r;
+  }
+
+  //! Whether the elementary functions of type T are evaluated in vector
+  // registers
+  template <typename T>
+  struct Floating
+      : std::integral_constant<bool, std::is_same<T, float>::value ||
+                                         std::is_same<T, double>::value> {};
+
+  //! y <- exp(x) element by element, y may be x
+  template <typename T> static void exp(size_t n, const T *x, T *y) {
+    if (dispatch<Exp>(typename Floating<T>::type(), n, x, y))
+      return;
+    for (size_t i = 0; i < n; ++i)
+      y[i] = std::exp(x[i]);
+  }
+
+  //! y <- log(x) element by element, y may be x
+  template <typename T> static void log(size_t n, const T *x, T *y) {
+    if (dispatch<Log>(typename Floating<T>::type(), n, x, y))
+      return;
+    for (size_t i = 0; i < n; ++i)
+      y[i] = std::log(x[i]);
+  }
+
+  //! Reductions accumulated by a sweep over an array
+  template <typename T> struct Sums {
+    typedef typename Real_type<T>::type real_type;
+
+    real_type abs; //!< Sum of absolute values
+    real_type sq;  //!< Sum of squared absolute values
+    real_type max; //!< Largest absolute value
+    T sum;         //!< Sum of the elements
+
+    Sums() : abs(), sq(), max(), sum() {}
+
+    //! Merges the reductions of another part of the array
+    void merge(const Sums &s) {
+      abs += s.abs;
+      sq += s.sq;
+      if (s.max > max)
+        max = s.max;
+      sum += s.sum;
+    }
+  };
+
+  //! Accumulates the reductions of x into s in a single sweep, and adds the
+  // absolute values of the elements to r if r is not null
+  template <typename T>
+  static void sweep(size_t n, const T *x, size_t incx, Sums<T> &s,
+                    typename Sums<T>::real_type *r = nullptr) {
+    if (incx == 1 &&
+        dispatch<Sweep>(typename Packed<T>::type(), n, x, r, &s))
+      return;
+    for (size_t i = 0; i < n; ++i) {
+      typename Sums<T>::real_type a = magnitude(x[i * incx]);
+      s.abs += a;
+      s.sq += a * a;
+      if (a > s.max)
+        s.max = a;
+      s.sum += x[i * incx];
+      if (r)
+        r[i] += a;
+    }
+  }
+
+  //! Sums of absolute values of the columns and of the rows of the m x n
+  // matrix a stored by columns with leading dimension lda, together with the
+  // reductions of all elements
+  /*! The matrix is swept once in blocks of rows, so the row sums being
+   * accumulated stay in cache while the columns are read contiguously.
+   */
+  template <typename T>
+  static void sweep(size_t m, size_t n, const T *a, size_t lda, Sums<T> &s,
+                    typename Sums<T>::real_type *columns,
+                    typename Sums<T>::real_type *rows) {
+    typedef typename Sums<T>::real_type real_type;
+    std::fill_n(columns, n, real_type());
+    std::fill_n(rows, m, real_type());
+    for (size_t i = 0; i < m; i += block_size) {
+      const size_t l = m - i < block_size ? m - i : block_size;
+      for (size_t j = 0; j < n; ++j) {
+        Sums<T> c;
+        sweep(l, a + i + j * lda, 1, c, rows + i);
+        columns[j] += c.abs;
+        s.merge(c);
+      }
+    }
+  }
+
+private:
+  //! Number of rows in the blocks of a matrix sweep
+  static constexpr size_t block_size = 512;
+
+  //! Whether contiguous arrays of type T are swept in vector registers
+  template <typename T>
+  struct Packed
+      : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                         !std::is_same<T, bool>::value &&
+                                         sizeof(T) <= 8> {};
+
+  //! Absolute value, also defined for unsigned and complex types
+  template <typename T> static T magnitude(T x) { return x < T() ? T(-x) : x; }
+
+  template <typename T> static T magnitude(const std::complex<T> &x) {
+    return std::abs(x);
+  }
+
+  //! Runs kernel K on the widest registers available, false if the type is
+  // not vectorized or the processor has no suitable instruction set
+  template <class K, class... Args>
+  static bool dispatch(std::false_type, Args...) {
+    return false;
+  }
+
+  template <class K, class... Args>
+  static bool dispatch(std::true_type, Args... args) {
+#ifdef ARRAY_SIMD_X86
+    switch (isa()) {
+    case Isa_avx512:
+      run_avx512<K>(args...);
+      return true;
+    case Isa_avx2:
+      run_avx2<K>(args...);
+      return true;
+    default:
+      break;
+    }
+#endif
+    return false;
+  }
+
+  static Isa detect() {
+#ifdef ARRAY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq"))
+      return Isa_avx512;
+    if (__builtin_cpu_supports("avx2"))
+      return Isa_avx2;
+#endif
+    return Isa_generic;
+  }
+
+#ifdef ARRAY_SIMD_X86
+  // the kernels are inlined into these functions, so that the vector
+  // operations are compiled for the corresponding instruction set
+  template <class K, class... Args>
+  __attribute__((target("avx512f,avx512bw,avx512dq"))) static void
+  run_avx512(Args... args) {
+    K::template apply<64>(args...);
+  }
+
+  template <class K, class... Args>
+  __attribute__((target("avx2"))) static void run_avx2(Args... args) {
+    K::template apply<32>(args...);
+  }
+#endif
+
+  //! Vector of W bytes holding elements of type T
+  /*! Vectors are only passed by reference, so that no vector crosses a
+   * function boundary compiled for a different instruction set.
+   */
+  template <size_t W, typename T> struct Pack {
+    typedef T type __attribute__((vector_size(W)));
+    static constexpr size_t size = W / sizeof(T);
+
+    __attribute__((always_inline)) static inline void load(type &v,
+                                                           const T *p) {
+      __builtin_memcpy(&v, p, W);
+    }
+
+    __attribute__((always_inline)) static inline void store(T *p,
+                                                            const type &v) {
+      __builtin_memcpy(p, &v, W);
+    }
+
+    __attribute__((always_inline)) static inline void abs(type &v) {
+      if (std::is_signed<T>::value)
+        v = v < 0 ? -v : v;
+    }
+
+    //! Sum of the elements
+    __attribute__((always_inline)) static inline T sum(const type &v) {
+      T r = T();
+      for (size_t i = 0; i < size; ++i)
+        r += v[i];
+      return r;
+    }
+  };
+
+  //! Constants of the elementary functions for each floating point type
+  /*! The argument of the exponential is reduced to r = x - k*ln(2), with the
+   * logarithm of two split in two parts so that k*ln(2) is exact, and the
+   * result is scaled by 2^k by adding k to the exponent bits. The argument of
+   * the logarithm is split into its exponent and a mantissa m in
+   * [sqrt(1/2), sqrt(2)). Arguments outside the range of the reduction (large
+   * or subnormal results, zero, negative, infinite and NaN arguments) are
+   * left to the standard library.
+   */
+  template <typename T, class = void> struct Math;
+
+  template <class D> struct Math<double, D> {
+    typedef int64_t bits_type;
+    static constexpr int mantissa = 52;
+    static constexpr bits_type bias = 1023;
+
+    static double exp_min() { return -708.; }
+    static double exp_max() { return 709.; }
+    static double log_min() { return 2.2250738585072014e-308; }
+    static double log_max() { return 1.7976931348623157e308; }
+
+    //! 1.5*2^52, adding it rounds a double to an integer in the low bits
+    static double round() { return 6755399441055744.; }
+
+    //! ln(2) split in two parts, the first one with few significant bits
+    static double ln2_hi() { return 6.93145751953125e-1; }
+    static double ln2_lo() { return 1.42860682030941723212e-6; }
+
+    //! r <- exp(r) for |r| <= ln(2)/2
+    template <class V>
+    __attribute__((always_inline)) static inline void exp(V &r) {
+      const V z = r * r;
+      const V p = r * ((1.26177193074810590878e-4 * z +
+                        3.02994407707441961300e-2) * z +
+                       9.99999999999999999910e-1);
+      const V q = ((3.00198505138664455042e-6 * z +
+                    2.52448340349684104192e-3) * z +
+                   2.27265548208155028766e-1) * z +
+                  2.00000000000000000009e0;
+      r = 1. + 2. * p / (q - p);
+    }
+
+    //! r <- log(1 + m) - m + z/2 for m in [sqrt(1/2) - 1, sqrt(2) - 1) and
+    // z = m^2
+    template <class V>
+    __attribute__((always_inline)) static inline void log(V &r, const V &m,
+                                                          const V &z) {
+      const V p = ((((1.01875663804580931796e-4 * m +
+                      4.97494994976747001425e-1) * m +
+                     4.70579119878881725854e0) * m +
+                    1.44989225341610930846e1) * m +
+                   1.79368678507819816313e1) * m +
+                  7.70838733755885391666e0;
+      const V q = ((((m + 1.12873587189167450590e1) * m +
+                     4.52279145837532221105e1) * m +
+                    8.29875266912776603211e1) * m +
+                   7.11544750618563894466e1) * m +
+                  2.31251620126765340583e1;
+      r = m * (z * p / q);
+    }
+  };
+
+  template <class D> struct Math<float, D> {
+    typedef int32_t bits_type;
+    static constexpr int mantissa = 23;
+    static constexpr bits_type bias = 127;
+
+    static float exp_min() { return -87.f; }
+    static float exp_max() { return 88.f; }
+    static float log_min() { return 1.17549435e-38f; }
+    static float log_max() { return 3.40282347e38f; }
+
+    //! 1.5*2^23, adding it rounds a float to an integer in the low bits
+    static float round() { return 12582912.f; }
+
+    static float ln2_hi() { return 0.693359375f; }
+    static float ln2_lo() { return -2.12194440e-4f; }
+
+    template <class V>
+    __attribute__((always_inline)) static inline void exp(V &r) {
+      const V z = r * r;
+      r = (((((1.9875691500e-4f * r + 1.3981999507e-3f) * r +
+                 8.3334519073e-3f) * r + 4.1665795894e-2f) * r +
+               1.6666665459e-1f) * r + 5.0000001201e-1f) * z + r + 1.f;
+    }
+
+    template <class V>
+    __attribute__((always_inline)) static inline void log(V &r, const V &m,
+                                                          const V &z) {
+      r = ((((((((7.0376836292e-2f * m - 1.1514610310e-1f) * m +
+                    1.1676998740e-1f) * m - 1.2420140846e-1f) * m +
+                  1.4249322787e-1f) * m - 1.6668057665e-1f) * m +
+                2.0000714765e-1f) * m - 2.4999993993e-1f) * m +
+              3.3333331174e-1f) * m * z;
+    }
+  };
+
+  struct Exp {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void apply(size_t n,
+                                                            const T *x, T *y) {
+      typedef Pack<W, T> P;
+      typedef Math<T> M;
+      typedef typename M::bits_type B;
+      typedef B bits __attribute__((vector_size(W)));
+
+      const T c = M::round(), lo = M::exp_min(), hi = M::exp_max();
+      B cb;
+      std::memcpy(&cb, &c, sizeof(T));
+
+      typename P::type a, t, k, r;
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        // clamped so that 2^k is a normal number, NaN is mapped to lo
+        t = a >= lo ? a : lo;
+        t = t <= hi ? t : hi;
+        // k = round(x/ln(2)), r = x - k*ln(2)
+        k = t * T(1.44269504088896340736) + c;
+        const bits e = ((bits)k - cb + M::bias) << M::mantissa;
+        k -= c;
+        r = t - k * M::ln2_hi();
+        r = r - k * M::ln2_lo();
+        M::exp(r);
+        r *= (typename P::type)e;
+        for (size_t j = 0; j < P::size; ++j)
+          if (!(a[j] >= lo && a[j] <= hi))
+            r[j] = std::exp(a[j]);
+        P::store(y + i, r);
+      }
+      for (; i < n; ++i)
+        y[i] = std::exp(x[i]);
+    }
+  };
+
+  struct Log {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void apply(size_t n,
+                                                            const T *x, T *y) {
+      typedef Pack<W, T> P;
+      typedef Math<T> M;
+      typedef typename M::bits_type B;
+      typedef B bits __attribute__((vector_size(W)));
+
+      const T c = M::round(), lo = M::log_min(), hi = M::log_max();
+      const B exponent = (B(2) * M::bias + 1) << M::mantissa;
+      B cb;
+      std::memcpy(&cb, &c, sizeof(T));
+
+      typename P::type a, t, m, z, f, r;
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        // clamped to the normal numbers, NaN is mapped to lo
+        t = a >= lo ? a : lo;
+        t = t <= hi ? t : hi;
+        // x = 2^e*m, with m in [1/2, 1), and e is converted to floating
+        // point through the rounding constant
+        const bits b = (bits)t;
+        f = (typename P::type)((b >> M::mantissa) - (M::bias - 1) + cb) - c;
+        m = (typename P::type)((b & ~exponent) | ((M::bias - 1) << M::mantissa));
+        // m in [sqrt(1/2), sqrt(2)), shifted by one
+        f = m < T(0.70710678118654752440) ? f - T(1) : f;
+        m = (m < T(0.70710678118654752440) ? m + m : m) - T(1);
+        z = m * m;
+        M::log(r, m, z);
+        r -= f * T(2.121944400546905827679e-4);
+        r -= T(0.5) * z;
+        r += m;
+        r += f * T(0.693359375);
+        for (size_t j = 0; j < P::size; ++j)
+          if (!(a[j] >= lo && a[j] <= hi))
+            r[j] = std::log(a[j]);
+        P::store(y + i, r);
+      }
+      for (; i < n; ++i)
+        y[i] = std::log(x[i]);
+    }
+  };
+
+  struct Axpy {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void
+    apply(size_t n, T alpha, const T *x, T *y) {
+      typedef Pack<W, T> P;
+      typename P::type a, b;
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        P::load(b, y + i);
+        b += alpha * a;
+        P::store(y + i, b);
+      }
+      for (; i < n; ++i)
+        y[i] += alpha * x[i];
+    }
+  };
+
+  struct Scal {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void apply(size_t n, T alpha,
+                                                            T *x) {
+      typedef Pack<W, T> P;
+      typename P::type a;
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        a *= alpha;
+        P::store(x + i, a);
+      }
+      for (; i < n; ++i)
+        x[i] *= alpha;
+    }
+  };
+
+  struct Dot {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void
+    apply(size_t n, const T *x, const T *y, T *r) {
+      typedef Pack<W, T> P;
+      typename P::type a, b, s = {};
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        P::load(b, y + i);
+        s += a * b;
+      }
+      *r = P::sum(s);
+      for (; i < n; ++i)
+        *r += x[i] * y[i];
+    }
+  };
+
+  struct Asum {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void apply(size_t n,
+                                                            const T *x, T *r) {
+      typedef Pack<W, T> P;
+      typename P::type a, s = {};
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        P::abs(a);
+        s += a;
+      }
+      *r = P::sum(s);
+      for (; i < n; ++i)
+        *r += magnitude(x[i]);
+    }
+  };
+
+  //! Largest absolute value
+  struct Amax {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void apply(size_t n,
+                                                            const T *x, T *r) {
+      typedef Pack<W, T> P;
+      typename P::type a, m = {};
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        P::abs(a);
+        m = a > m ? a : m;
+      }
+      *r = T();
+      for (size_t j = 0; j < P::size; ++j)
+        if (m[j] > *r)
+          *r = m[j];
+      for (; i < n; ++i)
+        if (magnitude(x[i]) > *r)
+          *r = magnitude(x[i]);
+    }
+  };
+
+  struct Sweep {
+    template <size_t W, typename T>
+    __attribute__((always_inline)) static inline void
+    apply(size_t n, const T *x, T *r, Sums<T> *s) {
+      typedef Pack<W, T> P;
+      typename P::type a, b, va = {}, vq = {}, vm = {}, vs = {};
+      size_t i = 0;
+      for (; i + P::size <= n; i += P::size) {
+        P::load(a, x + i);
+        vs += a;
+        P::abs(a);
+        va += a;
+        vq += a * a;
+        vm = a > vm ? a : vm;
+        if (r) {
+          P::load(b, r + i);
+          b += a;
+          P::store(r + i, b);
+        }
+      }
+      Sums<T> t;
+      t.abs = P::sum(va);
+      t.sq = P::sum(vq);
+      t.sum = P::sum(vs);
+      for (size_t j = 0; j < P::size; ++j)
+        if (vm[j] > t.max)
+          t.max = vm[j];
+      for (; i < n; ++i) {
+        const T e = magnitude(x[i]);
+        t.abs += e;
+        t.sq += e * e;
+        if (e > t.max)
+          t.max = e;
+        t.sum += x[i];
+        if (r)
+          r[i] += e;
+      }
+      s->merge(t);
+    }
+  };
+};
+
+
+__END_ARRAY_NAMESPACE__
+
+#endif /* ARRAY_SIMD_HPP */
@@ -0,0 +1,233 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*! \file view.hpp
+ *
+ * \brief This file contains the View class template, a non-owning strided
+ * reference to a part of an array.
+ */
+
+#ifndef ARRAY_VIEW_HPP
+#define ARRAY_VIEW_HPP
+
+#include "array_impl.hpp"
+
+
+__BEGIN_ARRAY_NAMESPACE__
+
+
+//! View class template
+/*! A view refers to elements of an array without owning them, e.g., a block
+ * of a matrix, a single row or column, or a slice of a tensor along any
+ * dimension. Element (i,j,...) is located at data() + i*stride(0) +
+ * j*stride(1) + ..., so views of views are views again.
+ *
+ * Views are copied by reference, like pointers, but assigning to a view writes
+ * to the referenced elements. They are used in expressions like arrays, and
+ * their leading dimension and strides are passed to BLAS instead of copying
+ * them.
+ * \tparam k - View rank
+ * \tparam T - Type of the elements
+ */
+template <int k, typename T>
+class View {
+
+public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef T &reference;
+
+private:
+  pointer data_;   //!< Pointer to the first element
+  size_t n_[k];    //!< View dimensions
+  size_t s_[k];    //!< Distance between consecutive elements along each dimension
+
+public:
+  //! Rank of the view
+  constexpr static int rank() { return k; }
+
+  //! Parameter constructor
+  /*! \param p - Pointer to the first element
+   * \param n - Dimensions of the view
+   * \param s - Strides of the view
+   */
+  View(pointer p, const size_t n[], const size_t s[]) : data_(p) {
+    std::copy_n(n, k, n_);
+    std::copy_n(s, k, s_);
+  }
+
+  //! Copy constructor, the copy refers to the same elements
+  View(const View &v) = default;
+
+  //! Assignment operator, copies the elements of another view
+  View &operator=(const View &src) { return *this = value_type(1) * src; }
+
+  //! Assignment operator, copies the elements of an array
+  View &operator=(const Array<k, T> &src) { return *this = value_type(1) * src; }
+
+  //! Assignment operator taking an arbitrary expression
+  template <class A> View &operator=(const Expr<A> &expr);
+
+  //! Addition compound assignment operator taking an arbitrary expression
+  template <class A> View &operator+=(const Expr<A> &expr);
+
+  //! Addition compound assignment operator
+  View &operator+=(const Array<k, T> &a) { return *this += value_type(1) * a; }
+
+  //! Addition compound assignment operator
+  View &operator+=(const View &v) { return *this += value_type(1) * v; }
+
+  //! Subtraction compound assignment operator taking an arbitrary expression
+  template <class A> View &operator-=(const Expr<A> &expr) {
+    return *this += value_type(-1) * expr;
+  }
+
+  //! Subtraction compound assignment operator
+  View &operator-=(const Array<k, T> &a) { return *this += value_type(-1) * a; }
+
+  //! Subtraction compound assignment operator
+  View &operator-=(const View &v) { return *this += value_type(-1) * v; }
+
+  //! Multiplication compound assignment operator
+  View &operator*=(value_type s) {
+    scale(s, Int2Type<k>());
+    return *this;
+  }
+
+  //! Division compound assignment operator
+  View &operator/=(value_type s) {
+    scale(value_type(1) / s, Int2Type<k>());
+    return *this;
+  }
+
+  //! Pointer to the first element
+  pointer data() const { return data_; }
+
+  //! Number of elements
+  size_t size() const {
+    size_t n = 1;
+    for (int i = 0; i < k; ++i)
+      n *= n_[i];
+    return n;
+  }
+
+  //! Size along the ith direction
+  size_t size(size_t i) const { return n_[i]; }
+
+  //! Distance between consecutive elements along the ith direction
+  size_t stride(size_t i) const { return s_[i]; }
+
+  //! Matrix rows
+  size_t rows() const {
+    static_assert(k == 2, "*** ERROR *** Rows are only defined for matrices.");
+    return n_[0];
+  }
+
+  //! Matrix columns
+  size_t columns() const {
+    static_assert(k == 2, "*** ERROR *** Columns are only defined for matrices.");
+    return n_[1];
+  }
+
+  //! Indexed access through operator()
+  template <typename... Args> reference operator()(Args... params) const {
+
+    static_assert(sizeof...(Args) == k,
+                  "*** ERROR *** Number of parameters does not match view rank.");
+
+    size_t indices[] = { static_cast<size_t>(params)... };
+    size_t o = 0;
+    for (int i = 0; i < k; ++i) {
+      assert(indices[i] < n_[i]);
+      o += indices[i] * s_[i];
+    }
+    return data_[o];
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // views of views
+
+  //! View of the ith slice along dimension d, which has one dimension less
+  template <int d> View<k - 1, T> slice(size_t i) const {
+
+    static_assert(k > 1 && d >= 0 && d < k,
+                  "*** ERROR *** Wrong dimension for slice.");
+    assert(i < n_[d]);
+
+    size_t n[k - 1], s[k - 1];
+    for (int j = 0, l = 0; j < k; ++j)
+      if (j != d) {
+        n[l] = n_[j];
+        s[l++] = s_[j];
+      }
+    return View<k - 1, T>(data_ + i * s_[d], n, s);
+  }
+
+  //! View of the elements [i, i + m) along dimension d
+  template <int d> View range(size_t i, size_t m) const {
+
+    static_assert(d >= 0 && d < k, "*** ERROR *** Wrong dimension for range.");
+    assert(m > 0 && i + m <= n_[d]);
+
+    View v(*this);
+    v.data_ += i * s_[d];
+    v.n_[d] = m;
+    return v;
+  }
+
+  //! Row i of a matrix
+  View<1, T> row(size_t i) const { return slice<0>(i); }
+
+  //! Column j of a matrix
+  View<1, T> column(size_t j) const { return slice<1>(j); }
+
+  //! Elements [i, i + m) of a vector
+  View block(size_t i, size_t m) const {
+    static_assert(k == 1, "*** ERROR *** Wrong number of parameters for block.");
+    return range<0>(i, m);
+  }
+
+  //! Block of a matrix with m rows and n columns starting at (i,j)
+  View block(size_t i, size_t j, size_t m, size_t n) const {
+    static_assert(k == 2, "*** ERROR *** Wrong number of parameters for block.");
+    return range<0>(i, m).template range<1>(j, n);
+  }
+
+  //! Standard output
+  friend std::ostream &operator<<(std::ostream &os, const View &v) {
+    return os << Array<k, T>(v);
+  }
+
+private:
+  //! Helper function used to scale vectors with a single BLAS call
+  void scale(value_type s, Int2Type<1>) { cblas_scal(n_[0], s, data_, s_[0]); }
+
+  //! Helper function used to scale the slices along the last dimension
+  template <int d> void scale(value_type s, Int2Type<d>) {
+    for (size_t i = 0; i < n_[k - 1]; ++i)
+      slice<k - 1>(i) *= s;
+  }
+};
+
+
+__END_ARRAY_NAMESPACE__
+
+#endif /* ARRAY_VIEW_HPP */
@@ -75,6 +75,21 @@ int main() {
     }
   }
 
+  // the stride table follows copies and moves
+  assert(TT.size() == m * n * o * p);
+  assert(TT.stride(0) == 1 && TT.stride(1) == m && TT.stride(2) == m * n);
+  assert(TT.stride(3) == m * n * o && TT.stride(4) == TT.size());
+
+  tensor_type<double> UU(TT), VV(std::move(UU));
+  assert(UU.size() == 0 && VV.size() == TT.size());
+  UU = std::move(VV);
+  assert(VV.size() == 0 && UU.size() == TT.size());
+  for (size_t l = 0; l < p; ++l)
+    for (size_t k = 0; k < o; ++k)
+      for (size_t j = 0; j < n; ++j)
+        for (size_t i = 0; i < m; ++i)
+          assert(UU(i, j, k, l) == TT(i, j, k, l));
+
   cout << "Ok!" << endl;
 
   return 0;
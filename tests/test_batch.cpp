@@ -0,0 +1,125 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file test_batch.cpp
+ *
+ * \brief This file tests the batched matrix-matrix and matrix-vector
+ * products.
+ */
+
+#include "array.hpp"
+
+using std::cout;
+using std::endl;
+
+using array::Array;
+using array::matrix_type;
+using array::vector_type;
+using array::transpose;
+
+// fills an array with small integers so that the products are exact
+template <int k> void fill(Array<k, double> &a, int seed) {
+  for (size_t i = 0; i < a.size(); ++i)
+    a.data()[i] = static_cast<int>((i * 7 + seed) % 11) - 5;
+}
+
+// largest difference between the batched products and the products computed
+// one matrix at a time
+double difference(Array<3, double> &A, Array<3, double> &B,
+                  Array<3, double> &C, bool ta, bool tb) {
+
+  double d = 0.;
+  for (size_t i = 0; i < C.size(2); ++i) {
+    matrix_type<double> a = A.slice<2>(A.size(2) == 1 ? 0 : i);
+    matrix_type<double> b = B.slice<2>(B.size(2) == 1 ? 0 : i);
+    matrix_type<double> r = ta ? (tb ? matrix_type<double>(transpose(a) * transpose(b))
+                                     : matrix_type<double>(transpose(a) * b))
+                               : (tb ? matrix_type<double>(a * transpose(b))
+                                     : matrix_type<double>(a * b));
+    matrix_type<double> c = C.slice<2>(i);
+    for (size_t j = 0; j < r.size(); ++j)
+      d = std::max(d, std::abs(r.data()[j] - c.data()[j]));
+  }
+  return d;
+}
+
+int main() {
+
+  // a few small products printed in full
+  Array<3, double> A(2, 3, 2), B(3, 2, 2);
+  fill(A, 1);
+  fill(B, 2);
+
+  Array<3, double> C = array::batch_multiply(A, B);
+  cout << "Batch of matrices A:\n" << A << endl;
+  cout << "Batch of matrices B:\n" << B << endl;
+  cout << "Batched products A(:,:,i)*B(:,:,i):\n" << C << endl;
+
+  // accumulate twice the product of the transposes
+  Array<3, double> D(3, 3, 2, 1.);
+  array::batch_gemm(A, B, D, 2., 1., true, true);
+  cout << "Batched 2*A(:,:,i)'*B(:,:,i)' + 1:\n" << D << endl;
+
+  // matrix-vector products with a shared matrix
+  Array<3, double> S(2, 3, 1);
+  fill(S, 3);
+  Array<2, double> x(3, 4);
+  fill(x, 4);
+  cout << "Shared matrix times the columns of x:\n"
+       << array::batch_multiply(S, x) << endl;
+
+  Array<2, double> y(3, 2, 1.);
+  Array<2, double> z = { { 1, 2 }, { 3, 4 } };
+  array::batch_gemv(A, z, y, 1., -1., true);
+  cout << "Batched A(:,:,i)'*z(:,i) - 1:\n" << y << endl;
+
+  // many products in every mode, compared with products done one at a time
+  bool ok = true;
+  for (size_t n : { 3, 8, 40 }) {
+    Array<3, double> E(n, n, 100), F(n, n, 100), G(n, n, 1), H(n, n, 100);
+    fill(E, 5);
+    fill(F, 6);
+    fill(G, 7);
+    for (int t = 0; t < 4; ++t) {
+      array::batch_gemm(E, F, H, 1., 0., t & 1, t & 2);
+      ok = ok && difference(E, F, H, t & 1, t & 2) == 0.;
+      array::batch_gemm(E, G, H, 1., 0., t & 1, t & 2);
+      ok = ok && difference(E, G, H, t & 1, t & 2) == 0.;
+    }
+
+    Array<2, double> v(n, 100), w(n, 100);
+    fill(v, 8);
+    for (int t = 0; t < 2; ++t) {
+      array::batch_gemv(E, v, w, 1., 0., t);
+      for (size_t i = 0; i < 100; ++i) {
+        matrix_type<double> e = E.slice<2>(i);
+        vector_type<double> vi = v.slice<1>(i), wi = w.slice<1>(i);
+        vector_type<double> r = t ? vector_type<double>(transpose(e) * vi)
+                                  : vector_type<double>(e * vi);
+        for (size_t j = 0; j < n; ++j)
+          ok = ok && r[j] == wi[j];
+      }
+    }
+  }
+  cout << "Batched products agree with single products: " << (ok ? "yes" : "no")
+       << endl;
+
+  return 0;
+}
@@ -61,6 +61,14 @@ int main(int argc, char **argv) {
 
   cout << "(2.*X)+(3*Y) = " << ((2. * X) + (3 * Y)) << endl;
 
+  // element-wise expressions evaluated in a single loop
+  vector_type Z = X + 2. * Y - X + Y;
+  cout << "Z = X+(2.*Y)-X+Y = " << Z << endl;
+  Z = 2. * (X - Y) + 3. * X;
+  cout << "Z = 2.*(X-Y)+(3.*X) = " << Z << endl;
+  Z += X - Y + Z;
+  cout << "Z += X-Y+Z = " << Z << endl;
+
   cout << "transpose(X)* Y / (transpose(X)*X) = " << (transpose(X)* Y / (transpose(X)*X)) << endl;
 
   cout << "(transpose(X) * Y) = " << (transpose(X) * Y) << endl;
@@ -182,5 +190,154 @@ int main(int argc, char **argv) {
   cout << " D " << D << endl;
   cout << "2.*D*transpose(X): " << (2. * D * transpose(X)) << endl;
 
+  // products evaluated in place through the beta factor of BLAS
+  matrix_type F = A * B;
+  cout << "F = A*B: " << F << endl;
+  F = 2. * A * B + 3. * F;
+  cout << "F = 2.*A*B + 3.*F: " << F << endl;
+  F = transpose(B) * transpose(A) - F;
+  cout << "F = transpose(B)*transpose(A) - F: " << F << endl;
+  F += A * (0.5 * B) + transpose(B) * transpose(A);
+  cout << "F += A*(0.5*B) + transpose(B)*transpose(A): " << F << endl;
+  F -= 2. * A * B;
+  cout << "F -= 2.*A*B: " << F << endl;
+  F = F * F;
+  cout << "F = F*F: " << F << endl;
+
+  vector_type U(m), V(n);
+  for (size_t i = 0; i < m; ++i)
+    U(i) = i + 1;
+  V = transpose(A) * U;
+  cout << "V = transpose(A)*U: " << V << endl;
+  U = U - 2. * A * V;
+  cout << "U = U - 2.*A*V: " << U << endl;
+  U += transpose(B) * V;
+  cout << "U += transpose(B)*V: " << U << endl;
+
+  F = U * transpose(U);
+  cout << "F = U*transpose(U): " << F << endl;
+
+  // lazy transposes
+  cout << "transpose(A)+2.*B: " << (transpose(A) + 2. * B) << endl;
+  F = A * B;
+  F = transpose(F) - 2. * F;
+  cout << "F = transpose(F)-2.*F: " << F << endl;
+  F += transpose(F);
+  cout << "F += transpose(F): " << F << endl;
+  cout << "A*B*transpose(F): " << (A * B * transpose(F)) << endl;
+  cout << "transpose(B)*(B*U): " << (transpose(B) * (B * U)) << endl;
+
+  // transpose of a large matrix, materialized by the blocked kernel
+  matrix_type G(517, 301), Gtr;
+  for (size_t j = 0; j < G.columns(); ++j)
+    for (size_t i = 0; i < G.rows(); ++i)
+      G(i, j) = i + 1000. * j;
+  Gtr = transpose(G);
+  bool transposed = Gtr.rows() == G.columns() && Gtr.columns() == G.rows();
+  for (size_t j = 0; j < G.columns(); ++j)
+    for (size_t i = 0; i < G.rows(); ++i)
+      transposed = transposed && Gtr(j, i) == G(i, j);
+  cout << "transpose(G) check: " << transposed << endl;
+
+  // strided views, passed to BLAS with their leading dimension
+  matrix_type H(6, 5), K(5, 4), L(6, 4);
+  for (size_t i = 0; i < 6; ++i)
+    for (size_t j = 0; j < 5; ++j)
+      H(i, j) = i + 10. * j;
+  for (size_t i = 0; i < 5; ++i)
+    for (size_t j = 0; j < 4; ++j)
+      K(i, j) = 1. + i - j;
+  for (size_t i = 0; i < 6; ++i)
+    for (size_t j = 0; j < 4; ++j)
+      L(i, j) = i * j;
+
+  cout << "H.block(1,2,2,3): " << H.block(1, 2, 2, 3) << endl;
+  L.block(1, 1, 3, 2) = H.block(0, 0, 3, 4) * K.block(1, 1, 4, 2);
+  cout << "L.block(1,1,3,2) = H.block(0,0,3,4)*K.block(1,1,4,2): " << L << endl;
+  L.block(1, 1, 3, 2) -= 2. * H.block(0, 0, 3, 4) * K.block(1, 1, 4, 2);
+  cout << "L.block(1,1,3,2) -= 2.*H.block(0,0,3,4)*K.block(1,1,4,2): " << L << endl;
+  L.block(0, 0, 2, 2) = 3. * L.block(0, 0, 2, 2) + H.block(2, 0, 2, 3) * K.block(0, 0, 3, 2);
+  cout << "L.block(0,0,2,2) = 3.*L.block(0,0,2,2) + H.block(2,0,2,3)*K.block(0,0,3,2): "
+       << L << endl;
+
+  vector_type W = H * K.column(1);
+  cout << "W = H*K.column(1): " << W << endl;
+  H.column(0) = H * K.column(3);
+  cout << "H.column(0) = H*K.column(3): " << H << endl;
+  H.row(2).block(1, 2) = transpose(H.block(0, 1, 6, 2)) * H.column(3);
+  cout << "H.row(2).block(1,2) = transpose(H.block(0,1,6,2))*H.column(3): " << H << endl;
+  cout << "transpose(H.column(1))*H.column(2): "
+       << (transpose(H.column(1)) * H.column(2)) << endl;
+  H.column(4) /= 2.;
+  H.column(3) /= std::sqrt(transpose(H.column(3)) * H.column(3));
+  cout << "H.column(4) /= 2, H.column(3) normalized: " << H << endl;
+  H.row(5) += K.column(0) + 2. * H.row(4);
+  cout << "H.row(5) += K.column(0) + 2.*H.row(4): " << H << endl;
+
+  array::Array<3, double> S(2, 3, 4);
+  for (size_t i = 0; i < S.size(); ++i)
+    S.data()[i] = i;
+  cout << "S.slice<2>(1): " << S.slice<2>(1) << endl;
+  cout << "S.slice<0>(1) + 2.*S.slice<0>(0): " << (S.slice<0>(1) + 2. * S.slice<0>(0)) << endl;
+  cout << "S.slice<1>(2)*K.block(0,0,4,2): " << (S.slice<1>(2) * K.block(0, 0, 4, 2)) << endl;
+
+  L.block(0, 0, 3, 2) = transpose(L.block(0, 1, 2, 3));
+  cout << "L.block(0,0,3,2) = transpose(L.block(0,1,2,3)): " << L << endl;
+
+  // products of a matrix with its own transpose only compute one triangle
+  matrix_type M(4, 3), Mc, N(3, 3), P, Q;
+  for (size_t i = 0; i < 4; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      M(i, j) = 1. + i * j - j;
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      N(i, j) = 10. * i + j;
+  Mc = M;
+  P = transpose(M) * M;
+  cout << "transpose(M)*M: " << P << endl;
+  cout << "M*transpose(M): " << (M * transpose(M)) << endl;
+  P = 2. * transpose(M) * M + N;
+  Q = 2. * transpose(M) * Mc + N;
+  cout << "2.*transpose(M)*M + N: " << P << endl;
+  bool gram = true;
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      gram = gram && P(i, j) == Q(i, j);
+  cout << "2.*transpose(M)*M + N check: " << gram << endl;
+  // products with a matrix tagged as symmetric
+  matrix_type R = transpose(M) * M;
+  vector_type r = { 1, -1, 2 };
+  cout << "symmetric(R)*r: " << (array::symmetric(R) * r) << endl;
+  cout << "symmetric(R)*N: " << (array::symmetric(R) * N) << endl;
+  cout << "M*symmetric(R): " << (M * array::symmetric(R)) << endl;
+
+  // triangular matrices, solved and multiplied without forming inverses
+  matrix_type T = { { 2, 9, 9 }, { 1, 4, 9 }, { 3, 2, 5 } };
+  vector_type t = { 2, 9, 25 };
+  cout << "inverse(lower(T))*t: " << (inverse(array::lower(T)) * t) << endl;
+  cout << "solve(upper(T), t): " << array::solve(array::upper(T), t) << endl;
+  cout << "inverse(transpose(unit_lower(T)))*t: "
+       << (inverse(transpose(array::unit_lower(T))) * t) << endl;
+  cout << "lower(T)*t: " << (array::lower(T) * t) << endl;
+  cout << "unit_upper(T)*N: " << (array::unit_upper(T) * N) << endl;
+  cout << "N*upper(T): " << (N * array::upper(T)) << endl;
+  matrix_type TN = array::lower(T) * N;
+  cout << "inverse(lower(T))*(lower(T)*N): " << (inverse(array::lower(T)) * TN)
+       << endl;
+  matrix_type NT = N * array::upper(T);
+  cout << "(N*upper(T))*inverse(upper(T)): " << (NT * inverse(array::upper(T)))
+       << endl;
+
+  // chains of products are multiplied in the cheapest order
+  vector_type u = { 1, -2, 3, 1 };
+  matrix_type MN = M * N, MNM = MN * transpose(M);
+  vector_type MNMu = MNM * u;
+  cout << "M*N*transpose(M): " << (M * N * transpose(M)) << endl;
+  cout << "(M*N*transpose(M))*u: " << MNMu << endl;
+  cout << "M*N*transpose(M)*u: " << (M * N * transpose(M) * u) << endl;
+  cout << "2.*transpose(M)*M*N*r: " << (2. * transpose(M) * M * N * r) << endl;
+  cout << "K.block(0,0,4,2)*transpose(K.block(0,0,4,2))*M*N: "
+       << (K.block(0, 0, 4, 2) * transpose(K.block(0, 0, 4, 2)) * M * N) << endl;
+
   return 0;
 }
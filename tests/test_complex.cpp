@@ -0,0 +1,114 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file test_complex.cpp
+ *
+ * \brief This function tests arrays of complex elements, which go through
+ * the complex BLAS routines.
+ */
+
+#include "array.hpp"
+
+using std::cout;
+using std::endl;
+
+int main() {
+
+  typedef std::complex<double> complex_type;
+  typedef array::vector_type<complex_type> vector_type;
+  typedef array::matrix_type<complex_type> matrix_type;
+
+  const complex_type i(0, 1);
+
+  matrix_type A = { { complex_type(1, 1), complex_type(2, 0), complex_type(0, -1) },
+                    { complex_type(0, 2), complex_type(1, -1), complex_type(3, 0) },
+                    { complex_type(1, 0), complex_type(0, 1), complex_type(2, 2) } };
+  matrix_type B = { { complex_type(1, 0), complex_type(0, 1) },
+                    { complex_type(2, -1), complex_type(1, 0) },
+                    { complex_type(0, 0), complex_type(1, 1) } };
+  vector_type x = { complex_type(1, 0), complex_type(0, 1), complex_type(1, -1) };
+
+  cout << "A -> " << A << endl;
+  cout << "B -> " << B << endl;
+  cout << "x -> " << x << endl;
+
+  // scaling and addition
+  cout << "A + A = " << matrix_type(A + A) << endl;
+  cout << "i*x = " << vector_type(i * x) << endl;
+  cout << "2.*x = " << vector_type(2. * x) << endl;
+
+  // products through gemv, gemm and dot
+  cout << "A*x = " << vector_type(A * x) << endl;
+  cout << "A*B = " << matrix_type(A * B) << endl;
+  cout << "x'*x = " << complex_type(transpose(x) * x) << endl;
+  cout << "dotc(x, x) = " << dotc(x, x) << endl;
+
+  // norms are real
+  cout << "x 1-norm = " << x.norm(array::Norm_1) << endl;
+  cout << "x 2-norm squared = " << x.norm() * x.norm() << endl;
+  cout << "x Inf-norm = " << x.norm(array::Norm_inf) << endl;
+  cout << "A 1-norm = " << A.norm(array::Norm_1) << endl;
+
+  // conjugate transpose, applied with CblasConjTrans
+  matrix_type AH = adjoint(A);
+  cout << "adjoint(A)*x = " << vector_type(adjoint(A) * x) << endl;
+  cout << "AH*x = " << vector_type(AH * x) << endl;
+  cout << "adjoint(A)*B = " << matrix_type(adjoint(A) * B) << endl;
+  cout << "adjoint(B)*A = " << matrix_type(adjoint(B) * A) << endl;
+  cout << "A*adjoint(A) = " << matrix_type(A * adjoint(A)) << endl;
+  cout << "adjoint(A)*adjoint(A) = " << matrix_type(adjoint(A) * adjoint(A))
+       << endl;
+
+  // Gram product through syrk, not conjugated
+  matrix_type G = transpose(B) * B, H(2, 2);
+  for (size_t r = 0; r < 2; ++r)
+    for (size_t c = 0; c < 2; ++c)
+      for (size_t l = 0; l < 3; ++l)
+        H(r, c) += B(l, r) * B(l, c);
+  cout << "B'*B = " << G << endl;
+  cout << "B'*B matches loop: " << (matrix_type(G - H).norm() == 0 ? "yes" : "no") << endl;
+
+  // symmetric and triangular tags
+  matrix_type S = A + transpose(A);
+  cout << "symmetric(S)*x = " << vector_type(symmetric(S) * x) << endl;
+  cout << "S*x = " << vector_type(S * x) << endl;
+  vector_type b = upper(A) * x;
+  cout << "upper(A)*x = " << b << endl;
+  vector_type y = inverse(upper(A)) * b;
+  cout << "inverse(upper(A))*(upper(A)*x) recovers x: "
+       << (vector_type(y - x).norm() < 1e-12 ? "yes" : "no") << endl;
+
+  // scalars folded into products and scalings
+  const complex_type two(2, 0);
+  cout << "(2,0)*transpose(A)*A = " << matrix_type(two * transpose(A) * A)
+       << endl;
+  cout << "(2,0)*(A*B) = " << matrix_type(two * (A * B)) << endl;
+  cout << "(2,0)*(2.*A) = " << matrix_type(two * (2. * A)) << endl;
+  cout << "2.*(A*B) = " << matrix_type(2. * (A * B)) << endl;
+  cout << "3.*(2.*A) = " << matrix_type(3. * (2. * A)) << endl;
+  cout << "(A*B)*(2,0) = " << matrix_type((A * B) * two) << endl;
+  cout << "(2.*A)*3. = " << matrix_type((2. * A) * 3.) << endl;
+
+  // in-place scaling
+  x *= i;
+  cout << "x *= i -> " << x << endl;
+
+  return 0;
+}
@@ -23,6 +23,7 @@
  * \brief This function tests all constructors and move semantics.
  */
 
+#include <cstdint>
 #include <vector>
 
 #include "array.hpp"
@@ -34,6 +35,31 @@ typedef array::vector_type<double> vector_type;
 typedef array::matrix_type<double> matrix_type;
 typedef array::tensor_type<double> tensor_type;
 
+//! Allocator that keeps track of the number of live blocks
+template <typename T> struct counting_allocator : array::aligned_allocator<T> {
+
+  typedef T value_type;
+  template <typename U> struct rebind { typedef counting_allocator<U> other; };
+
+  static int blocks;
+
+  T *allocate(size_t n) {
+    ++blocks;
+    return array::aligned_allocator<T>::allocate(n);
+  }
+
+  void deallocate(T *p, size_t n) {
+    --blocks;
+    array::aligned_allocator<T>::deallocate(p, n);
+  }
+};
+
+template <typename T> int counting_allocator<T>::blocks = 0;
+
+template <class A> bool aligned(const A &a) {
+  return reinterpret_cast<std::uintptr_t>(a.data()) % array::array_alignment == 0;
+}
+
 matrix_type create() {
   return { { 6., 5., 4. }, { 3., 2., 1. } };
 }
@@ -73,6 +99,19 @@ int main() {
                         int l) { return i == j && j == k && k == l; });
   cout << "Matrix (lambda i,j,k,l: i == j == k == l):\n  II -> " << II << endl;
 
+  matrix_type R(3, 4, [=](int i, int j) { return i + 10 * j; });
+  cout << "Rectangular matrix (lambda i,j: i + 10*j):\n  R -> " << R << endl;
+
+  array::Array<3, double> T3(2, 3, 2, [=](int i, int j, int k) {
+    return i + 10 * j + 100 * k;
+  });
+  cout << "Third order tensor (lambda i,j,k: i + 10*j + 100*k):" << endl;
+  for (size_t k = 0; k < T3.size(2); ++k)
+    for (size_t j = 0; j < T3.size(1); ++j)
+      for (size_t i = 0; i < T3.size(0); ++i)
+        cout << " " << T3(i, j, k);
+  cout << endl;
+
   // constructors for initializer lists
 
   vector_type y = { 1., 2., 3., 4. };
@@ -92,6 +131,12 @@ int main() {
   matrix_type D(2, 3);
   cout << "Default constructed matrix D:\n  " << D << endl;
 
+  // constructor without initialization, elements are written afterwards
+
+  matrix_type U(2, 3, array::uninitialized);
+  U = 2. * D;
+  cout << "Uninitialized matrix U=2*D:\n  " << U << endl;
+
   // copy constructor
 
   matrix_type E(2, 3, 1.);
@@ -118,5 +163,43 @@ int main() {
   matrix_type I(2, &v[0]);
   cout << "Pointer constructed matrix I:\n  " << I << endl;
 
+  // aligned storage
+
+  matrix_type J = 2. * C + G;
+  cout << "Aligned storage: " << (aligned(y) && aligned(C) && aligned(F) &&
+                                  aligned(G) && aligned(J) &&
+                                  aligned(array::identity<2>(3)))
+       << endl;
+
+  // custom allocators
+
+  {
+    typedef array::Array<2, double, counting_allocator<double> > pool_matrix;
+
+    pool_matrix K(2, 3, 1.);
+    pool_matrix L(C);
+    L = 2. * C + G;
+    cout << "Matrix L=2*C+G with a custom allocator:\n  " << L << endl;
+    K = L;
+    cout << "Assigned matrix K=L:\n  " << K << endl;
+    L = C * transpose(G);
+    cout << "Matrix L=C*transpose(G) with a custom allocator:\n  " << L << endl;
+    matrix_type M(K);
+    cout << "Copy constructed matrix M(K):\n  " << M << endl;
+    matrix_type N = K + K;
+    cout << "Matrix N=K+K of custom allocator operands:\n  " << N << endl;
+    N = K * transpose(K);
+    cout << "Matrix N=K*transpose(K) of custom allocator operands:\n  " << N
+         << endl;
+    pool_matrix P = K / 3. - 2. * C;
+    cout << "Matrix P=K/3-2*C with a custom allocator:\n  " << P << endl;
+    N = -P * transpose(C);
+    cout << "Matrix N=-P*transpose(C) of a custom allocator operand:\n  " << N
+         << endl;
+    cout << "Live blocks: " << counting_allocator<double>::blocks << endl;
+  }
+  cout << "Live blocks after destruction: " << counting_allocator<double>::blocks
+       << endl;
+
   return 0;
 }
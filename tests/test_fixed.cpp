@@ -0,0 +1,117 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file test_fixed.cpp
+ *
+ * \brief This file tests arrays with extents fixed at compile time.
+ */
+
+#include "array.hpp"
+
+using std::cout;
+using std::endl;
+
+using array::Array;
+using array::Extents;
+using array::transpose;
+using array::inverse;
+
+typedef Array<1, double, Extents<3> > vector3;
+typedef Array<2, double, Extents<3, 3> > matrix33;
+typedef Array<2, double, Extents<3, 2> > matrix32;
+
+int main() {
+
+  matrix33 A = { { 4, 2, 1 }, { 2, 5, 3 }, { 1, 3, 6 } };
+  matrix32 B = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+  vector3 x = { 1, -2, 3 };
+
+  cout << "Fixed matrix A:\n" << A << endl;
+  cout << "Fixed matrix B:\n" << B << endl;
+  cout << "Fixed vector x:\n" << x << endl;
+
+  static_assert(sizeof(matrix33) == 9 * sizeof(double),
+                "fixed arrays are stored in place");
+  static_assert(matrix32::stride(1) == 3 && matrix32::size() == 6,
+                "fixed strides are compile-time constants");
+
+  // element access
+  cout << "A(1,2) = " << A(1, 2) << ", B(2,1) = " << B(2, 1) << endl;
+
+  // arithmetic
+  cout << "A + A:\n" << A + A << endl;
+  cout << "A - 2.*A:\n" << A - 2. * A << endl;
+  cout << "-A/2:\n" << -A / 2. << endl;
+  cout << "A*B:\n" << A * B << endl;
+  cout << "A*x:\n" << A * x << endl;
+  cout << "transpose(B):\n" << transpose(B) << endl;
+
+  matrix33 C(A);
+  C += A;
+  C *= 0.5;
+  C -= A;
+  cout << "A + A, halved, minus A:\n" << C << endl;
+
+  // norms
+  cout << "norm_1(A) = " << A.norm() << ", norm_inf(B) = "
+       << B.norm(array::Norm_inf) << endl;
+  cout << "norm_2(x) = " << x.norm() << ", norm_1(x) = "
+       << x.norm(array::Norm_1) << endl;
+
+  // inverse
+  matrix33 Ai = inverse(A);
+  cout << "inverse(A):\n" << Ai << endl;
+  cout << "A*inverse(A) is the identity: "
+       << ((A * Ai - matrix33({ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } })).norm() < 1e-12
+               ? "yes"
+               : "no") << endl;
+
+  matrix33 P = { { 0, 1, 0 }, { 2, 0, 0 }, { 0, 0, 4 } };
+  cout << "inverse of a matrix that needs pivoting:\n" << inverse(P) << endl;
+
+  try {
+    matrix33 S = { { 1, 2, 3 }, { 2, 4, 6 }, { 0, 0, 1 } };
+    inverse(S);
+  }
+  catch (array::SingularMatrixException &e) {
+    cout << "Singular matrix detected" << endl;
+  }
+
+  // integer elements
+  Array<2, int, Extents<2, 2> > N = { { 7, -5 }, { 4, 9 } };
+  cout << "Integer matrix N/2:\n" << N / 2 << endl;
+  N /= 3;
+  cout << "Integer matrix N/=3:\n" << N << endl;
+
+  // extents too large to be fully unrolled
+  typedef Array<2, double, Extents<32, 32> > matrix32x32;
+  matrix32x32 L(0.5);
+  matrix32x32 M = transpose(L) * L / 2.;
+  cout << "32x32 matrix M(31,0) = " << M(31, 0) << ", norm_1(M) = " << M.norm()
+       << endl;
+
+  // interoperability with dynamic arrays
+  array::matrix_type<double> D = A;
+  array::matrix_type<double> E = D * array::matrix_type<double>(B);
+  matrix32 F(E);
+  cout << "A*B through dynamic arrays:\n" << F << endl;
+
+  return 0;
+}
@@ -37,7 +37,177 @@ int main(int argc, char **argv) {
   cout << "List constructed matrix {{1,2,3},{4,5,4},{3,2,1}}:\n" << A << endl;
   cout << "Inverse matrix\n:  " << inverse(A) << endl;
 
+  // repeated inversions reuse the scratch memory of the thread
+  array::matrix_type<double> Ai = inverse(A);
+  double *work = array::workspace<double>(1);
+  for (int i = 0; i < 10; ++i) {
+    array::matrix_type<double> Bi = inverse(A);
+    assert(std::equal(Ai.begin(), Ai.end(), Bi.begin()));
+  }
+  assert(array::workspace<double>(1) == work);
+
+  // solution of linear systems through a reusable LU factorization
+
+  array::LU<double> F(A);
+  cout << "Determinant of A: " << F.determinant() << endl;
+
+  array::vector_type<double> b = { 14, 26, 10 };
+  cout << "Solution of A x = {14,26,10}:\n" << F.solve(b) << endl;
+  cout << "Solution of A' x = {14,26,10}:\n" << F.solve(b, true) << endl;
+
+  array::matrix_type<double> C = { { 2, 1 }, { 1, 0 }, { 0, 1 } };
+  cout << "Solution of A X = {{2,1},{1,0},{0,1}}:\n" << F.solve(C) << endl;
+
+  F.solve_in_place(b);
+  cout << "Solution computed in place:\n" << b << endl;
+  cout << "Solution without keeping the factorization:\n"
+       << array::solve(A, array::vector_type<double>({ 14, 26, 10 })) << endl;
+
+
+  // LU factorization and inverse of a complex matrix, through zgetrf, zgetrs
+  // and zgetri
+
+  typedef std::complex<double> complex_type;
+  array::matrix_type<complex_type> Z = {
+    { complex_type(2, 0), complex_type(0, 1) },
+    { complex_type(1, -1), complex_type(3, 0) }
+  };
+  array::LU<complex_type> FZ(Z);
+  cout << "Determinant of Z: " << FZ.determinant() << endl;
+  array::vector_type<complex_type> w = { complex_type(2, 1),
+                                         complex_type(4, -1) };
+  array::vector_type<complex_type> v = FZ.solve(w);
+  cout << "Solution of Z x = {2+i,4-i} is {1,1}: "
+       << (std::abs(v(0) - 1.) + std::abs(v(1) - 1.) < 1e-12 ? "yes" : "no")
+       << endl;
+  array::matrix_type<complex_type> ZZi = Z * inverse(Z);
+  cout << "Z inverse(Z) is the identity: "
+       << (array::matrix_type<complex_type>(
+               ZZi - array::identity<2, complex_type>(2)).norm() < 1e-12
+               ? "yes"
+               : "no") << endl;
   
+  // Cholesky factorization of a symmetric positive definite matrix
+
+  array::matrix_type<double> K = { { 4, 2, 1 }, { 2, 5, 3 }, { 1, 3, 6 } };
+  array::Cholesky<double> L(K);
+  cout << "Cholesky factor of {{4,2,1},{2,5,3},{1,3,6}}:\n" << L.factor_l()
+       << endl;
+  cout << "Logarithm of the determinant: " << L.log_determinant() << endl;
+  cout << "Solution of K x = {11,21,25}:\n"
+       << L.solve(array::vector_type<double>({ 11, 21, 25 })) << endl;
+  cout << "Solution of K X = {{11,1},{21,0},{25,0}}:\n"
+       << L.solve(array::matrix_type<double>({ { 11, 1 }, { 21, 0 }, { 25, 0 } }))
+       << endl;
+  cout << "Inverse of K:\n" << L.inverse() << endl;
+
+  try {
+    array::cholesky(A);
+  } catch (array::NotPositiveDefiniteException &e) {
+    cout << e.what() << endl;
+  }
+
+  // QR factorization and least squares solution of an overdetermined system,
+  // fitting the line 1 + 2 t through the points t = 0, 1, 2, 3
+
+  array::matrix_type<double> M = { { 1, 0 }, { 1, 1 }, { 1, 2 }, { 1, 3 } };
+  array::vector_type<double> y = { 1, 3, 5, 7 };
+
+  array::QR<double> G(M);
+  cout << "Factor R of the QR factorization of {{1,0},{1,1},{1,2},{1,3}}:\n"
+       << G.R() << endl;
+  array::matrix_type<double> Q = G.Q();
+  array::matrix_type<double> QtQ = transpose(Q) * Q;
+  cout << "Q'Q is the identity: "
+       << (std::abs(QtQ(0, 0) - 1) < 1e-12 && std::abs(QtQ(1, 1) - 1) < 1e-12 &&
+                   std::abs(QtQ(0, 1)) < 1e-12
+               ? "yes"
+               : "no") << endl;
+  cout << "Least squares fit through QR:\n" << G.solve(y) << endl;
+
+  array::vector_type<double> z;
+  array::least_squares(M, y, z);
+  cout << "Least squares fit through gels:\n" << z << endl;
+
+  // singular value decomposition
+
+  array::matrix_type<double> W = { { 3, 2, 2 }, { 2, 3, -2 } };
+  array::SVD<double> V(W);
+  cout << "Singular values of {{3,2,2},{2,3,-2}}:\n" << V.singular_values()
+       << endl;
+  cout << "Thin factors of size " << V.U().rows() << "x" << V.U().columns()
+       << " and " << V.Vt().rows() << "x" << V.Vt().columns() << endl;
+  double e = 0;
+  for (size_t i = 0; i < W.rows(); ++i)
+    for (size_t j = 0; j < W.columns(); ++j) {
+      double w = 0;
+      for (size_t l = 0; l < V.singular_values().size(); ++l)
+        w += V.U()(i, l) * V.singular_values()[l] * V.Vt()(l, j);
+      e = std::max(e, std::abs(w - W(i, j)));
+    }
+  cout << "U diag(s) Vt recovers the matrix: " << (e < 1e-12 ? "yes" : "no")
+       << endl;
+
+  array::matrix_type<double> U, Vt;
+  array::vector_type<double> sv;
+  array::svd(W, sv, U, Vt, array::SVD_full);
+  cout << "Full factors of size " << U.rows() << "x" << U.columns() << " and "
+       << Vt.rows() << "x" << Vt.columns() << endl;
+  cout << "Rank of {{3,4},{6,8},{0,0}}: "
+       << array::SVD<double>(array::matrix_type<double>(
+                                 { { 3, 4 }, { 6, 8 }, { 0, 0 } })).rank()
+       << endl;
+  cout << "Singular values only:\n" << array::singular_values(K) << endl;
+
+  // eigenvalues of the symmetric matrix diag(2) - offdiag(1), which are
+  // 2 - 2 cos(i pi / 6) for i = 1, ..., 5
+
+  array::matrix_type<double> T(5, 5);
+  for (size_t i = 0; i < 5; ++i) {
+    T(i, i) = 2;
+    if (i > 0)
+      T(i, i - 1) = T(i - 1, i) = -1;
+  }
+  cout << "Eigenvalues of the second difference matrix:\n"
+       << array::eigenvalues(T) << endl;
+
+  array::vector_type<double> lambda;
+  array::matrix_type<double> X;
+  array::eigen(T, lambda, X);
+  double r = 0;
+  for (size_t j = 0; j < 5; ++j) {
+    array::vector_type<double> x = X.column(j);
+    array::vector_type<double> Tx = T * x;
+    for (size_t i = 0; i < 5; ++i)
+      r = std::max(r, std::abs(Tx[i] - lambda[j] * x[i]));
+  }
+  cout << "Residual of the eigenpairs is small: " << (r < 1e-12 ? "yes" : "no")
+       << endl;
+
+  array::eigen(T, lambda, X, 0, 2);
+  cout << "Two smallest eigenvalues:\n" << lambda << endl;
+  cout << "Eigenvectors of size " << X.rows() << "x" << X.columns() << endl;
+  array::vector_type<double> x0 = X.column(0);
+  array::vector_type<double> Tx0 = T * x0;
+  cout << "First eigenvector matches its eigenvalue: "
+       << (std::abs(Tx0[2] - lambda[0] * x0[2]) < 1e-12 &&
+                   std::abs(std::abs(x0[2]) - 1 / std::sqrt(3.)) < 1e-12
+               ? "yes"
+               : "no") << endl;
+
+  array::eigen_interval(T, lambda, X, 1.5, 3.5);
+  cout << "Eigenvalues in (1.5,3.5]:\n" << lambda << endl;
+  cout << "Eigenvectors of size " << X.rows() << "x" << X.columns() << endl;
+
+  array::eigen_interval(T, lambda, X, 0.5, 0.9);
+  cout << "Eigenpairs in (0.5,0.9]: " << lambda.size() << " values, "
+       << X.size() << " vector elements" << endl;
+  array::eigen_interval(T, lambda, X, 0.5, 0.9, array::Eigen_values);
+  cout << "Eigenvalues in (0.5,0.9]: " << lambda.size() << endl;
+  array::eigen(T, lambda, X, 2, 0);
+  cout << "No eigenpairs from index 2: " << lambda.size() << " values, "
+       << X.size() << " vector elements" << endl;
+
   // inverse of a singular matrix
   
   array::matrix_type<double> B = { { 1, 2}, { 2, 4 }};
@@ -0,0 +1,112 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file test_map.cpp
+ *
+ * \brief This function tests the element-wise functions, which are evaluated
+ * lazily together with the element-wise operations around them.
+ */
+
+#include "array.hpp"
+
+using std::cout;
+using std::endl;
+
+using array::Simd;
+
+int main() {
+
+  typedef array::vector_type<double> vector_type;
+  typedef array::matrix_type<double> matrix_type;
+
+  vector_type x = { -2, -1, -0.5, 0, 0.5, 1, 2 };
+  vector_type b(x.size(), 1.);
+
+  cout << "x -> " << x << endl;
+
+  // functions of one argument
+  cout << "exp(x) = " << vector_type(array::exp(x)) << endl;
+  cout << "log(exp(x)) - x = " << vector_type(array::log(array::exp(x)) - x) << endl;
+  cout << "sqrt(abs(x)) = " << vector_type(array::sqrt(array::abs(x))) << endl;
+  cout << "tanh(x) = " << vector_type(array::tanh(x)) << endl;
+
+  // functions of two arguments, either of which may be a scalar
+  cout << "max(x, 0.) = " << vector_type(array::max(x, 0.)) << endl;
+  cout << "min(0., x) = " << vector_type(array::min(0., x)) << endl;
+  cout << "pow(x, 2.) = " << vector_type(array::pow(x, 2.)) << endl;
+  cout << "hadamard(x, x + b) = " << vector_type(array::hadamard(x, x + b)) << endl;
+  cout << "divide(1., exp(x) + b) = "
+       << vector_type(array::divide(1., array::exp(x) + b)) << endl;
+
+  // functions fused with the arithmetic operations
+  vector_type y = 2. * array::tanh(x) + b - array::hadamard(x, x);
+  cout << "y = 2.*tanh(x) + b - hadamard(x, x): " << y << endl;
+  y = array::exp(y);
+  cout << "y = exp(y): " << y << endl;
+  y += array::map([](double u, double v) { return u > v ? u : 2 * v; }, x, b);
+  cout << "y += map(f, x, b): " << y << endl;
+
+  // matrices, transposes, views and products
+  matrix_type A = { { 1, -2, 3 }, { -4, 5, -6 } };
+  matrix_type B(2, 3, 0.5);
+  vector_type v = { 1, 0, -1 };
+  cout << "A -> " << A << endl;
+  cout << "max(A, B) + min(A, 0.) = "
+       << matrix_type(array::max(A, B) + array::min(A, 0.)) << endl;
+  cout << "abs(transpose(A)) = " << matrix_type(array::abs(transpose(A))) << endl;
+  cout << "sqrt(abs(A.block(0,1,2,2))) = "
+       << matrix_type(array::sqrt(array::abs(A.block(0, 1, 2, 2)))) << endl;
+  cout << "exp(A*v) = " << vector_type(array::exp(A * v)) << endl;
+
+  // long arrays cover the vector registers, the remainder loops and the
+  // arguments outside of the range of the polynomials
+  const size_t n = 1001;
+  vector_type u(n), e(n), l(n);
+  for (size_t i = 0; i < n; ++i)
+    u[i] = 0.9 * i - 450.;
+  u[0] = -800.;
+  u[1] = 800.;
+  u[2] = 0.;
+  Simd::exp(n, u.data(), e.data());
+  bool exp_check = true;
+  for (size_t i = 0; i < n; ++i) {
+    const double r = std::exp(u[i]);
+    exp_check = exp_check && (e[i] == r || std::abs(e[i] - r) <= 1e-15 * r);
+  }
+  cout << "Vectorized exp check: " << exp_check << endl;
+
+  u = array::abs(u);
+  Simd::log(n, u.data(), l.data());
+  bool log_check = true;
+  for (size_t i = 0; i < n; ++i) {
+    const double r = std::log(u[i]);
+    log_check = log_check && (l[i] == r || std::abs(l[i] - r) <= 1e-15 * std::abs(r));
+  }
+  cout << "Vectorized log check: " << log_check << endl;
+
+  array::vector_type<float> f(n), g;
+  for (size_t i = 0; i < n; ++i)
+    f[i] = 0.01f * (i + 1);
+  g = array::log(array::exp(f)) - f;
+  cout << "Float log(exp(f)) - f, infinity norm below 1e-5: "
+       << (g.norm(array::Norm_inf) < 1e-5f) << endl;
+
+  return 0;
+}
@@ -75,5 +75,22 @@ int main(int argc, char **argv) {
   cout << "Norm 1: " << Ai.norm(Norm_1) << endl;
   cout << "Norm infinity: " << Ai.norm(Norm_inf) << endl;
 
+  // several norms in a single sweep
+  array::vector_type<double> yd = { 1, -2, 3, -3, 4, -5, 6, -7, 9 };
+  array::Norms<double> ny = yd.norms();
+
+  cout << "Vector (double precision):\n  " << yd << endl;
+  cout << "Norms: " << ny.norm_1 << " " << ny.norm_2 << " " << ny.norm_inf
+       << ", sum: " << ny.sum << endl;
+
+  array::matrix_type<double> Bd = { { 1, -2, 3 }, { -3, 4, -5 }, { 6, -7, 9 } };
+  array::Norms<double> nB = Bd.norms();
+
+  cout << "Matrix (double precision):\n  " << Bd << endl;
+  cout << "Norms: " << nB.norm_1 << " " << nB.norm_2 << " " << nB.norm_inf
+       << ", sum: " << nB.sum << endl;
+  cout << "Norm 1: " << Bd.norm(Norm_1) << endl;
+  cout << "Norm infinity: " << Bd.norm(Norm_inf) << endl;
+
   return 0;
 }
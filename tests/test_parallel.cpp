@@ -0,0 +1,130 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file test_parallel.cpp
+ *
+ * \brief This function tests the execution policies and the kernels that run
+ * on the thread pool.
+ */
+
+#include "array.hpp"
+
+using std::cout;
+using std::endl;
+
+int main() {
+
+  typedef array::vector_type<double> vector_type;
+  typedef array::matrix_type<double> matrix_type;
+
+  // parallel loops, nested loops included
+  std::vector<size_t> v(100000);
+  array::parallel_for(array::par, 0, v.size(), [&](size_t i) { v[i] = i; }, 1000);
+  size_t s = 0;
+  for (size_t i = 0; i < v.size(); ++i)
+    s += v[i];
+  cout << "Sum of indices: " << s << endl;
+
+  std::vector<size_t> w(64);
+  array::parallel_for(0, 8, [&](size_t i) {
+    array::parallel_for(0, 8, [&](size_t j) { w[8 * i + j] = i * j; });
+  });
+  s = 0;
+  for (size_t i = 0; i < w.size(); ++i)
+    s += w[i];
+  cout << "Sum of nested products: " << s << endl;
+
+  // kernels give the same results with both policies
+  matrix_type A(1000, 300, [](size_t i, size_t j) {
+    return double(int(i * 7 + j * 3) % 11) - 5;
+  });
+  array::Norms<double> a = A.norms(array::par), b = A.norms(array::seq);
+  cout << "Matrix norms: " << a.norm_1 << " " << a.norm_inf << ", sum: " << a.sum
+       << endl;
+  cout << "Same norms with both policies: "
+       << (a.norm_1 == b.norm_1 && a.norm_inf == b.norm_inf && a.sum == b.sum
+               ? "yes"
+               : "no") << endl;
+
+  vector_type x(200001, [](size_t i) { return double(int(i % 13) - 6); });
+  array::Norms<double> c = x.norms(array::par), d = x.norms(array::seq);
+  cout << "Vector norms: " << c.norm_1 << " " << c.norm_inf << ", sum: " << c.sum
+       << endl;
+  cout << "Same norms with both policies: "
+       << (c.norm_1 == d.norm_1 && c.norm_inf == d.norm_inf && c.sum == d.sum
+               ? "yes"
+               : "no") << endl;
+
+  // large element-wise expressions, of which the ones with functions buffer
+  // their arguments
+  vector_type y = 2. * x - x / 2., z = 2. * x + array::exp(x);
+  double e = 0;
+  for (size_t i = 0; i < x.size(); ++i)
+    e = std::max(e, std::abs(y[i] - 1.5 * x[i]) +
+                        std::abs(z[i] - 2. * x[i] - std::exp(x[i])) / std::exp(6.));
+  cout << "Large element-wise expressions: " << y[32768] << " " << z[32768]
+       << ", match the loop: " << (e < 1e-12 ? "yes" : "no") << endl;
+
+  // copies with the default policy set to sequential
+  array::set_execution_policy(array::seq);
+  cout << "Sequential default: "
+       << (array::execution_policy() == array::seq ? "yes" : "no") << endl;
+  matrix_type B(A);
+  cout << "Copy: " << (B(999, 299) == A(999, 299) && B(0, 0) == A(0, 0) ? "yes" : "no")
+       << endl;
+  vector_type u = 2. * x + array::exp(x);
+  cout << "Same element-wise expression as the parallel evaluation: "
+       << (vector_type(u - z).norm() == 0 ? "yes" : "no") << endl;
+  array::set_execution_policy(array::par);
+
+  // threads given to the blas library
+  typedef array::Blas_threads Blas_threads;
+  cout << "BLAS threads of a small product: " << Blas_threads::threads(1000)
+       << endl;
+  size_t t = 0;
+  array::parallel_for(array::par, 0, 4, [&](size_t i) {
+    if (i == 0)
+      t = Blas_threads::threads(size_t(1) << 40);
+  });
+  cout << "BLAS threads of a product in a parallel loop: "
+       << (Blas_threads::max() == 1 || array::hardware_threads() == 1 ? 1 : t)
+       << endl;
+  {
+    Blas_threads::Scope scope(2);
+    cout << "BLAS threads of a product in a scope of 2: "
+         << Blas_threads::threads(1000) << endl;
+    matrix_type C = A * transpose(A);
+    cout << "Product in the scope: " << C(0, 0) << endl;
+  }
+
+  // independent products evaluated concurrently
+  matrix_type P(40, 40, [](size_t i, size_t j) { return double(i + 2 * j); });
+  matrix_type Q(40, 40, [](size_t i, size_t j) { return double(int(i) - int(j)); });
+  matrix_type E = P * Q + Q * P, F = array::evaluate(array::par, P * Q + Q * P);
+  matrix_type G = (P * Q - Q * P) + 2. * (P * P);
+  matrix_type H = array::evaluate(array::par, (P * Q - Q * P) + 2. * (P * P));
+  cout << "Asynchronous evaluation: " << F(3, 5) << " " << H(3, 5) << endl;
+  cout << "Same results as the sequential evaluation: "
+       << (matrix_type(E - F).norm() == 0 && matrix_type(G - H).norm() == 0 ? "yes"
+                                                                              : "no")
+       << endl;
+
+  return 0;
+}
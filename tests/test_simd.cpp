@@ -0,0 +1,87 @@
+/*
+ * Copyright (©) 2014 Alejandro M. Aragón
+ * Written by Alejandro M. Aragón <alejandro.aragon@fulbrightmail.org>
+ * All Rights Reserved
+ *
+ * cpp-array is free  software: you can redistribute it and/or  modify it under
+ * the terms  of the  GNU Lesser  General Public  License as  published by  the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * cpp-array is  distributed in the  hope that it  will be useful, but  WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A  PARTICULAR PURPOSE. See  the GNU  Lesser General  Public License  for
+ * more details.
+ *
+ * You should  have received  a copy  of the GNU  Lesser General  Public License
+ * along with cpp-array. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! \file test_simd.cpp
+ *
+ * \brief This function tests arrays of integers, which go through the
+ * vectorized kernels instead of BLAS.
+ */
+
+#include "array.hpp"
+
+using std::cout;
+using std::endl;
+
+using array::Norm_1;
+using array::Norm_2;
+using array::Norm_inf;
+using array::Simd;
+
+int main() {
+
+  typedef array::vector_type<int> vector_type;
+  typedef array::matrix_type<int> matrix_type;
+
+  vector_type x = { 1, -2, 3, -4, 5, -6, 7, -8, 9 };
+  vector_type y = { 2, 2, 2, 2, 2, 2, 2, 2, 2 };
+
+  cout << "x -> " << x << endl;
+  cout << "y -> " << y << endl;
+
+  // level 1 operations
+  cout << "x + y = " << vector_type(x + y) << endl;
+  cout << "x - y = " << vector_type(x - y) << endl;
+  cout << "3*x = " << vector_type(3 * x) << endl;
+  cout << "x'*y = " << int(transpose(x) * y) << endl;
+
+  vector_type z(y);
+  z += 2 * x;
+  z /= 2;
+  cout << "(y + 2*x)/2 = " << z << endl;
+
+  // norms, Norm 2 used to fall through to the infinity norm
+  cout << "Norm 1: " << x.norm(Norm_1) << endl;
+  cout << "Norm 2: " << x.norm(Norm_2) << endl;
+  cout << "Norm infinity: " << x.norm(Norm_inf) << endl;
+
+  matrix_type A = { { 1, -2, 3 }, { -4, 5, -6 }, { 7, -8, 9 } };
+  cout << "A -> " << A << endl;
+  cout << "Norm 1: " << A.norm(Norm_1) << endl;
+  cout << "Norm infinity: " << A.norm(Norm_inf) << endl;
+
+  // long arrays cover the vector registers and the remainder loops
+  const size_t n = 1001;
+  array::vector_type<long> u(n), v(n), w(n, 1);
+  for (size_t i = 0; i < n; ++i) {
+    u[i] = i % 2 ? -long(i) : long(i);
+    v[i] = 3;
+  }
+  u *= 2;
+  v += u;
+  cout << "Long arrays:" << endl;
+  cout << "Sum: " << long(transpose(v) * w) << endl;
+  cout << "Norm 1: " << v.norm(Norm_1) << endl;
+  cout << "Norm 2: " << v.norm(Norm_2) << endl;
+  cout << "Norm infinity: " << v.norm(Norm_inf) << endl;
+  cout << "Index of largest element: " << Simd::iamax<long>(n, v.data(), 1)
+       << endl;
+
+  return 0;
+}